@@ -0,0 +1,136 @@
+/*
+ * Copyright (C) 2018-2019 Michał Siejak
+ * This file is part of Quartz - a raytracing aspect for Qt3D.
+ * See LICENSE file for licensing information.
+ */
+
+#include "imagemerger.h"
+#include "radiancefile.h"
+
+#include <algorithm>
+#include <limits>
+#include <memory>
+#include <numeric>
+#include <vector>
+
+#include <QVector>
+#include <QTextStream>
+#include <QtConcurrent>
+
+namespace Config {
+static constexpr int DefaultRowsPerBatch = 64;
+} // Config
+
+struct InputImage
+{
+    RadianceReader reader;
+    QVector<quint8> scanlines;
+    float weight = 0.0f;
+    bool error = false;
+};
+
+ImageMerger::ImageMerger()
+    : m_rowsPerBatch(Config::DefaultRowsPerBatch)
+{}
+
+void ImageMerger::setRowsPerBatch(int rows)
+{
+    m_rowsPerBatch = std::max(rows, 1);
+}
+
+bool ImageMerger::merge(const QStringList &inputPaths, const QString &outputPath) const
+{
+    std::vector<std::unique_ptr<InputImage>> inputs;
+    inputs.reserve(inputPaths.size());
+
+    qint64 totalNumSamples = 0;
+    for(const QString &path : inputPaths) {
+        std::unique_ptr<InputImage> input(new InputImage);
+        if(!input->reader.open(path)) {
+            QTextStream(stderr) << "Error: " << path << ": " << input->reader.errorString() << '\n';
+            return false;
+        }
+        if(input->reader.numSamples() <= 0) {
+            QTextStream(stderr) << "Error: " << path << ": Missing QUARTZ_SPP sample count metadata (denoised images cannot be merged)\n";
+            return false;
+        }
+        if(!inputs.empty() && (input->reader.width() != inputs[0]->reader.width() || input->reader.height() != inputs[0]->reader.height())) {
+            QTextStream(stderr) << "Error: " << path << ": Image dimensions do not match " << inputs[0]->reader.path() << '\n';
+            return false;
+        }
+        totalNumSamples += input->reader.numSamples();
+        inputs.push_back(std::move(input));
+    }
+    if(totalNumSamples > std::numeric_limits<int>::max()) {
+        QTextStream(stderr) << "Error: Total sample count is out of range\n";
+        return false;
+    }
+
+    const int width = inputs[0]->reader.width();
+    const int height = inputs[0]->reader.height();
+    for(auto &input : inputs) {
+        input->weight = float(double(input->reader.numSamples()) / double(totalNumSamples));
+        input->scanlines.resize(m_rowsPerBatch * width * 4);
+    }
+
+    RadianceWriter writer;
+    if(!writer.open(outputPath, width, height, int(totalNumSamples))) {
+        QTextStream(stderr) << "Error: " << outputPath << ": " << writer.errorString() << '\n';
+        return false;
+    }
+
+    QVector<int> batchRows(m_rowsPerBatch);
+    QVector<QByteArray> encodedRows(m_rowsPerBatch);
+
+    // Images are processed in batches of rows: inputs are decoded concurrently, then each row of the batch
+    // is accumulated and re-encoded on a separate worker. Only a single batch is kept in memory at any time.
+    for(int batchStart=0; batchStart<height; batchStart+=m_rowsPerBatch) {
+        const int numRows = std::min(m_rowsPerBatch, height - batchStart);
+
+        QtConcurrent::blockingMap(inputs, [numRows](std::unique_ptr<InputImage> &input) {
+            input->error = !input->reader.readScanlines(numRows, input->scanlines.data());
+        });
+        for(const auto &input : inputs) {
+            if(input->error) {
+                QTextStream(stderr) << "Error: " << input->reader.path() << ": " << input->reader.errorString() << '\n';
+                return false;
+            }
+        }
+
+        batchRows.resize(numRows);
+        std::iota(batchRows.begin(), batchRows.end(), 0);
+        QtConcurrent::blockingMap(batchRows, [&inputs, &encodedRows, width](const int &row) {
+            QVector<float> accumulator(width * 3, 0.0f);
+            for(const auto &input : inputs) {
+                const quint8 *rgbe = input->scanlines.constData() + row * width * 4;
+                for(int x=0; x<width; ++x) {
+                    float rgb[3];
+                    rgbeToFloat(rgbe + x * 4, rgb);
+                    accumulator[x * 3 + 0] += input->weight * rgb[0];
+                    accumulator[x * 3 + 1] += input->weight * rgb[1];
+                    accumulator[x * 3 + 2] += input->weight * rgb[2];
+                }
+            }
+
+            QVector<quint8> rgbe(width * 4);
+            for(int x=0; x<width; ++x) {
+                floatToRGBE(accumulator.constData() + x * 3, rgbe.data() + x * 4);
+            }
+            encodedRows[row].clear();
+            RadianceWriter::encodeScanline(rgbe.constData(), width, encodedRows[row]);
+        });
+
+        for(int row=0; row<numRows; ++row) {
+            if(!writer.writeEncodedScanlines(encodedRows[row])) {
+                QTextStream(stderr) << "Error: " << outputPath << ": " << writer.errorString() << '\n';
+                return false;
+            }
+        }
+    }
+
+    if(!writer.close()) {
+        QTextStream(stderr) << "Error: " << outputPath << ": " << writer.errorString() << '\n';
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,23 @@
+/*
+ * Copyright (C) 2018-2019 Michał Siejak
+ * This file is part of Quartz - a raytracing aspect for Qt3D.
+ * See LICENSE file for licensing information.
+ */
+
+#pragma once
+
+#include <QString>
+#include <QStringList>
+
+class ImageMerger
+{
+public:
+    ImageMerger();
+
+    void setRowsPerBatch(int rows);
+
+    bool merge(const QStringList &inputPaths, const QString &outputPath) const;
+
+private:
+    int m_rowsPerBatch;
+};
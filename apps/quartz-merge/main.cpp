@@ -0,0 +1,56 @@
+/*
+ * Copyright (C) 2018-2019 Michał Siejak
+ * This file is part of Quartz - a raytracing aspect for Qt3D.
+ * See LICENSE file for licensing information.
+ */
+
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QFileInfo>
+#include <QTextStream>
+
+#include "imagemerger.h"
+
+int main(int argc, char* argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("quartz-merge");
+    QCoreApplication::setApplicationVersion("1.0.0");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Merges partial Quartz HDR renders into a single sample-weighted image.");
+    parser.addHelpOption();
+    parser.addVersionOption();
+    parser.addPositionalArgument("inputs", "Input HDR image paths.", "inputs...");
+
+    QCommandLineOption outputOption({"o", "output"}, "Output HDR image path.", "path");
+    parser.addOption(outputOption);
+    QCommandLineOption rowsOption("rows", "Number of rows processed per batch.", "count");
+    parser.addOption(rowsOption);
+
+    parser.process(app);
+
+    const QStringList inputPaths = parser.positionalArguments();
+    if(inputPaths.isEmpty() || !parser.isSet(outputOption)) {
+        parser.showHelp(2);
+    }
+
+    const QString outputPath = parser.value(outputOption);
+    for(const QString &path : inputPaths + QStringList{outputPath}) {
+        if(QFileInfo(path).suffix().toLower() != QStringLiteral("hdr")) {
+            QTextStream(stderr) << "Error: " << path << ": Unsupported file format (only Radiance HDR is supported)\n";
+            return 1;
+        }
+    }
+
+    ImageMerger merger;
+    if(parser.isSet(rowsOption)) {
+        merger.setRowsPerBatch(parser.value(rowsOption).toInt());
+    }
+    if(!merger.merge(inputPaths, outputPath)) {
+        return 1;
+    }
+
+    QTextStream(stdout) << "Image saved: " << outputPath << '\n';
+    return 0;
+}
@@ -0,0 +1,318 @@
+/*
+ * Copyright (C) 2018-2019 Michał Siejak
+ * This file is part of Quartz - a raytracing aspect for Qt3D.
+ * See LICENSE file for licensing information.
+ */
+
+#include "radiancefile.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include <QRegularExpression>
+
+namespace Config {
+static constexpr int ReadBufferSize = 1024 * 1024;
+static constexpr int MinEncodedWidth = 8;
+static constexpr int MaxEncodedWidth = 0x7fff;
+static constexpr int MaxRunLength = 127;
+static constexpr int MaxLiteralLength = 128;
+static constexpr int MinRunLength = 3;
+static constexpr int MaxHeaderLineLength = 1024;
+} // Config
+
+void floatToRGBE(const float *rgb, quint8 *rgbe)
+{
+    const float maxComponent = std::max(rgb[0], std::max(rgb[1], rgb[2]));
+    if(maxComponent < 1e-32f) {
+        rgbe[0] = rgbe[1] = rgbe[2] = rgbe[3] = 0;
+    }
+    else {
+        int exponent;
+        const float normalize = std::frexp(maxComponent, &exponent) * 256.0f / maxComponent;
+        rgbe[0] = quint8(std::max(rgb[0], 0.0f) * normalize);
+        rgbe[1] = quint8(std::max(rgb[1], 0.0f) * normalize);
+        rgbe[2] = quint8(std::max(rgb[2], 0.0f) * normalize);
+        rgbe[3] = quint8(exponent + 128);
+    }
+}
+
+void rgbeToFloat(const quint8 *rgbe, float *rgb)
+{
+    if(rgbe[3] != 0) {
+        const float scale = std::ldexp(1.0f, int(rgbe[3]) - (128 + 8));
+        rgb[0] = rgbe[0] * scale;
+        rgb[1] = rgbe[1] * scale;
+        rgb[2] = rgbe[2] * scale;
+    }
+    else {
+        rgb[0] = rgb[1] = rgb[2] = 0.0f;
+    }
+}
+
+bool RadianceReader::open(const QString &path)
+{
+    m_file.setFileName(path);
+    if(!m_file.open(QFile::ReadOnly)) {
+        return setError(m_file.errorString());
+    }
+    return readHeader();
+}
+
+bool RadianceReader::readHeader()
+{
+    static const QRegularExpression samplesRegExp("^QUARTZ_SPP=(\\d+)$");
+    static const QRegularExpression resolutionRegExp("^-Y (\\d+) \\+X (\\d+)$");
+
+    QByteArray line;
+    if(!readLine(line) || (line != "#?RADIANCE" && line != "#?RGBE")) {
+        return setError("Not a Radiance HDR file");
+    }
+    while(true) {
+        if(!readLine(line)) {
+            return setError("Unexpected end of header");
+        }
+        if(line.isEmpty()) {
+            break;
+        }
+        if(line.startsWith("FORMAT=") && line != "FORMAT=32-bit_rle_rgbe") {
+            return setError(QString("Unsupported pixel format: %1").arg(QString::fromLatin1(line.mid(7))));
+        }
+        auto samplesMatch = samplesRegExp.match(QString::fromLatin1(line));
+        if(samplesMatch.hasMatch()) {
+            m_numSamples = samplesMatch.captured(1).toInt();
+        }
+    }
+
+    if(!readLine(line)) {
+        return setError("Missing resolution string");
+    }
+    auto resolutionMatch = resolutionRegExp.match(QString::fromLatin1(line));
+    if(!resolutionMatch.hasMatch()) {
+        return setError(QString("Unsupported image orientation: %1").arg(QString::fromLatin1(line)));
+    }
+    m_height = resolutionMatch.captured(1).toInt();
+    m_width  = resolutionMatch.captured(2).toInt();
+    if(m_width <= 0 || m_height <= 0) {
+        return setError("Invalid image dimensions");
+    }
+    return true;
+}
+
+bool RadianceReader::readScanlines(int count, quint8 *rgbe)
+{
+    for(int i=0; i<count; ++i) {
+        if(!readScanline(rgbe + i * m_width * 4)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool RadianceReader::readScanline(quint8 *rgbe)
+{
+    quint8 prefix[4];
+    if(!readBytes(prefix, 4)) {
+        return setError("Unexpected end of file");
+    }
+
+    const bool isEncoded = m_width >= Config::MinEncodedWidth && m_width <= Config::MaxEncodedWidth
+            && prefix[0] == 2 && prefix[1] == 2 && (prefix[2] & 0x80) == 0;
+    if(!isEncoded) {
+        std::copy(prefix, prefix + 4, rgbe);
+        if(!readBytes(rgbe + 4, (m_width - 1) * 4)) {
+            return setError("Unexpected end of file");
+        }
+        return true;
+    }
+
+    if(((int(prefix[2]) << 8) | prefix[3]) != m_width) {
+        return setError("Invalid scanline width");
+    }
+
+    // New-style RLE: each of the four components is run-length encoded separately.
+    for(int component=0; component<4; ++component) {
+        int x = 0;
+        while(x < m_width) {
+            quint8 count, value;
+            if(!readByte(count)) {
+                return setError("Unexpected end of file");
+            }
+            if(count > 128) {
+                count -= 128;
+                if(x + count > m_width || !readByte(value)) {
+                    return setError("Corrupt scanline data");
+                }
+                for(int i=0; i<count; ++i, ++x) {
+                    rgbe[x * 4 + component] = value;
+                }
+            }
+            else {
+                if(count == 0 || x + count > m_width) {
+                    return setError("Corrupt scanline data");
+                }
+                for(int i=0; i<count; ++i, ++x) {
+                    if(!readByte(rgbe[x * 4 + component])) {
+                        return setError("Unexpected end of file");
+                    }
+                }
+            }
+        }
+    }
+    return true;
+}
+
+bool RadianceReader::fillBuffer()
+{
+    m_buffer = m_file.read(Config::ReadBufferSize);
+    m_bufferPosition = 0;
+    return !m_buffer.isEmpty();
+}
+
+bool RadianceReader::readByte(quint8 &value)
+{
+    if(m_bufferPosition >= m_buffer.size() && !fillBuffer()) {
+        return false;
+    }
+    value = quint8(m_buffer.at(m_bufferPosition++));
+    return true;
+}
+
+bool RadianceReader::readBytes(quint8 *data, int count)
+{
+    while(count > 0) {
+        if(m_bufferPosition >= m_buffer.size() && !fillBuffer()) {
+            return false;
+        }
+        const int numBytes = std::min(count, m_buffer.size() - m_bufferPosition);
+        std::copy(m_buffer.constData() + m_bufferPosition, m_buffer.constData() + m_bufferPosition + numBytes, data);
+        m_bufferPosition += numBytes;
+        data  += numBytes;
+        count -= numBytes;
+    }
+    return true;
+}
+
+bool RadianceReader::readLine(QByteArray &line)
+{
+    line.clear();
+    quint8 c;
+    while(readByte(c)) {
+        if(c == '\n') {
+            return true;
+        }
+        if(line.size() >= Config::MaxHeaderLineLength) {
+            return false;
+        }
+        line.append(char(c));
+    }
+    return false;
+}
+
+bool RadianceReader::setError(const QString &message)
+{
+    m_errorString = message;
+    return false;
+}
+
+bool RadianceWriter::open(const QString &path, int width, int height, int numSamples)
+{
+    m_errorString.clear();
+    if(width <= 0 || height <= 0) {
+        return setError(QString("Invalid image dimensions: %1x%2").arg(width).arg(height));
+    }
+
+    m_file.setFileName(path);
+    if(!m_file.open(QFile::WriteOnly | QFile::Truncate)) {
+        return setError(m_file.errorString());
+    }
+
+    const QByteArray header = QString("#?RADIANCE\n# Written by quartz-merge\nFORMAT=32-bit_rle_rgbe\nQUARTZ_SPP=%1\n\n-Y %2 +X %3\n")
+            .arg(numSamples)
+            .arg(height)
+            .arg(width)
+            .toLatin1();
+    if(m_file.write(header) != header.size()) {
+        return setError(QString("Failed to write header: %1").arg(m_file.errorString()));
+    }
+    return true;
+}
+
+bool RadianceWriter::writeEncodedScanlines(const QByteArray &data)
+{
+    if(m_file.write(data) != data.size()) {
+        return setError(QString("Failed to write scanlines: %1").arg(m_file.errorString()));
+    }
+    return true;
+}
+
+bool RadianceWriter::close()
+{
+    const bool result = m_file.flush();
+    const QString flushError = m_file.errorString();
+    m_file.close();
+    if(!result) {
+        return setError(QString("Failed to flush file: %1").arg(flushError));
+    }
+    return true;
+}
+
+bool RadianceWriter::setError(const QString &message)
+{
+    m_errorString = message;
+    return false;
+}
+
+void RadianceWriter::encodeScanline(const quint8 *rgbe, int width, QByteArray &output)
+{
+    if(width < Config::MinEncodedWidth || width > Config::MaxEncodedWidth) {
+        output.append(reinterpret_cast<const char*>(rgbe), width * 4);
+        return;
+    }
+
+    output.append(char(2));
+    output.append(char(2));
+    output.append(char(width >> 8));
+    output.append(char(width & 0xff));
+
+    for(int component=0; component<4; ++component) {
+        auto value = [rgbe, component](int x) -> char {
+            return char(rgbe[x * 4 + component]);
+        };
+
+        int x = 0;
+        while(x < width) {
+            // Find the start of the next run long enough to be worth encoding.
+            int runStart = x;
+            int runLength = 0;
+            while(runStart < width) {
+                runLength = 1;
+                while(runStart + runLength < width && runLength < Config::MaxRunLength
+                      && value(runStart + runLength) == value(runStart)) {
+                    ++runLength;
+                }
+                if(runLength >= Config::MinRunLength) {
+                    break;
+                }
+                runStart += runLength;
+            }
+            runStart = std::min(runStart, width);
+
+            // Emit literals preceding the run.
+            while(x < runStart) {
+                const int literalLength = std::min(runStart - x, Config::MaxLiteralLength);
+                output.append(char(literalLength));
+                for(int i=0; i<literalLength; ++i) {
+                    output.append(value(x + i));
+                }
+                x += literalLength;
+            }
+
+            if(runStart < width) {
+                output.append(char(128 + runLength));
+                output.append(value(runStart));
+                x = runStart + runLength;
+            }
+        }
+    }
+}
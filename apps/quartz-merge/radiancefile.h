@@ -0,0 +1,66 @@
+/*
+ * Copyright (C) 2018-2019 Michał Siejak
+ * This file is part of Quartz - a raytracing aspect for Qt3D.
+ * See LICENSE file for licensing information.
+ */
+
+#pragma once
+
+#include <QByteArray>
+#include <QFile>
+#include <QString>
+
+// Radiance (.hdr) file reader which decodes scanlines on demand, so that only a part of the image is kept in memory.
+class RadianceReader
+{
+public:
+    bool open(const QString &path);
+    bool readScanlines(int count, quint8 *rgbe);
+
+    QString path() const { return m_file.fileName(); }
+    QString errorString() const { return m_errorString; }
+
+    int width() const { return m_width; }
+    int height() const { return m_height; }
+    int numSamples() const { return m_numSamples; }
+
+private:
+    bool readHeader();
+    bool readScanline(quint8 *rgbe);
+    bool fillBuffer();
+    bool readByte(quint8 &value);
+    bool readBytes(quint8 *data, int count);
+    bool readLine(QByteArray &line);
+    bool setError(const QString &message);
+
+    QFile m_file;
+    QByteArray m_buffer;
+    int m_bufferPosition = 0;
+    QString m_errorString;
+
+    int m_width = 0;
+    int m_height = 0;
+    int m_numSamples = 0;
+};
+
+// Radiance (.hdr) file writer accepting pre-encoded (RLE) scanlines.
+class RadianceWriter
+{
+public:
+    bool open(const QString &path, int width, int height, int numSamples);
+    bool writeEncodedScanlines(const QByteArray &data);
+    bool close();
+
+    QString errorString() const { return m_errorString; }
+
+    static void encodeScanline(const quint8 *rgbe, int width, QByteArray &output);
+
+private:
+    bool setError(const QString &message);
+
+    QFile m_file;
+    QString m_errorString;
+};
+
+void floatToRGBE(const float *rgb, quint8 *rgbe);
+void rgbeToFloat(const quint8 *rgbe, float *rgb);
@@ -0,0 +1,158 @@
+/*
+ * Copyright (C) 2018-2019 Michał Siejak
+ * This file is part of Quartz - a raytracing aspect for Qt3D.
+ * See LICENSE file for licensing information.
+ */
+
+#include "camerabookmarks.h"
+
+#include <Qt3DRaytrace/qcamera.h>
+
+#include <QFile>
+#include <QFileInfo>
+#include <QDir>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonArray>
+#include <QTextStream>
+
+static QJsonArray toJson(const QVector3D &v)
+{
+    return QJsonArray{ v.x(), v.y(), v.z() };
+}
+
+static QJsonArray toJson(const QQuaternion &q)
+{
+    return QJsonArray{ q.scalar(), q.x(), q.y(), q.z() };
+}
+
+static QVector3D vectorFromJson(const QJsonValue &value)
+{
+    const QJsonArray array = value.toArray();
+    return QVector3D(float(array.at(0).toDouble()), float(array.at(1).toDouble()), float(array.at(2).toDouble()));
+}
+
+static QQuaternion quaternionFromJson(const QJsonValue &value)
+{
+    const QJsonArray array = value.toArray();
+    return QQuaternion(float(array.at(0).toDouble(1.0)), float(array.at(1).toDouble()), float(array.at(2).toDouble()), float(array.at(3).toDouble()));
+}
+
+CameraBookmark CameraBookmark::fromCamera(const Qt3DRaytrace::QCamera *camera)
+{
+    Q_ASSERT(camera);
+
+    CameraBookmark bookmark;
+    bookmark.position = camera->position();
+    bookmark.rotation = camera->rotation();
+    bookmark.fieldOfView = camera->fieldOfView();
+    bookmark.lensDiameter = camera->lensDiameter();
+    bookmark.lensFocalDistance = camera->lensFocalDistance();
+    bookmark.gamma = camera->gamma();
+    bookmark.exposure = camera->exposure();
+    bookmark.tonemapFactor = camera->tonemapFactor();
+    return bookmark;
+}
+
+void CameraBookmark::applyTo(Qt3DRaytrace::QCamera *camera) const
+{
+    Q_ASSERT(camera);
+
+    camera->setPosition(position);
+    camera->setRotation(rotation);
+    camera->setFieldOfView(fieldOfView);
+    camera->setLensDiameter(lensDiameter);
+    camera->setLensFocalDistance(lensFocalDistance);
+    camera->setGamma(gamma);
+    camera->setExposure(exposure);
+    camera->setTonemapFactor(tonemapFactor);
+}
+
+QString CameraBookmarks::sidecarPath(const QString &scenePath)
+{
+    const QFileInfo sceneFileInfo(scenePath);
+    return sceneFileInfo.absoluteDir().filePath(QString("%1.bookmarks.json").arg(sceneFileInfo.completeBaseName()));
+}
+
+bool CameraBookmarks::load(const QString &path)
+{
+    m_path = path;
+    m_bookmarks.clear();
+
+    QFile file(path);
+    if(!file.exists()) {
+        return true;
+    }
+    if(!file.open(QFile::ReadOnly)) {
+        QTextStream(stderr) << "Error: Cannot open camera bookmarks file: " << path << '\n';
+        return false;
+    }
+
+    QJsonParseError parseError;
+    const QJsonDocument document = QJsonDocument::fromJson(file.readAll(), &parseError);
+    if(document.isNull()) {
+        QTextStream(stderr) << "Error: Failed to parse camera bookmarks file: " << path << ": " << parseError.errorString() << '\n';
+        return false;
+    }
+
+    const QJsonObject bookmarks = document.object().value("bookmarks").toObject();
+    for(auto it = bookmarks.begin(); it != bookmarks.end(); ++it) {
+        const QJsonObject object = it.value().toObject();
+
+        CameraBookmark bookmark;
+        bookmark.position = vectorFromJson(object.value("position"));
+        bookmark.rotation = quaternionFromJson(object.value("rotation"));
+        bookmark.fieldOfView = float(object.value("fieldOfView").toDouble());
+        bookmark.lensDiameter = float(object.value("lensDiameter").toDouble());
+        bookmark.lensFocalDistance = float(object.value("lensFocalDistance").toDouble());
+        bookmark.gamma = float(object.value("gamma").toDouble());
+        bookmark.exposure = float(object.value("exposure").toDouble());
+        bookmark.tonemapFactor = float(object.value("tonemapFactor").toDouble());
+        m_bookmarks.insert(it.key(), bookmark);
+    }
+    return true;
+}
+
+bool CameraBookmarks::save() const
+{
+    Q_ASSERT(!m_path.isEmpty());
+
+    QJsonObject bookmarks;
+    for(auto it = m_bookmarks.begin(); it != m_bookmarks.end(); ++it) {
+        const CameraBookmark &bookmark = it.value();
+
+        QJsonObject object;
+        object.insert("position", toJson(bookmark.position));
+        object.insert("rotation", toJson(bookmark.rotation));
+        object.insert("fieldOfView", double(bookmark.fieldOfView));
+        object.insert("lensDiameter", double(bookmark.lensDiameter));
+        object.insert("lensFocalDistance", double(bookmark.lensFocalDistance));
+        object.insert("gamma", double(bookmark.gamma));
+        object.insert("exposure", double(bookmark.exposure));
+        object.insert("tonemapFactor", double(bookmark.tonemapFactor));
+        bookmarks.insert(it.key(), object);
+    }
+
+    QFile file(m_path);
+    if(!file.open(QFile::WriteOnly | QFile::Truncate)) {
+        QTextStream(stderr) << "Error: Cannot write camera bookmarks file: " << m_path << '\n';
+        return false;
+    }
+    file.write(QJsonDocument(QJsonObject{{"bookmarks", bookmarks}}).toJson());
+    return true;
+}
+
+bool CameraBookmarks::contains(const QString &name) const
+{
+    return m_bookmarks.contains(name);
+}
+
+CameraBookmark CameraBookmarks::value(const QString &name) const
+{
+    return m_bookmarks.value(name);
+}
+
+void CameraBookmarks::insert(const QString &name, const CameraBookmark &bookmark)
+{
+    m_bookmarks.insert(name, bookmark);
+}
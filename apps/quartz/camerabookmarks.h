@@ -0,0 +1,51 @@
+/*
+ * Copyright (C) 2018-2019 Michał Siejak
+ * This file is part of Quartz - a raytracing aspect for Qt3D.
+ * See LICENSE file for licensing information.
+ */
+
+#pragma once
+
+#include <QMap>
+#include <QString>
+#include <QVector3D>
+#include <QQuaternion>
+
+namespace Qt3DRaytrace {
+class QCamera;
+} // Qt3DRaytrace
+
+struct CameraBookmark
+{
+    QVector3D position;
+    QQuaternion rotation;
+    float fieldOfView = 0.0f;
+    float lensDiameter = 0.0f;
+    float lensFocalDistance = 0.0f;
+    float gamma = 0.0f;
+    float exposure = 0.0f;
+    float tonemapFactor = 0.0f;
+
+    static CameraBookmark fromCamera(const Qt3DRaytrace::QCamera *camera);
+    void applyTo(Qt3DRaytrace::QCamera *camera) const;
+};
+
+// Named camera bookmarks persisted in a JSON sidecar file next to the scene file.
+class CameraBookmarks
+{
+public:
+    static QString sidecarPath(const QString &scenePath);
+
+    bool load(const QString &path);
+    bool save() const;
+
+    bool contains(const QString &name) const;
+    CameraBookmark value(const QString &name) const;
+    void insert(const QString &name, const CameraBookmark &bookmark);
+
+    QString path() const { return m_path; }
+
+private:
+    QString m_path;
+    QMap<QString, CameraBookmark> m_bookmarks;
+};
@@ -0,0 +1,259 @@
+/*
+ * Copyright (C) 2018-2019 Michał Siejak
+ * This file is part of Quartz - a raytracing aspect for Qt3D.
+ * See LICENSE file for licensing information.
+ */
+
+#include "imagedenoiser.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include <QVector>
+#include <QPair>
+#include <QtConcurrent>
+
+namespace Config {
+static constexpr int   DefaultFilterRadius = 3;
+static constexpr float DefaultSpatialSigma = 2.0f;
+static constexpr float DefaultRangeSigma = 0.5f;
+static constexpr float DefaultFireflyThreshold = 3.0f;
+static constexpr int   RowsPerTask = 16;
+static constexpr float LuminanceEpsilon = 1e-6f;
+} // Config
+
+namespace {
+
+// Single channel image with clamp-to-edge border so that filter kernels can be evaluated without bounds checks.
+struct PaddedPlane
+{
+    PaddedPlane(int width, int height, int padding)
+        : width(width)
+        , height(height)
+        , padding(padding)
+        , stride(width + 2 * padding)
+        , values(stride * (height + 2 * padding))
+        , origin(values.data() + padding * stride + padding)
+    {}
+
+    float *row(int y) const
+    {
+        return origin + y * stride;
+    }
+
+    void extendBorders()
+    {
+        for(int y=0; y<height; ++y) {
+            float *rowValues = row(y);
+            for(int x=1; x<=padding; ++x) {
+                rowValues[-x] = rowValues[0];
+                rowValues[width - 1 + x] = rowValues[width - 1];
+            }
+        }
+        const float *firstRow = row(0) - padding;
+        const float *lastRow = row(height - 1) - padding;
+        for(int y=1; y<=padding; ++y) {
+            std::copy(firstRow, firstRow + stride, row(-y) - padding);
+            std::copy(lastRow, lastRow + stride, row(height - 1 + y) - padding);
+        }
+    }
+
+    const int width;
+    const int height;
+    const int padding;
+    const int stride;
+    QVector<float> values;
+    float *origin;
+};
+
+} // anonymous
+
+static inline float luminance(float r, float g, float b)
+{
+    return 0.2126f * r + 0.7152f * g + 0.0722f * b;
+}
+
+template<typename Func>
+static void parallelForRows(int height, Func func)
+{
+    QVector<QPair<int, int>> rowRanges;
+    rowRanges.reserve(height / Config::RowsPerTask + 1);
+    for(int y=0; y<height; y+=Config::RowsPerTask) {
+        rowRanges.append({y, std::min(y + Config::RowsPerTask, height)});
+    }
+    QtConcurrent::blockingMap(rowRanges, [&func](const QPair<int, int> &range) {
+        func(range.first, range.second);
+    });
+}
+
+ImageDenoiser::ImageDenoiser()
+    : m_filterRadius(Config::DefaultFilterRadius)
+    , m_spatialSigma(Config::DefaultSpatialSigma)
+    , m_rangeSigma(Config::DefaultRangeSigma)
+    , m_fireflyThreshold(Config::DefaultFireflyThreshold)
+{}
+
+void ImageDenoiser::setFilterRadius(int radius)
+{
+    m_filterRadius = std::max(radius, 0);
+}
+
+void ImageDenoiser::setSpatialSigma(float sigma)
+{
+    Q_ASSERT(sigma > 0.0f);
+    m_spatialSigma = sigma;
+}
+
+void ImageDenoiser::setRangeSigma(float sigma)
+{
+    Q_ASSERT(sigma > 0.0f);
+    m_rangeSigma = sigma;
+}
+
+void ImageDenoiser::setFireflyThreshold(float threshold)
+{
+    m_fireflyThreshold = threshold;
+}
+
+bool ImageDenoiser::process(Qt3DRaytrace::QImageData &image) const
+{
+    using ValueType = Qt3DRaytrace::QImageData::ValueType;
+
+    if(image.type != ValueType::Float32 || image.channels < 3 || image.width <= 0 || image.height <= 0) {
+        return false;
+    }
+
+    const int width = image.width;
+    const int height = image.height;
+    const int channels = image.channels;
+    const int radius = m_filterRadius;
+    const int padding = std::max(radius, 1);
+
+    float *pixels = reinterpret_cast<float*>(image.data.data());
+
+    PaddedPlane red(width, height, padding);
+    PaddedPlane green(width, height, padding);
+    PaddedPlane blue(width, height, padding);
+    PaddedPlane guide(width, height, padding);
+
+    // Split interleaved pixels into planes; guide plane temporarily holds linear luminance.
+    parallelForRows(height, [&](int begin, int end) {
+        for(int y=begin; y<end; ++y) {
+            const float *src = pixels + y * width * channels;
+            float *r = red.row(y);
+            float *g = green.row(y);
+            float *b = blue.row(y);
+            float *l = guide.row(y);
+            for(int x=0; x<width; ++x) {
+                r[x] = src[x * channels + 0];
+                g[x] = src[x * channels + 1];
+                b[x] = src[x * channels + 2];
+                l[x] = luminance(r[x], g[x], b[x]);
+            }
+        }
+    });
+
+    // Firefly rejection: clamp luminance of each pixel to mean + k * stddev of its neighborhood.
+    if(m_fireflyThreshold > 0.0f) {
+        guide.extendBorders();
+        parallelForRows(height, [&](int begin, int end) {
+            for(int y=begin; y<end; ++y) {
+                const float *above = guide.row(y - 1);
+                const float *center = guide.row(y);
+                const float *below = guide.row(y + 1);
+                float *r = red.row(y);
+                float *g = green.row(y);
+                float *b = blue.row(y);
+                for(int x=0; x<width; ++x) {
+                    const float n0 = above[x-1], n1 = above[x], n2 = above[x+1];
+                    const float n3 = center[x-1], n4 = center[x+1];
+                    const float n5 = below[x-1], n6 = below[x], n7 = below[x+1];
+                    // Brightest neighbor is excluded so that clusters of two fireflies do not mask each other.
+                    const float brightest = std::max(std::max(std::max(n0, n1), std::max(n2, n3)), std::max(std::max(n4, n5), std::max(n6, n7)));
+                    const float sum = n0 + n1 + n2 + n3 + n4 + n5 + n6 + n7 - brightest;
+                    const float sumSq = n0*n0 + n1*n1 + n2*n2 + n3*n3 + n4*n4 + n5*n5 + n6*n6 + n7*n7 - brightest*brightest;
+                    const float mean = sum * (1.0f / 7.0f);
+                    const float variance = std::max(sumSq * (1.0f / 7.0f) - mean * mean, 0.0f);
+                    const float limit = mean + m_fireflyThreshold * std::sqrt(variance);
+                    const float scale = std::min(1.0f, limit / std::max(center[x], Config::LuminanceEpsilon));
+                    r[x] *= scale;
+                    g[x] *= scale;
+                    b[x] *= scale;
+                }
+            }
+        });
+    }
+
+    // Edge-stopping guide: log-luminance of the (firefly-free) image, robust to HDR dynamic range.
+    parallelForRows(height, [&](int begin, int end) {
+        for(int y=begin; y<end; ++y) {
+            const float *r = red.row(y);
+            const float *g = green.row(y);
+            const float *b = blue.row(y);
+            float *l = guide.row(y);
+            for(int x=0; x<width; ++x) {
+                l[x] = std::log1p(std::max(luminance(r[x], g[x], b[x]), 0.0f));
+            }
+        }
+    });
+
+    red.extendBorders();
+    green.extendBorders();
+    blue.extendBorders();
+    guide.extendBorders();
+
+    const int kernelSize = 2 * radius + 1;
+    const float spatialFactor = -1.0f / (2.0f * m_spatialSigma * m_spatialSigma);
+    const float rangeFactor = 1.0f / (2.0f * m_rangeSigma * m_rangeSigma);
+
+    QVector<float> spatialWeights(kernelSize * kernelSize);
+    for(int dy=-radius; dy<=radius; ++dy) {
+        for(int dx=-radius; dx<=radius; ++dx) {
+            spatialWeights[(dy + radius) * kernelSize + (dx + radius)] = std::exp(float(dx*dx + dy*dy) * spatialFactor);
+        }
+    }
+
+    // Bilateral filter. Kernel taps are applied to whole rows at a time; the range kernel uses a rational
+    // approximation of exp(-t) so that the inner loops contain only arithmetic and can be auto-vectorized.
+    parallelForRows(height, [&](int begin, int end) {
+        QVector<float> accumulators(4 * width);
+        float *accumR = accumulators.data();
+        float *accumG = accumR + width;
+        float *accumB = accumG + width;
+        float *accumW = accumB + width;
+
+        for(int y=begin; y<end; ++y) {
+            std::fill(accumulators.begin(), accumulators.end(), 0.0f);
+
+            const float *guideCenter = guide.row(y);
+            for(int dy=-radius; dy<=radius; ++dy) {
+                for(int dx=-radius; dx<=radius; ++dx) {
+                    const float spatialWeight = spatialWeights[(dy + radius) * kernelSize + (dx + radius)];
+                    const float *guideTap = guide.row(y + dy) + dx;
+                    const float *r = red.row(y + dy) + dx;
+                    const float *g = green.row(y + dy) + dx;
+                    const float *b = blue.row(y + dy) + dx;
+                    for(int x=0; x<width; ++x) {
+                        const float d = guideCenter[x] - guideTap[x];
+                        const float t = d * d * rangeFactor;
+                        const float w = spatialWeight / (1.0f + t * (1.0f + t * (0.5f + t * (1.0f / 6.0f))));
+                        accumR[x] += w * r[x];
+                        accumG[x] += w * g[x];
+                        accumB[x] += w * b[x];
+                        accumW[x] += w;
+                    }
+                }
+            }
+
+            float *dst = pixels + y * width * channels;
+            for(int x=0; x<width; ++x) {
+                const float invWeight = 1.0f / accumW[x];
+                dst[x * channels + 0] = accumR[x] * invWeight;
+                dst[x * channels + 1] = accumG[x] * invWeight;
+                dst[x * channels + 2] = accumB[x] * invWeight;
+            }
+        }
+    });
+
+    return true;
+}
@@ -0,0 +1,28 @@
+/*
+ * Copyright (C) 2018-2019 Michał Siejak
+ * This file is part of Quartz - a raytracing aspect for Qt3D.
+ * See LICENSE file for licensing information.
+ */
+
+#pragma once
+
+#include <Qt3DRaytrace/qimagedata.h>
+
+class ImageDenoiser
+{
+public:
+    ImageDenoiser();
+
+    void setFilterRadius(int radius);
+    void setSpatialSigma(float sigma);
+    void setRangeSigma(float sigma);
+    void setFireflyThreshold(float threshold);
+
+    bool process(Qt3DRaytrace::QImageData &image) const;
+
+private:
+    int m_filterRadius;
+    float m_spatialSigma;
+    float m_rangeSigma;
+    float m_fireflyThreshold;
+};
@@ -5,10 +5,12 @@
  */
 
 #include "imagewriter.h"
+#include "imagedenoiser.h"
 
 #include <utility>
 #include <stb_image_write.h>
 
+#include <QFile>
 #include <QFileInfo>
 #include <QTextStream>
 
@@ -23,9 +25,16 @@ static void swapChannelsRedBlue(QByteArray &imageData, int channels)
     }
 }
 
+static void appendToByteArray(void *context, void *data, int size)
+{
+    static_cast<QByteArray*>(context)->append(static_cast<const char*>(data), size);
+}
+
 ImageWriter::ImageWriter(QObject *parent)
     : QThread(parent)
     , m_quality(100)
+    , m_denoise(false)
+    , m_numSamples(0)
 {
     QObject::connect(this, &ImageWriter::finished, this, &ImageWriter::deleteLater);
 }
@@ -45,6 +54,72 @@ void ImageWriter::setQuality(int quality)
     m_quality = quality;
 }
 
+void ImageWriter::setDenoise(bool denoise)
+{
+    m_denoise = denoise;
+}
+
+void ImageWriter::setNumSamples(int numSamples)
+{
+    m_numSamples = numSamples;
+}
+
+bool ImageWriter::encodeHDR(const Qt3DRaytrace::QImageData &image, int numSamples, QByteArray &output)
+{
+    if(!stbi_write_hdr_to_func(appendToByteArray, &output,
+                               image.width, image.height, image.channels,
+                               reinterpret_cast<const float*>(image.data.constData()))) {
+        return false;
+    }
+
+    // Record sample count as a header variable so that partial renders can be merged by quartz-merge.
+    // Radiance header ends with an empty line, followed by resolution string.
+    if(numSamples > 0) {
+        const int headerEnd = output.indexOf("\n\n");
+        if(headerEnd < 0) {
+            return false;
+        }
+        output.insert(headerEnd + 1, QByteArray("QUARTZ_SPP=") + QByteArray::number(numSamples) + '\n');
+    }
+    return true;
+}
+
+bool ImageWriter::encode(const Qt3DRaytrace::QImageData &image, const QString &format, int quality, int numSamples, QByteArray &output)
+{
+    output.clear();
+
+    int result = 0;
+    int stride = image.width * image.channels * static_cast<int>(image.type);
+
+    if(format == QStringLiteral("jpg")) {
+        result = stbi_write_jpg_to_func(appendToByteArray, &output,
+                                        image.width, image.height, image.channels,
+                                        image.data.constData(), quality);
+    }
+    else if(format == QStringLiteral("png")) {
+        result = stbi_write_png_to_func(appendToByteArray, &output,
+                                        image.width, image.height, image.channels,
+                                        image.data.constData(), stride);
+    }
+    else if(format == QStringLiteral("bmp")) {
+        result = stbi_write_bmp_to_func(appendToByteArray, &output,
+                                        image.width, image.height, image.channels,
+                                        image.data.constData());
+    }
+    else if(format == QStringLiteral("tga")) {
+        result = stbi_write_tga_to_func(appendToByteArray, &output,
+                                        image.width, image.height, image.channels,
+                                        image.data.constData());
+    }
+    else if(format == QStringLiteral("hdr")) {
+        result = encodeHDR(image, numSamples, output);
+    }
+    else {
+        Q_ASSERT_X(0, Q_FUNC_INFO, "Unsupported file format");
+    }
+    return result != 0;
+}
+
 void ImageWriter::run()
 {
     Q_ASSERT(m_outputPath.size() > 0);
@@ -65,37 +140,23 @@ void ImageWriter::run()
         }
     }
 
-    int result = 0;
-    int stride = m_image->width * m_image->channels * static_cast<int>(m_image->type);
-
-    QString fileFormat = QFileInfo(m_outputPath).suffix().toLower();
-    if(fileFormat == QStringLiteral("jpg")) {
-        result = stbi_write_jpg(m_outputPath.toUtf8().constData(),
-                                m_image->width, m_image->height, m_image->channels,
-                                m_image->data.constData(), m_quality);
-    }
-    else if(fileFormat == QStringLiteral("png")) {
-        result = stbi_write_png(m_outputPath.toUtf8().constData(),
-                                m_image->width, m_image->height, m_image->channels,
-                                m_image->data.constData(), stride);
-    }
-    else if(fileFormat == QStringLiteral("bmp")) {
-        result = stbi_write_bmp(m_outputPath.toUtf8().constData(),
-                                m_image->width, m_image->height, m_image->channels,
-                                m_image->data.constData());
-    }
-    else if(fileFormat == QStringLiteral("tga")) {
-        result = stbi_write_tga(m_outputPath.toUtf8().constData(),
-                                m_image->width, m_image->height, m_image->channels,
-                                m_image->data.constData());
-    }
-    else if(fileFormat == QStringLiteral("hdr")) {
-        result = stbi_write_hdr(m_outputPath.toUtf8().constData(),
-                                m_image->width, m_image->height, m_image->channels,
-                                reinterpret_cast<const float*>(m_image->data.constData()));
+    // Denoised & firefly-clamped images are no longer plain sample averages, hence they must not be spp-weighted by quartz-merge.
+    int numSamples = m_numSamples;
+    if(m_denoise && m_image->type == ValueType::Float32) {
+        ImageDenoiser denoiser;
+        if(denoiser.process(*m_image)) {
+            numSamples = 0;
+        }
+        else {
+            QTextStream(stderr) << "Warning: Failed to denoise image: " << m_outputPath << '\n';
+        }
     }
-    else {
-        Q_ASSERT_X(0, Q_FUNC_INFO, "Unsupported file format");
+
+    QByteArray fileData;
+    bool result = encode(*m_image, QFileInfo(m_outputPath).suffix().toLower(), m_quality, numSamples, fileData);
+    if(result) {
+        QFile file(m_outputPath);
+        result = file.open(QFile::WriteOnly) && file.write(fileData) == fileData.size();
     }
 
     if(result) {
@@ -20,11 +20,19 @@ public:
     void setOutputPath(const QString &path);
     void setImage(const Qt3DRaytrace::QImageDataPtr &image);
     void setQuality(int quality);
+    void setDenoise(bool denoise);
+    void setNumSamples(int numSamples);
+
+    // Encodes image into a file format given by its suffix: jpg, png, bmp, tga or hdr.
+    static bool encode(const Qt3DRaytrace::QImageData &image, const QString &format, int quality, int numSamples, QByteArray &output);
 
 private:
     void run() override;
+    static bool encodeHDR(const Qt3DRaytrace::QImageData &image, int numSamples, QByteArray &output);
 
     QString m_outputPath;
     Qt3DRaytrace::QImageDataPtr m_image;
     int m_quality;
+    bool m_denoise;
+    int m_numSamples;
 };
@@ -17,7 +17,7 @@ static constexpr int DefaultViewportWidth  = 1280;
 static constexpr int DefaultViewportHeight = 720;
 } // Config
 
-static void parseOptions(int &viewportWidth, int &viewportHeight, QString &sceneFilePath)
+static void parseOptions(int &viewportWidth, int &viewportHeight, bool &denoise, QString &bookmark, int &seed, bool &hasSeed, QString &sceneFilePath)
 {
     const QString description = QString("%1 %2\n%3\n%4")
             .arg(ApplicationDescription)
@@ -34,7 +34,10 @@ static void parseOptions(int &viewportWidth, int &viewportHeight, QString &scene
                                    QString::number(Config::DefaultViewportWidth));
     QCommandLineOption heightOption({"y", "sizey", "height"}, "Initial viewport height.", "px",
                                     QString::number(Config::DefaultViewportHeight));
-    parser.addOptions({widthOption, heightOption});
+    QCommandLineOption denoiseOption("denoise", "Denoise and remove fireflies from saved HDR images.");
+    QCommandLineOption bookmarkOption({"b", "bookmark"}, "Initial camera bookmark.", "name");
+    QCommandLineOption seedOption("seed", "Random number generator seed.", "value");
+    parser.addOptions({widthOption, heightOption, denoiseOption, bookmarkOption, seedOption});
     parser.addPositionalArgument("scene", "QML scene file path");
 
     parser.process(*QApplication::instance());
@@ -44,6 +47,18 @@ static void parseOptions(int &viewportWidth, int &viewportHeight, QString &scene
         QTextStream(stderr) << "Error: Invalid viewport dimensions\n";
         parser.showHelp(1);
     }
+    denoise = parser.isSet(denoiseOption);
+    bookmark = parser.value(bookmarkOption);
+
+    hasSeed = parser.isSet(seedOption);
+    if(hasSeed) {
+        bool seedValid;
+        seed = parser.value(seedOption).toInt(&seedValid);
+        if(!seedValid) {
+            QTextStream(stderr) << "Error: Invalid random seed\n";
+            parser.showHelp(1);
+        }
+    }
 
     if(parser.positionalArguments().size() > 0) {
         sceneFilePath = parser.positionalArguments().at(0);
@@ -58,8 +73,12 @@ int main(int argc, char *argv[])
 
     int viewportWidth;
     int viewportHeight;
+    bool denoise;
+    QString bookmark;
+    int seed = 0;
+    bool hasSeed;
     QString sceneFilePath;
-    parseOptions(viewportWidth, viewportHeight, sceneFilePath);
+    parseOptions(viewportWidth, viewportHeight, denoise, bookmark, seed, hasSeed, sceneFilePath);
 
     QTextStream(stdout) << ApplicationDescription << " "
                         << ApplicationVersion << "\n";
@@ -73,6 +92,11 @@ int main(int argc, char *argv[])
     window.setWidth(viewportWidth);
     window.setHeight(viewportHeight);
     window.setVulkanInstance(vulkanInstance.get());
+    window.setDenoiseEnabled(denoise);
+    window.setInitialBookmark(bookmark);
+    if(hasSeed) {
+        window.setRandomSeed(seed);
+    }
 
     if(sceneFilePath.length() > 0) {
         if(!window.setSourceFile(sceneFilePath)) {
@@ -19,6 +19,7 @@
 #include <QTimer>
 #include <QKeyEvent>
 
+#include <QTextStream>
 #include <QFileDialog>
 #include <QFile>
 #include <QFileInfo>
@@ -28,6 +29,11 @@ namespace Config {
 static constexpr int     UpdateTitleInterval = 200;
 static constexpr int     SaveImageQuality = 100;
 static constexpr Qt::Key SaveImageKey = Qt::Key_F2;
+static constexpr Qt::Key ReloadSceneKey = Qt::Key_F5;
+static constexpr int     ReloadSceneDelay = 250;
+static constexpr Qt::Key FirstBookmarkKey = Qt::Key_1;
+static constexpr Qt::Key LastBookmarkKey = Qt::Key_9;
+static constexpr Qt::KeyboardModifier SaveBookmarkModifier = Qt::ControlModifier;
 } // Config
 
 RenderWindow::RenderWindow()
@@ -39,7 +45,16 @@ RenderWindow::RenderWindow()
     QObject::connect(updateTitleTimer, &QTimer::timeout, this, &RenderWindow::updateTitle);
     updateTitleTimer->start(Config::UpdateTitleInterval);
 
-    QObject::connect(raytraceAspect(), &Qt3DRaytrace::QRaytraceAspect::imageReady, this, &RenderWindow::imageReady);
+    QObject::connect(raytraceAspect(), &Qt3DRaytrace::QRaytraceAspect::imageReadyWithStatistics, this, &RenderWindow::imageReady);
+
+    // Editors often save files in several steps (or by replacing them), so reload is delayed until changes settle.
+    m_reloadTimer.setSingleShot(true);
+    m_reloadTimer.setInterval(Config::ReloadSceneDelay);
+    QObject::connect(&m_reloadTimer, &QTimer::timeout, this, &RenderWindow::reloadScene);
+    QObject::connect(&m_sceneWatcher, &QFileSystemWatcher::fileChanged, this, &RenderWindow::sceneFileChanged);
+    QObject::connect(&m_sceneWatcher, &QFileSystemWatcher::directoryChanged, this, &RenderWindow::sceneDirectoryChanged);
+
+    QObject::connect(this, &Qt3DQuickWindow::sceneLoaded, this, &RenderWindow::setupScene);
 }
 
 QVulkanInstance *RenderWindow::createDefaultVulkanInstance()
@@ -86,8 +101,12 @@ bool RenderWindow::setSourceFile(const QString &path)
 
     QDir::setCurrent(QFileInfo(absolutePath).absolutePath());
 
+    m_bookmarks.load(CameraBookmarks::sidecarPath(absolutePath));
+    m_restoreCameraOnLoad = false;
+
     setSource(QUrl::fromLocalFile(absolutePath));
     setSceneName(QFileInfo(absolutePath).fileName());
+    watchSceneFiles(absolutePath);
     return true;
 }
 
@@ -132,11 +151,68 @@ bool RenderWindow::saveImage(const QString &path)
     return true;
 }
 
+void RenderWindow::setDenoiseEnabled(bool enabled)
+{
+    m_denoiseEnabled = enabled;
+}
+
+void RenderWindow::setInitialBookmark(const QString &name)
+{
+    m_initialBookmark = name;
+}
+
+void RenderWindow::setRandomSeed(int seed)
+{
+    m_randomSeed = seed;
+    m_hasRandomSeed = true;
+    if(m_renderSettings) {
+        m_renderSettings->setRandomSeed(seed);
+    }
+}
+
+bool RenderWindow::saveBookmark(const QString &name)
+{
+    if(!m_camera) {
+        return false;
+    }
+    m_bookmarks.insert(name, CameraBookmark::fromCamera(m_camera));
+    if(!m_bookmarks.save()) {
+        return false;
+    }
+    QTextStream(stdout) << "Camera bookmark saved: " << name << '\n';
+    return true;
+}
+
+bool RenderWindow::restoreBookmark(const QString &name)
+{
+    if(!m_camera) {
+        return false;
+    }
+    if(!m_bookmarks.contains(name)) {
+        QTextStream(stderr) << "Warning: Camera bookmark not found: " << name << '\n';
+        return false;
+    }
+    m_bookmarks.value(name).applyTo(m_camera);
+    return true;
+}
+
 void RenderWindow::keyPressEvent(QKeyEvent *event)
 {
     if(event->key() == Config::SaveImageKey) {
         requestSaveImage();
     }
+    else if(event->key() == Config::ReloadSceneKey) {
+        reloadScene();
+    }
+    else if(event->key() >= Config::FirstBookmarkKey && event->key() <= Config::LastBookmarkKey) {
+        const QString bookmarkName = QString::number(event->key() - Qt::Key_0);
+        if(event->modifiers() & Config::SaveBookmarkModifier) {
+            saveBookmark(bookmarkName);
+        }
+        else {
+            restoreBookmark(bookmarkName);
+        }
+    }
 
     QWindow::keyPressEvent(event);
 }
@@ -150,12 +226,19 @@ void RenderWindow::updateTitle()
             return;
         }
 
-        QString statisticsString = QString("CPU: %1 ms | GPU: %2 ms | FPS: %3 | Current image: %5 s / %6 spp")
+        QString statisticsString = QString("CPU: %1 ms | GPU: %2 ms | p99: %8 ms | FPS: %3 | Current image: %5 s / %6 spp | VRAM: %7 MB")
                 .arg(statistics.cpuFrameTime, 0, 'f', 2)
                 .arg(statistics.gpuFrameTime, 0, 'f', 2)
                 .arg(1000.0 / frameTime, 0, 'f', 0)
                 .arg(statistics.totalRenderTime, 0, 'f', 2)
-                .arg(statistics.numFramesRendered);
+                .arg(statistics.numFramesRendered)
+                .arg(statistics.resources.deviceAllocatedBytes / (1024 * 1024))
+                .arg(std::max(statistics.cpuFrameTimes.p99, statistics.gpuFrameTimes.p99), 0, 'f', 2);
+
+        const unsigned int numPending = statistics.resources.numPendingLoads + statistics.resources.numPendingUploads;
+        if(numPending > 0) {
+            statisticsString.append(QString(" | Loading: %1").arg(numPending));
+        }
 
         setTitle(QString("%1 - %2 [ %3 ]")
                  .arg(m_sceneName)
@@ -169,7 +252,91 @@ void RenderWindow::updateTitle()
     }
 }
 
-void RenderWindow::imageReady(Qt3DRaytrace::QRenderImage type, Qt3DRaytrace::QImageDataPtr image)
+void RenderWindow::watchSceneFiles(const QString &path)
+{
+    if(!m_sceneWatcher.files().isEmpty()) {
+        m_sceneWatcher.removePaths(m_sceneWatcher.files());
+    }
+    if(!m_sceneWatcher.directories().isEmpty()) {
+        m_sceneWatcher.removePaths(m_sceneWatcher.directories());
+    }
+
+    // Watch all QML files next to the scene file as they may be referenced by the scene (e.g. via EntityLoader).
+    m_sceneFileTimestamps = scanSceneFiles(path);
+    m_sceneWatcher.addPath(QFileInfo(path).absolutePath());
+    m_sceneWatcher.addPaths(m_sceneFileTimestamps.keys());
+}
+
+QHash<QString, QDateTime> RenderWindow::scanSceneFiles(const QString &path) const
+{
+    QHash<QString, QDateTime> timestamps;
+    const QDir sceneDirectory = QFileInfo(path).absoluteDir();
+    for(const QFileInfo &fileInfo : sceneDirectory.entryInfoList({"*.qml"}, QDir::Files)) {
+        timestamps.insert(fileInfo.absoluteFilePath(), fileInfo.lastModified());
+    }
+    return timestamps;
+}
+
+void RenderWindow::sceneFileChanged()
+{
+    m_reloadTimer.start();
+}
+
+void RenderWindow::sceneDirectoryChanged()
+{
+    // Ignore changes to non-QML files in scene directory (e.g. saved images or camera bookmarks).
+    const QString path = source().toLocalFile();
+    if(!path.isEmpty() && scanSceneFiles(path) != m_sceneFileTimestamps) {
+        m_reloadTimer.start();
+    }
+}
+
+void RenderWindow::reloadScene()
+{
+    const QString path = source().toLocalFile();
+    if(path.isEmpty() || !QFileInfo::exists(path)) {
+        return;
+    }
+
+    // Files replaced on save are no longer tracked by the watcher and need to be added again.
+    watchSceneFiles(path);
+
+    // Keep current view across reloads.
+    if(m_camera) {
+        m_reloadBookmark = CameraBookmark::fromCamera(m_camera);
+        m_restoreCameraOnLoad = true;
+    }
+    reload();
+}
+
+void RenderWindow::setupScene(Qt3DCore::QEntity *root)
+{
+    if(!root) {
+        return;
+    }
+
+    m_renderSettings = root->findChild<Qt3DRaytrace::QRenderSettings*>();
+    m_camera = m_renderSettings ? m_renderSettings->camera() : nullptr;
+    if(!m_camera) {
+        m_camera = root->findChild<Qt3DRaytrace::QCamera*>();
+    }
+
+    if(m_renderSettings && m_hasRandomSeed) {
+        m_renderSettings->setRandomSeed(m_randomSeed);
+    }
+
+    if(m_camera) {
+        if(m_restoreCameraOnLoad) {
+            m_reloadBookmark.applyTo(m_camera);
+        }
+        else if(!m_initialBookmark.isEmpty()) {
+            restoreBookmark(m_initialBookmark);
+        }
+    }
+    m_restoreCameraOnLoad = false;
+}
+
+void RenderWindow::imageReady(Qt3DRaytrace::QRenderImage type, Qt3DRaytrace::QImageDataPtr image, const Qt3DRaytrace::QRenderStatistics &statistics)
 {
     Q_UNUSED(type);
     Q_ASSERT(m_saveImageRequestPath.length() > 0);
@@ -178,6 +345,8 @@ void RenderWindow::imageReady(Qt3DRaytrace::QRenderImage type, Qt3DRaytrace::QIm
     imageWriter->setImage(image);
     imageWriter->setOutputPath(m_saveImageRequestPath);
     imageWriter->setQuality(Config::SaveImageQuality);
+    imageWriter->setDenoise(m_denoiseEnabled);
+    imageWriter->setNumSamples(statistics.numFramesRendered);
     imageWriter->start();
 
     m_saveImageRequestPath.clear();
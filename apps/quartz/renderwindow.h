@@ -9,8 +9,17 @@
 #include <Qt3DRaytraceExtras/qt3dquickwindow.h>
 #include <Qt3DRaytrace/qimagedata.h>
 #include <Qt3DRaytrace/qrenderimage.h>
+#include <Qt3DRaytrace/qrendersettings.h>
+#include <Qt3DRaytrace/qcamera.h>
 
 #include <QVulkanInstance>
+#include <QFileSystemWatcher>
+#include <QDateTime>
+#include <QHash>
+#include <QPointer>
+#include <QTimer>
+
+#include "camerabookmarks.h"
 
 class RenderWindow : public Qt3DRaytraceExtras::Quick::Qt3DQuickWindow
 {
@@ -27,14 +36,43 @@ public:
     bool requestSaveImage();
     bool saveImage(const QString &path);
 
+    void setDenoiseEnabled(bool enabled);
+    void setInitialBookmark(const QString &name);
+    void setRandomSeed(int seed);
+
+    bool saveBookmark(const QString &name);
+    bool restoreBookmark(const QString &name);
+
 protected:
     void keyPressEvent(QKeyEvent *event) override;
 
 private slots:
     void updateTitle();
-    void imageReady(Qt3DRaytrace::QRenderImage type, Qt3DRaytrace::QImageDataPtr image);
+    void sceneFileChanged();
+    void sceneDirectoryChanged();
+    void reloadScene();
+    void setupScene(Qt3DCore::QEntity *root);
+    void imageReady(Qt3DRaytrace::QRenderImage type, Qt3DRaytrace::QImageDataPtr image, const Qt3DRaytrace::QRenderStatistics &statistics);
 
 private:
+    void watchSceneFiles(const QString &path);
+    QHash<QString, QDateTime> scanSceneFiles(const QString &path) const;
+
+    QFileSystemWatcher m_sceneWatcher;
+    QHash<QString, QDateTime> m_sceneFileTimestamps;
+    QTimer m_reloadTimer;
+
+    QPointer<Qt3DRaytrace::QRenderSettings> m_renderSettings;
+    QPointer<Qt3DRaytrace::QCamera> m_camera;
+
+    CameraBookmarks m_bookmarks;
+    CameraBookmark m_reloadBookmark;
+    bool m_restoreCameraOnLoad = false;
+    QString m_initialBookmark;
+    int m_randomSeed = 0;
+    bool m_hasRandomSeed = false;
+
     QString m_sceneName;
     QString m_saveImageRequestPath;
+    bool m_denoiseEnabled = false;
 };
@@ -0,0 +1,164 @@
+/*
+ * Copyright (C) 2018-2019 Michał Siejak
+ * This file is part of Quartz - a raytracing aspect for Qt3D.
+ * See LICENSE file for licensing information.
+ */
+
+#include "binarymeshwriter.h"
+
+#include <QIODevice>
+#include <QByteArray>
+#include <QtEndian>
+
+#include <climits>
+#include <cstring>
+
+#include <assimp/mesh.h>
+
+namespace Config {
+static constexpr char    Magic[4] = { 'Q', 'M', 'S', 'H' };
+static constexpr quint32 Version = 1;
+static constexpr int     HeaderSize = 16;
+static constexpr int     VertexSize = 11 * sizeof(float);
+static constexpr int     TriangleSize = 3 * sizeof(quint32);
+static constexpr int     BufferSize = 1 << 20;
+// Vertex & triangle data is read into QVectors whose allocation size is limited to 2 GB in Qt 5 (including header).
+static constexpr qint64  MaxArraySize = qint64(INT_MAX) - 64;
+
+// Tangent fallback for meshes without UVs; same as in Qt3DRaytrace DefaultMeshImporter.
+static const aiVector3D TangentGenUp{0.0f, 1.0f, 0.0f};
+static const aiVector3D TangentGenRight{1.0f, 0.0f, 0.0f};
+static constexpr float     TangentGenLengthThreshold = 0.001f;
+} // Config
+
+static inline char *putUInt(char *ptr, quint32 value)
+{
+    qToLittleEndian(value, ptr);
+    return ptr + sizeof(quint32);
+}
+
+static inline char *putFloat(char *ptr, float value)
+{
+    quint32 bits;
+    std::memcpy(&bits, &value, sizeof(float));
+    return putUInt(ptr, bits);
+}
+
+static inline char *putVector(char *ptr, const aiVector3D &v)
+{
+    ptr = putFloat(ptr, v.x);
+    ptr = putFloat(ptr, v.y);
+    return putFloat(ptr, v.z);
+}
+
+BinaryMeshWriter::BinaryMeshWriter(QIODevice *device)
+    : m_device(device)
+    , m_buffer(Config::BufferSize, Qt::Uninitialized)
+    , m_size(0)
+    , m_error(false)
+{
+    Q_ASSERT(m_device);
+}
+
+bool BinaryMeshWriter::writeMesh(const aiMesh *mesh)
+{
+    Q_ASSERT(mesh);
+    if(!mesh->HasPositions() || !mesh->HasNormals() || !mesh->HasFaces()) {
+        return false;
+    }
+
+    // Polygons are fan-triangulated; points and lines are not representable and are skipped.
+    quint32 numTriangles = 0;
+    for(unsigned int i=0; i<mesh->mNumFaces; ++i) {
+        if(mesh->mFaces[i].mNumIndices >= 3) {
+            numTriangles += mesh->mFaces[i].mNumIndices - 2;
+        }
+    }
+    if(numTriangles == 0) {
+        return false;
+    }
+    if(qint64(mesh->mNumVertices) * Config::VertexSize > Config::MaxArraySize
+            || qint64(numTriangles) * Config::TriangleSize > Config::MaxArraySize) {
+        return false;
+    }
+
+    const bool hasUVs = mesh->HasTextureCoords(0);
+    const bool hasTangents = mesh->HasTangentsAndBitangents();
+
+    char *ptr = reserve(Config::HeaderSize);
+    std::memcpy(ptr, Config::Magic, sizeof(Config::Magic));
+    ptr += sizeof(Config::Magic);
+    ptr = putUInt(ptr, Config::Version);
+    ptr = putUInt(ptr, mesh->mNumVertices);
+    ptr = putUInt(ptr, numTriangles);
+    commit(ptr);
+
+    for(unsigned int i=0; i<mesh->mNumVertices && !m_error; ++i) {
+        const aiVector3D &p = mesh->mVertices[i];
+
+        aiVector3D normal = mesh->mNormals[i];
+        normal.NormalizeSafe();
+
+        aiVector3D tangent;
+        if(hasTangents) {
+            tangent = mesh->mTangents[i];
+        }
+        else {
+            tangent = Config::TangentGenUp ^ normal;
+            if(tangent.SquareLength() < Config::TangentGenLengthThreshold) {
+                tangent = Config::TangentGenRight ^ normal;
+            }
+        }
+        tangent.NormalizeSafe();
+
+        ptr = reserve(Config::VertexSize);
+        ptr = putVector(ptr, p);
+        ptr = putVector(ptr, normal);
+        ptr = putVector(ptr, tangent);
+        if(hasUVs) {
+            ptr = putFloat(ptr, mesh->mTextureCoords[0][i].x);
+            ptr = putFloat(ptr, mesh->mTextureCoords[0][i].y);
+        }
+        else {
+            ptr = putFloat(ptr, 0.0f);
+            ptr = putFloat(ptr, 0.0f);
+        }
+        commit(ptr);
+    }
+
+    for(unsigned int i=0; i<mesh->mNumFaces && !m_error; ++i) {
+        const aiFace &f = mesh->mFaces[i];
+        for(unsigned int j=2; j<f.mNumIndices; ++j) {
+            ptr = reserve(Config::TriangleSize);
+            ptr = putUInt(ptr, f.mIndices[0]);
+            ptr = putUInt(ptr, f.mIndices[j-1]);
+            ptr = putUInt(ptr, f.mIndices[j]);
+            commit(ptr);
+        }
+    }
+
+    flush();
+    return !m_error;
+}
+
+char *BinaryMeshWriter::reserve(int length)
+{
+    if(m_size + length > m_buffer.size()) {
+        flush();
+    }
+    return m_buffer.data() + m_size;
+}
+
+void BinaryMeshWriter::commit(const char *end)
+{
+    m_size = int(end - m_buffer.constData());
+    Q_ASSERT(m_size <= m_buffer.size());
+}
+
+void BinaryMeshWriter::flush()
+{
+    if(m_size > 0 && !m_error) {
+        m_error = m_device->write(m_buffer.constData(), m_size) != m_size;
+    }
+    m_size = 0;
+}
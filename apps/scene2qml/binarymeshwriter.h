@@ -0,0 +1,33 @@
+/*
+ * Copyright (C) 2018-2019 Michał Siejak
+ * This file is part of Quartz - a raytracing aspect for Qt3D.
+ * See LICENSE file for licensing information.
+ */
+
+#pragma once
+
+#include <QByteArray>
+
+class QIODevice;
+struct aiMesh;
+
+// Writes triangle geometry in Quartz binary mesh format (.qmesh).
+// Layout must match the one expected by Qt3DRaytrace BinaryMeshImporter.
+// Meshes must have normals; import with aiProcess_GenNormals to get the same ones DefaultMeshImporter would generate.
+class BinaryMeshWriter
+{
+public:
+    explicit BinaryMeshWriter(QIODevice *device);
+
+    bool writeMesh(const aiMesh *mesh);
+
+private:
+    char *reserve(int length);
+    void commit(const char *end);
+    void flush();
+
+    QIODevice *m_device;
+    QByteArray m_buffer;
+    int m_size;
+    bool m_error;
+};
@@ -5,21 +5,73 @@
  */
 
 #include "exporter.h"
+#include "fileclone.h"
+#include "objwriter.h"
+#include "binarymeshwriter.h"
+#include "exportmanifest.h"
+#include "textureregistry.h"
 
 #include <QCoreApplication>
 #include <QFile>
 #include <QFileInfo>
 #include <QTextStream>
+#include <QDataStream>
+#include <QCryptographicHash>
 #include <QRegularExpression>
+#include <QSet>
+#include <QVector>
+#include <QtConcurrent>
 
 #include <QtMath>
 #include <QDebug>
 
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <stb_image_write.h>
+
+namespace Config {
+// Entity subtrees of at least this size are written to QML as separate parallel tasks.
+static constexpr int MinEntitiesPerQmlTask = 256;
+static constexpr int QmlTasksPerThread = 4;
+// Limits octree depth when partitioning scenes with many entities located close together.
+static constexpr int MaxPartitionDepth = 16;
+// Binary scene format; must match Qt3DRaytrace BinarySceneImporter.
+static constexpr char    BinarySceneMagic[4] = { 'Q', 'S', 'C', 'N' };
+static constexpr quint32 BinarySceneVersion = 1;
+static constexpr quint32 BinarySceneLinearColorsFlag = 0x1;
+} // Config
+
 namespace qml {
 
-static QString indent(int n)
+// Stream manipulators writing indentation and printable ids without allocating temporary strings.
+struct Indent
+{
+    int depth;
+};
+
+struct IdPrintable
+{
+    const QString &id;
+};
+
+static inline Indent indent(int n)
+{
+    return Indent{n};
+}
+
+static QTextStream &operator<<(QTextStream &out, Indent indent)
 {
-    return QString(4 * n, ' ');
+    static const char spaces[] = "                                                                ";
+    static constexpr int maxChunkSize = int(sizeof(spaces)) - 1;
+
+    int numSpaces = 4 * indent.depth;
+    while(numSpaces > 0) {
+        const int chunkSize = std::min(numSpaces, maxChunkSize);
+        out << QLatin1String(spaces, chunkSize);
+        numSpaces -= chunkSize;
+    }
+    return out;
 }
 
 static QString idForName(const QString &name, const QString &defaultId)
@@ -42,26 +94,153 @@ static QString idForName(const QString &name, const QString &defaultId)
     }
 }
 
-static QString idPrintable(const QString &id)
+static inline IdPrintable idPrintable(const QString &id)
+{
+    return IdPrintable{id};
+}
+
+static QTextStream &operator<<(QTextStream &out, IdPrintable id)
 {
-    return QString("id_%1").arg(id);
+    return out << QLatin1String("id_") << id.id;
+}
+
+static QString embeddedTextureExtension(const TextureComponent &texture)
+{
+    if(texture.height > 0) {
+        return "png";
+    }
+    if(!texture.format.isEmpty()) {
+        return texture.format.toLower();
+    }
+    // No format hint; detect common formats by signature.
+    const char *data = reinterpret_cast<const char*>(texture.data);
+    if(texture.width >= 4 && std::memcmp(data, "\x89PNG", 4) == 0) {
+        return "png";
+    }
+    if(texture.width >= 3 && std::memcmp(data, "\xFF\xD8\xFF", 3) == 0) {
+        return "jpg";
+    }
+    return "bin";
 }
 
 } // qml
 
+namespace binary {
+
+static void writeString(QDataStream &out, const QString &str)
+{
+    const QByteArray bytes = str.toUtf8();
+    out << quint32(bytes.size());
+    out.writeRawData(bytes.constData(), bytes.size());
+}
+
+static void collectEntities(const Entity *entity, int parentIndex, QVector<QPair<const Entity*, int>> &entities)
+{
+    const int entityIndex = entities.size();
+    entities.append(qMakePair(entity, parentIndex));
+    for(const Entity *childEntity : entity->children) {
+        collectEntities(childEntity, entityIndex, entities);
+    }
+}
+
+} // binary
+
+namespace manifest {
+
+static void addArray(QCryptographicHash &hash, const void *data, size_t size)
+{
+    hash.addData(reinterpret_cast<const char*>(data), int(size));
+}
+
+static QByteArray hashMeshSource(const aiMesh *mesh, MeshFormat format)
+{
+    QCryptographicHash hash(QCryptographicHash::Md5);
+    const quint32 header[] = {
+        quint32(format),
+        mesh->mNumVertices,
+        mesh->mNumFaces,
+        quint32(mesh->HasNormals()) | quint32(mesh->HasTextureCoords(0)) << 1 | quint32(mesh->HasTangentsAndBitangents()) << 2,
+    };
+    addArray(hash, header, sizeof(header));
+    addArray(hash, mesh->mVertices, mesh->mNumVertices * sizeof(aiVector3D));
+    if(mesh->HasNormals()) {
+        addArray(hash, mesh->mNormals, mesh->mNumVertices * sizeof(aiVector3D));
+    }
+    if(mesh->HasTextureCoords(0)) {
+        addArray(hash, mesh->mTextureCoords[0], mesh->mNumVertices * sizeof(aiVector3D));
+    }
+    if(mesh->HasTangentsAndBitangents()) {
+        addArray(hash, mesh->mTangents, mesh->mNumVertices * sizeof(aiVector3D));
+    }
+    for(unsigned int i=0; i<mesh->mNumFaces; ++i) {
+        const aiFace &f = mesh->mFaces[i];
+        addArray(hash, &f.mNumIndices, sizeof(f.mNumIndices));
+        addArray(hash, f.mIndices, f.mNumIndices * sizeof(unsigned int));
+    }
+    return hash.result().toHex();
+}
+
+static QByteArray hashEmbeddedTextureSource(const TextureComponent &texture)
+{
+    QCryptographicHash hash(QCryptographicHash::Md5);
+    const quint32 header[] = { texture.width, texture.height };
+    addArray(hash, header, sizeof(header));
+    hash.addData(texture.format.toUtf8());
+    addArray(hash, texture.data, texture.height == 0 ? texture.width : texture.width * texture.height * sizeof(aiTexel));
+    return hash.result().toHex();
+}
+
+} // manifest
+
 Exporter::Exporter(const Scene &scene)
     : m_scene(scene)
+    , m_chunkRefcounts(nullptr)
     , m_colorspace(Colorspace::Linear)
+    , m_meshFormat(MeshFormat::OBJ)
+    , m_textureLinksEnabled(true)
+    , m_maxEntitiesPerChunk(0)
+    , m_maxEntitiesPerQmlTask(0)
+    , m_binarySceneEnabled(false)
+    , m_manifest(nullptr)
+    , m_textureRegistry(nullptr)
     , m_numExportedEntities(0)
     , m_numExportedMeshes(0)
     , m_numExportedTextures(0)
-{}
+    , m_numUnchangedMeshes(0)
+    , m_numUnchangedTextures(0)
+    , m_numSharedTextures(0)
+{
+    // Texture files are copied into a single directory. Files of the same name from different source directories
+    // are given unique names up front, so that their parallel copies never target the same path.
+    QSet<QString> usedFileNames;
+    for(const TextureComponent &texture : m_scene.textures) {
+        if(texture.data) {
+            continue;
+        }
+        const QFileInfo sourceFileInfo(texture.name);
+        QString fileName = sourceFileInfo.fileName();
+        // Compared case-insensitively as target file system might be case-insensitive.
+        for(int index=1; usedFileNames.contains(fileName.toLower()); ++index) {
+            fileName = QString("%1-%2").arg(sourceFileInfo.completeBaseName()).arg(index);
+            if(!sourceFileInfo.suffix().isEmpty()) {
+                fileName.append(QString(".%1").arg(sourceFileInfo.suffix()));
+            }
+        }
+        usedFileNames.insert(fileName.toLower());
+        m_textureFileNames.insert(&texture, fileName);
+    }
+}
 
 void Exporter::setPrefix(const QString &prefix)
 {
     m_prefix = prefix;
 }
 
+void Exporter::setSourceDirectory(const QString &path)
+{
+    m_sourceDirectory.setPath(path);
+}
+
 void Exporter::setMeshDirectory(const QString &path)
 {
     m_meshDirectory.setPath(path);
@@ -77,6 +256,52 @@ void Exporter::setColorspace(Colorspace colorspace)
     m_colorspace = colorspace;
 }
 
+void Exporter::setMeshFormat(MeshFormat format)
+{
+    m_meshFormat = format;
+}
+
+void Exporter::setTextureLinksEnabled(bool enabled)
+{
+    m_textureLinksEnabled = enabled;
+}
+
+void Exporter::setPartitioning(int maxEntitiesPerChunk)
+{
+    m_maxEntitiesPerChunk = maxEntitiesPerChunk;
+}
+
+void Exporter::setQmlTaskSize(int maxEntitiesPerTask)
+{
+    m_maxEntitiesPerQmlTask = maxEntitiesPerTask;
+}
+
+void Exporter::setBinarySceneEnabled(bool enabled)
+{
+    m_binarySceneEnabled = enabled;
+}
+
+void Exporter::setManifest(ExportManifest *manifest)
+{
+    m_manifest = manifest;
+}
+
+void Exporter::setTextureRegistry(TextureRegistry *registry)
+{
+    m_textureRegistry = registry;
+
+    // Embedded textures are named after their contents in a shared texture directory,
+    // so that identical textures extracted from different scenes map to the same file.
+    m_sharedTextureNames.clear();
+    if(m_textureRegistry) {
+        for(const TextureComponent &texture : m_scene.textures) {
+            if(texture.data) {
+                m_sharedTextureNames.insert(&texture, QString::fromLatin1(manifest::hashEmbeddedTextureSource(texture)));
+            }
+        }
+    }
+}
+
 bool Exporter::exportMeshes()
 {
     Q_ASSERT(m_rootDirectory.absolutePath().length() > 0);
@@ -84,69 +309,161 @@ bool Exporter::exportMeshes()
 
     const QString absoluteBasePath = QString("%1/%2").arg(m_rootDirectory.absolutePath()).arg(m_meshDirectory.path());
 
-    bool targetDirectory = false;
-    bool status = true;
+    struct MeshTask
+    {
+        const MeshComponent *mesh;
+        QString relativePath;
+        QString targetPath;
+        QByteArray sourceHash;
+        QByteArray outputHash;
+        bool unchanged;
+        bool result;
+    };
+
+    QVector<MeshTask> tasks;
     for(const MeshComponent &mesh : m_scene.meshes) {
         if(mesh.refcount == 0) {
             continue;
         }
-        if(!targetDirectory) {
-            if(!QDir().mkpath(absoluteBasePath)) {
-                qCritical() << "Error: Failed to create mesh target directory:" << absoluteBasePath;
-                return false;
+        tasks.append({&mesh, getMeshLogicalPath(mesh), getMeshAbsolutePath(mesh), QByteArray(), QByteArray(), false, false});
+    }
+    if(tasks.isEmpty()) {
+        return true;
+    }
+    if(!QDir().mkpath(absoluteBasePath)) {
+        qCritical() << "Error: Failed to create mesh target directory:" << absoluteBasePath;
+        return false;
+    }
+
+    // Mesh files are independent of each other; errors are reported afterwards in scene order.
+    QtConcurrent::blockingMap(tasks, [this](MeshTask &task) {
+        if(m_manifest) {
+            task.sourceHash = manifest::hashMeshSource(task.mesh->mesh, m_meshFormat);
+            if(m_manifest->isUpToDate(task.relativePath, task.sourceHash, task.targetPath)) {
+                task.unchanged = true;
+                task.result = true;
+                return;
             }
-            targetDirectory = true;
         }
+        task.result = writeMeshFile(task.targetPath, *task.mesh);
+        if(task.result && m_manifest) {
+            task.outputHash = ExportManifest::hashFile(task.targetPath);
+        }
+    });
 
-        const QString targetPath = getMeshAbsolutePath(mesh);
-        if(writeMeshFile(targetPath, mesh)) {
+    bool status = true;
+    for(const MeshTask &task : tasks) {
+        if(task.unchanged) {
+            m_manifest->keep(task.relativePath);
+            ++m_numUnchangedMeshes;
+            ++m_numExportedMeshes;
+        }
+        else if(task.result) {
+            if(m_manifest) {
+                m_manifest->insert(task.relativePath, task.sourceHash, task.outputHash);
+            }
             ++m_numExportedMeshes;
         }
         else {
-            qCritical() << "Error: Failed to create mesh file:" << targetPath;
+            qCritical() << "Error: Failed to create mesh file:" << task.targetPath;
             status = false;
         }
     }
     return status;
 }
 
-bool Exporter::exportTextures(const QString &basePath)
+bool Exporter::exportTextures()
 {
     Q_ASSERT(m_rootDirectory.absolutePath().length() > 0);
     Q_ASSERT(m_texturesDirectory.absolutePath().length() > 0);
 
     const QString absoluteBasePath = QString("%1/%2").arg(m_rootDirectory.absolutePath()).arg(m_texturesDirectory.path());
 
-    bool targetDirectory = false;
-    bool status = true;
+    struct TextureTask
+    {
+        const TextureComponent *texture;
+        QString sourcePath;
+        QString relativePath;
+        QString targetPath;
+        QByteArray sourceHash;
+        QByteArray outputHash;
+        TextureRegistry::Claim claim;
+        bool unchanged;
+        bool result;
+    };
+
+    QVector<TextureTask> tasks;
     for(const TextureComponent &texture : m_scene.textures) {
         if(texture.refcount == 0) {
             continue;
         }
-        if(!targetDirectory) {
-            if(!QDir().mkpath(absoluteBasePath)) {
-                qCritical() << "Error: Failed to create textures target directory:" << absoluteBasePath;
-                return false;
+        // Shared textures were already hashed & claimed before QML export.
+        const TextureClaim claim = m_textureClaims.value(&texture);
+        tasks.append({&texture, getTextureSourcePath(texture), getTextureLogicalPath(texture), getTextureAbsolutePath(texture), claim.sourceHash, QByteArray(), claim.claim, false, false});
+    }
+    if(tasks.isEmpty()) {
+        return true;
+    }
+    if(!QDir().mkpath(absoluteBasePath)) {
+        qCritical() << "Error: Failed to create textures target directory:" << absoluteBasePath;
+        return false;
+    }
+
+    const bool allowLinks = m_textureLinksEnabled;
+    QtConcurrent::blockingMap(tasks, [this, allowLinks](TextureTask &task) {
+        if(task.claim != TextureRegistry::Claim::Owner) {
+            task.result = (task.claim == TextureRegistry::Claim::Duplicate);
+            return;
+        }
+        if(m_manifest && !m_textureRegistry) {
+            task.sourceHash = hashTextureSource(*task.texture);
+        }
+        if(m_manifest) {
+            if(m_manifest->isUpToDate(task.relativePath, task.sourceHash, task.targetPath)) {
+                task.unchanged = true;
+                task.result = true;
+                return;
             }
-            targetDirectory = true;
         }
-
-        const QString targetPath = getTextureAbsolutePath(texture);
-        if(texture.data) {
-            // TODO: Export embedded texture to file.
-            qWarning() << "Warning: Exporting embedded textures is not yet supported; skipping:" << targetPath;
+        if(task.texture->data) {
+            task.result = writeTextureFile(task.targetPath, *task.texture);
         }
         else {
-            const QString sourcePath = QDir::cleanPath(basePath + QDir::separator() + texture.name);
+            task.result = cloneFile(task.sourcePath, task.targetPath, allowLinks) != CloneMethod::None;
+        }
+        if(task.result && m_manifest) {
+            task.outputHash = ExportManifest::hashFile(task.targetPath);
+        }
+    });
 
-            QFile::remove(targetPath);
-            if(QFile::copy(sourcePath, targetPath)) {
-                ++m_numExportedTextures;
-            }
-            else {
-                qCritical() << "Error: Failed to copy texture file:" << sourcePath;
-                status = false;
+    bool status = true;
+    for(const TextureTask &task : tasks) {
+        if(task.claim == TextureRegistry::Claim::Duplicate) {
+            ++m_numSharedTextures;
+            ++m_numExportedTextures;
+        }
+        else if(task.claim == TextureRegistry::Claim::Conflict) {
+            qCritical() << "Error: Texture file already exported from a different source by another scene:" << task.targetPath;
+            status = false;
+        }
+        else if(task.unchanged) {
+            m_manifest->keep(task.relativePath);
+            ++m_numUnchangedTextures;
+            ++m_numExportedTextures;
+        }
+        else if(task.result) {
+            if(m_manifest) {
+                m_manifest->insert(task.relativePath, task.sourceHash, task.outputHash);
             }
+            ++m_numExportedTextures;
+        }
+        else if(task.texture->data) {
+            qCritical() << "Error: Failed to create embedded texture file:" << task.targetPath;
+            status = false;
+        }
+        else {
+            qCritical() << "Error: Failed to copy texture file:" << task.sourcePath;
+            status = false;
         }
     }
     return status;
@@ -161,29 +478,478 @@ bool Exporter::exportQml(const QString &path, const QString &sceneName)
     }
 
     m_rootDirectory.setPath(QFileInfo(path).path());
+    if(m_textureRegistry) {
+        claimSharedTextures();
+    }
+
+    if(m_binarySceneEnabled) {
+        outputFile.close();
+        return exportQmlBinaryScene(path, sceneName);
+    }
+    if(m_maxEntitiesPerChunk > 0) {
+        outputFile.close();
+        return exportQmlPartitioned(path, sceneName);
+    }
+
+    // Ids depend on the order in which entities and components are visited, so they are all assigned up front.
+    // The entity tree is then split into subtrees which are written in parallel and concatenated in order.
+    createQmlComponentIds();
+    QHash<const Entity*, int> subtreeSizes;
+    const int numEntities = createQmlEntityTreeIds(m_scene.root, subtreeSizes);
+
+    int maxTaskSize = m_maxEntitiesPerQmlTask;
+    if(maxTaskSize <= 0) {
+        maxTaskSize = std::max(Config::MinEntitiesPerQmlTask, numEntities / (Config::QmlTasksPerThread * QThreadPool::globalInstance()->maxThreadCount()));
+    }
+    QVector<QmlSegment> segments;
+    planQmlSegments(m_scene.root, 1, maxTaskSize, subtreeSizes, segments);
+
+    QtConcurrent::blockingMap(segments, [this](QmlSegment &segment) {
+        QTextStream out(&segment.text, QIODevice::WriteOnly);
+        out.setCodec("UTF-8");
+        switch(segment.type) {
+        case QmlSegment::Subtree:
+            writeQmlEntity(out, segment.entity, segment.depth);
+            break;
+        case QmlSegment::Begin:
+            writeQmlEntityBegin(out, segment.entity, segment.depth);
+            break;
+        case QmlSegment::End:
+            writeQmlEntityEnd(out, segment.depth);
+            break;
+        }
+    });
 
     QTextStream out(&outputFile);
+    out.setCodec("UTF-8");
     writeQmlHeader(out, sceneName);
+    writeQmlComponents(out);
+    out.flush();
+    for(const QmlSegment &segment : segments) {
+        outputFile.write(segment.text);
+    }
+    writeQmlFooter(out);
+    return true;
+}
+
+void Exporter::claimSharedTextures()
+{
+    // Shared textures are claimed before any QML is written, so that a texture whose file name is already taken
+    // by a different texture of another scene can be renamed after its contents and referenced by the new name.
+    struct ClaimTask
+    {
+        const TextureComponent *texture;
+        TextureClaim claim;
+    };
 
+    QVector<ClaimTask> tasks;
+    for(const TextureComponent &texture : m_scene.textures) {
+        if(texture.refcount > 0) {
+            tasks.append({&texture, TextureClaim()});
+        }
+    }
+    QtConcurrent::blockingMap(tasks, [this](ClaimTask &task) {
+        task.claim.sourceHash = hashTextureSource(*task.texture);
+        task.claim.claim = m_textureRegistry->claim(getTextureAbsolutePath(*task.texture), task.claim.sourceHash);
+    });
+
+    m_textureClaims.clear();
+    for(ClaimTask &task : tasks) {
+        // Unreadable sources have empty hashes; renaming would not help, they fail to export later anyway.
+        if(task.claim.claim == TextureRegistry::Claim::Conflict && !task.claim.sourceHash.isEmpty()) {
+            const QString hash = QString::fromLatin1(task.claim.sourceHash);
+            if(task.texture->data) {
+                m_sharedTextureNames[task.texture] += QString("-%1").arg(hash);
+            }
+            else {
+                const QFileInfo fileInfo(m_textureFileNames.value(task.texture));
+                QString fileName = QString("%1-%2").arg(fileInfo.completeBaseName()).arg(hash);
+                if(!fileInfo.suffix().isEmpty()) {
+                    fileName.append(QString(".%1").arg(fileInfo.suffix()));
+                }
+                m_textureFileNames[task.texture] = fileName;
+            }
+            task.claim.claim = m_textureRegistry->claim(getTextureAbsolutePath(*task.texture), task.claim.sourceHash);
+        }
+        m_textureClaims.insert(task.texture, task.claim);
+    }
+}
+
+bool Exporter::exportQmlPartitioned(const QString &path, const QString &sceneName)
+{
+    // Entities are flattened (world transforms baked in) and grouped by an octree over their world-space centers.
+    // Each octree leaf is written to a separate, self-contained QML file, instantiated from the root file via EntityLoader.
+    Chunk items;
+    collectChunkItems(m_scene.root, aiMatrix4x4(), items);
+
+    QVector<Chunk> chunks;
+    partitionChunkItems(items, 0, chunks);
+
+    const QFileInfo pathInfo(path);
+    QStringList chunkFileNames;
+    for(int i=0; i<chunks.size(); ++i) {
+        const QString chunkFileName = QString("%1_chunk%2.qml").arg(pathInfo.completeBaseName()).arg(i);
+        if(!writeQmlChunk(m_rootDirectory.filePath(chunkFileName), sceneName, chunks[i])) {
+            return false;
+        }
+        chunkFileNames.append(chunkFileName);
+    }
+
+    QFile outputFile(path);
+    if(!outputFile.open(QFile::WriteOnly | QFile::Truncate)) {
+        qCritical() << "Error: Failed to open output file for writing:" << path;
+        return false;
+    }
+
+    QTextStream out(&outputFile);
+    out.setCodec("UTF-8");
+    writeQmlHeader(out, sceneName);
+
+    // Chunks are loaded only while within loadDistance of loadOrigin (typically bound to camera position).
+    out << qml::indent(1) << "property vector3d loadOrigin: Qt.vector3d(0, 0, 0)\n";
+    out << qml::indent(1) << "property real loadDistance: -1 // Negative: load all chunks\n";
+    out << qml::indent(1) << "function isChunkInRange(boundsMin, boundsMax) {\n";
+    out << qml::indent(2) << "if(loadDistance < 0) return true;\n";
+    out << qml::indent(2) << "var dx = Math.max(boundsMin.x - loadOrigin.x, 0, loadOrigin.x - boundsMax.x);\n";
+    out << qml::indent(2) << "var dy = Math.max(boundsMin.y - loadOrigin.y, 0, loadOrigin.y - boundsMax.y);\n";
+    out << qml::indent(2) << "var dz = Math.max(boundsMin.z - loadOrigin.z, 0, loadOrigin.z - boundsMax.z);\n";
+    out << qml::indent(2) << "return dx*dx + dy*dy + dz*dz <= loadDistance*loadDistance;\n";
+    out << qml::indent(1) << "}\n";
+
+    for(int i=0; i<chunks.size(); ++i) {
+        aiVector3D boundsMin = chunks[i].first().boundsMin;
+        aiVector3D boundsMax = chunks[i].first().boundsMax;
+        for(const ChunkItem &item : chunks[i]) {
+            boundsMin = aiVector3D(std::min(boundsMin.x, item.boundsMin.x), std::min(boundsMin.y, item.boundsMin.y), std::min(boundsMin.z, item.boundsMin.z));
+            boundsMax = aiVector3D(std::max(boundsMax.x, item.boundsMax.x), std::max(boundsMax.y, item.boundsMax.y), std::max(boundsMax.z, item.boundsMax.z));
+        }
+        out << qml::indent(1) << "EntityLoader {\n";
+        out << qml::indent(2) << "objectName: \"chunk" << i << "\"\n";
+        out << qml::indent(2) << "property vector3d boundsMin: Qt.vector3d(" << boundsMin.x << "," << boundsMin.y << "," << boundsMin.z << ")\n";
+        out << qml::indent(2) << "property vector3d boundsMax: Qt.vector3d(" << boundsMax.x << "," << boundsMax.y << "," << boundsMax.z << ")\n";
+        out << qml::indent(2) << "source: root.isChunkInRange(boundsMin, boundsMax) ? \"" << chunkFileNames[i] << "\" : \"\"\n";
+        out << qml::indent(1) << "}\n";
+    }
+    writeQmlFooter(out);
+    return true;
+}
+
+bool Exporter::exportQmlBinaryScene(const QString &path, const QString &sceneName)
+{
+    const QString sceneFileName = QString("%1.qscene").arg(QFileInfo(path).completeBaseName());
+    if(!writeBinaryScene(m_rootDirectory.filePath(sceneFileName))) {
+        return false;
+    }
+
+    QFile outputFile(path);
+    if(!outputFile.open(QFile::WriteOnly | QFile::Truncate)) {
+        qCritical() << "Error: Failed to open output file for writing:" << path;
+        return false;
+    }
+
+    QTextStream out(&outputFile);
+    out.setCodec("UTF-8");
+    writeQmlHeader(out, sceneName);
+    out << qml::indent(1) << "SceneLoader {\n";
+    out << qml::indent(2) << "source: \"" << sceneFileName << "\"\n";
+    out << qml::indent(1) << "}\n";
+    writeQmlFooter(out);
+    return true;
+}
+
+bool Exporter::writeBinaryScene(const QString &path)
+{
+    QVector<QPair<const Entity*, int>> entities;
+    binary::collectEntities(m_scene.root, -1, entities);
+
+    // Assign identifiers the same way QML export does, as asset file names are derived from them.
+    QHash<const Component*, int> componentIndices;
+    QVector<const MeshComponent*> meshes;
+    QVector<const MaterialComponent*> materials;
+    QVector<const TextureComponent*> textures;
+
+    auto textureIndex = [&](int index, const MaterialComponent &material) -> qint32 {
+        if(index < 0) {
+            return -1;
+        }
+        const TextureComponent &texture = m_scene.textures[index];
+        auto it = componentIndices.find(&texture);
+        if(it == componentIndices.end()) {
+            getOrCreateComponentId(&texture, "texture", texture.refcount == 1 ? &material : static_cast<const Component*>(nullptr));
+            it = componentIndices.insert(&texture, textures.size());
+            textures.append(&texture);
+        }
+        return it.value();
+    };
+
+    for(const auto &entry : entities) {
+        const Entity *entity = entry.first;
+        getOrCreateEntityId(entity);
+        if(entity->meshComponentIndex >= 0) {
+            const MeshComponent &mesh = m_scene.meshes[entity->meshComponentIndex];
+            if(!componentIndices.contains(&mesh)) {
+                getOrCreateComponentId(&mesh, "mesh", mesh.refcount == 1 ? entity : static_cast<const Entity*>(nullptr));
+                componentIndices.insert(&mesh, meshes.size());
+                meshes.append(&mesh);
+            }
+        }
+        if(entity->materialComponentIndex >= 0) {
+            const MaterialComponent &material = m_scene.materials[entity->materialComponentIndex];
+            if(!componentIndices.contains(&material)) {
+                getOrCreateComponentId(&material, "material", material.refcount == 1 ? entity : static_cast<const Entity*>(nullptr));
+                componentIndices.insert(&material, materials.size());
+                materials.append(&material);
+            }
+        }
+    }
+
+    QByteArray sceneBytes;
+    QDataStream out(&sceneBytes, QIODevice::WriteOnly);
+    out.setByteOrder(QDataStream::LittleEndian);
+    out.setFloatingPointPrecision(QDataStream::SinglePrecision);
+
+    out.writeRawData(Config::BinarySceneMagic, sizeof(Config::BinarySceneMagic));
+    out << Config::BinarySceneVersion;
+    out << quint32(m_colorspace == Colorspace::Linear ? Config::BinarySceneLinearColorsFlag : 0);
+
+    QVector<std::array<qint32, 3>> materialTextures;
+    for(const MaterialComponent *material : materials) {
+        materialTextures.append({
+            textureIndex(material->albedoTextureIndex, *material),
+            textureIndex(material->roughnessTextureIndex, *material),
+            textureIndex(material->metalnessTextureIndex, *material),
+        });
+    }
+
+    out << quint32(textures.size());
+    for(const TextureComponent *texture : textures) {
+        binary::writeString(out, getTextureLogicalPath(*texture, m_prefix));
+    }
+
+    out << quint32(materials.size());
+    for(int i=0; i<materials.size(); ++i) {
+        const MaterialComponent *material = materials[i];
+        binary::writeString(out, material->name);
+        out << material->albedo.r << material->albedo.g << material->albedo.b;
+        out << material->roughness << material->metalness;
+        out << material->emission.r << material->emission.g << material->emission.b;
+        out << material->emissionIntensity;
+        out << materialTextures[i][0] << materialTextures[i][1] << materialTextures[i][2];
+    }
+
+    out << quint32(meshes.size());
+    for(const MeshComponent *mesh : meshes) {
+        binary::writeString(out, mesh->name);
+        binary::writeString(out, getMeshLogicalPath(*mesh, m_prefix));
+    }
+
+    out << quint32(entities.size());
+    for(const auto &entry : entities) {
+        const Entity *entity = entry.first;
+        const aiMatrix4x4 &m = entity->transform.matrix;
+        binary::writeString(out, entity->name);
+        out << qint32(entry.second);
+        for(const float value : { m.a1, m.a2, m.a3, m.a4, m.b1, m.b2, m.b3, m.b4, m.c1, m.c2, m.c3, m.c4, m.d1, m.d2, m.d3, m.d4 }) {
+            out << value;
+        }
+        out << qint32(entity->meshComponentIndex >= 0 ? componentIndices.value(&m_scene.meshes[entity->meshComponentIndex]) : -1);
+        out << qint32(entity->materialComponentIndex >= 0 ? componentIndices.value(&m_scene.materials[entity->materialComponentIndex]) : -1);
+    }
+    m_numExportedEntities += entities.size();
+
+    QFile outputFile(path);
+    if(!outputFile.open(QFile::WriteOnly | QFile::Truncate) || outputFile.write(sceneBytes) != sceneBytes.size()) {
+        qCritical() << "Error: Failed to write binary scene file:" << path;
+        return false;
+    }
+    return true;
+}
+
+void Exporter::collectChunkItems(const Entity *entity, const aiMatrix4x4 &parentMatrix, Chunk &items)
+{
+    const aiMatrix4x4 worldMatrix = parentMatrix * entity->transform.matrix;
+
+    // Entities with empty meshes have nothing to render, and no bounds to partition by.
+    const aiMesh *mesh = (entity->meshComponentIndex >= 0) ? m_scene.meshes[entity->meshComponentIndex].mesh : nullptr;
+    if(mesh && mesh->mNumVertices > 0) {
+        auto it = m_meshBounds.find(mesh);
+        if(it == m_meshBounds.end()) {
+            aiVector3D boundsMin = mesh->mVertices[0];
+            aiVector3D boundsMax = mesh->mVertices[0];
+            for(unsigned int i=1; i<mesh->mNumVertices; ++i) {
+                const aiVector3D &v = mesh->mVertices[i];
+                boundsMin = aiVector3D(std::min(boundsMin.x, v.x), std::min(boundsMin.y, v.y), std::min(boundsMin.z, v.z));
+                boundsMax = aiVector3D(std::max(boundsMax.x, v.x), std::max(boundsMax.y, v.y), std::max(boundsMax.z, v.z));
+            }
+            it = m_meshBounds.insert(mesh, qMakePair(boundsMin, boundsMax));
+        }
+        const aiVector3D &localMin = it.value().first;
+        const aiVector3D &localMax = it.value().second;
+
+        // Affine transform preserves midpoints, so transforming the local center is enough.
+        ChunkItem item = {entity, worldMatrix, worldMatrix * ((localMin + localMax) * 0.5f), aiVector3D(), aiVector3D()};
+        for(int corner=0; corner<8; ++corner) {
+            const aiVector3D localCorner((corner & 1) ? localMax.x : localMin.x, (corner & 2) ? localMax.y : localMin.y, (corner & 4) ? localMax.z : localMin.z);
+            const aiVector3D v = worldMatrix * localCorner;
+            item.boundsMin = (corner == 0) ? v : aiVector3D(std::min(item.boundsMin.x, v.x), std::min(item.boundsMin.y, v.y), std::min(item.boundsMin.z, v.z));
+            item.boundsMax = (corner == 0) ? v : aiVector3D(std::max(item.boundsMax.x, v.x), std::max(item.boundsMax.y, v.y), std::max(item.boundsMax.z, v.z));
+        }
+        items.append(item);
+    }
+
+    for(const Entity *childEntity : entity->children) {
+        collectChunkItems(childEntity, worldMatrix, items);
+    }
+}
+
+void Exporter::partitionChunkItems(const Chunk &items, int depth, QVector<Chunk> &chunks) const
+{
+    if(items.isEmpty()) {
+        return;
+    }
+
+    aiVector3D boundsMin = items[0].center;
+    aiVector3D boundsMax = boundsMin;
+    for(const ChunkItem &item : items) {
+        boundsMin = aiVector3D(std::min(boundsMin.x, item.center.x), std::min(boundsMin.y, item.center.y), std::min(boundsMin.z, item.center.z));
+        boundsMax = aiVector3D(std::max(boundsMax.x, item.center.x), std::max(boundsMax.y, item.center.y), std::max(boundsMax.z, item.center.z));
+    }
+
+    if(items.size() <= m_maxEntitiesPerChunk || depth >= Config::MaxPartitionDepth || boundsMin == boundsMax) {
+        chunks.append(items);
+        return;
+    }
+
+    const aiVector3D splitPoint = (boundsMin + boundsMax) * 0.5f;
+    Chunk octants[8];
+    for(const ChunkItem &item : items) {
+        const int octant = (item.center.x > splitPoint.x ? 1 : 0) | (item.center.y > splitPoint.y ? 2 : 0) | (item.center.z > splitPoint.z ? 4 : 0);
+        octants[octant].append(item);
+    }
+    for(const Chunk &octant : octants) {
+        partitionChunkItems(octant, depth+1, chunks);
+    }
+}
+
+bool Exporter::writeQmlChunk(const QString &path, const QString &sceneName, const Chunk &items)
+{
+    QFile outputFile(path);
+    if(!outputFile.open(QFile::WriteOnly | QFile::Truncate)) {
+        qCritical() << "Error: Failed to open output file for writing:" << path;
+        return false;
+    }
+
+    // Components shared between entities are declared once per chunk, so that each chunk file is self-contained.
+    QHash<const Component*, unsigned int> chunkRefcounts;
+    for(const ChunkItem &item : items) {
+        ++chunkRefcounts[&m_scene.meshes[item.entity->meshComponentIndex]];
+        if(item.entity->materialComponentIndex >= 0) {
+            const MaterialComponent &material = m_scene.materials[item.entity->materialComponentIndex];
+            if(chunkRefcounts[&material]++ == 0) {
+                for(int textureIndex : { material.albedoTextureIndex, material.roughnessTextureIndex, material.metalnessTextureIndex }) {
+                    if(textureIndex >= 0) {
+                        ++chunkRefcounts[&m_scene.textures[textureIndex]];
+                    }
+                }
+            }
+        }
+    }
+    m_chunkRefcounts = &chunkRefcounts;
+
+    createQmlComponentIds();
+    for(const ChunkItem &item : items) {
+        createQmlEntityIds(item.entity, !item.worldMatrix.IsIdentity());
+    }
+
+    QTextStream out(&outputFile);
+    out.setCodec("UTF-8");
+    writeQmlHeader(out, sceneName);
+    writeQmlComponents(out);
+    for(const ChunkItem &item : items) {
+        writeQmlChunkEntity(out, item, 1);
+    }
+
+    writeQmlFooter(out);
+    m_chunkRefcounts = nullptr;
+    return true;
+}
+
+void Exporter::createQmlComponentIds()
+{
     for(const MeshComponent &mesh : m_scene.meshes) {
-        if(mesh.refcount > 1) {
-            writeQmlMesh(out, mesh, nullptr, 1);
+        if(getRefcount(mesh) > 1) {
+            getOrCreateComponentId(&mesh, "mesh", static_cast<const Entity*>(nullptr));
         }
     }
     for(const TextureComponent &texture : m_scene.textures) {
-        if(texture.refcount > 1) {
-            writeQmlTexture(out, texture, nullptr, 1);
+        if(getRefcount(texture) > 1) {
+            getOrCreateComponentId(&texture, "texture", static_cast<const Component*>(nullptr));
         }
     }
     for(const MaterialComponent &material : m_scene.materials) {
-        if(material.refcount > 1) {
-            writeQmlMaterial(out, material, nullptr, 1);
+        if(getRefcount(material) > 1) {
+            createQmlMaterialIds(material, nullptr);
         }
     }
+}
 
-    writeQmlEntity(out, m_scene.root, 1);
-    writeQmlFooter(out);
-    return true;
+void Exporter::createQmlMaterialIds(const MaterialComponent &material, const Entity *parentEntity)
+{
+    getOrCreateComponentId(&material, "material", parentEntity);
+    for(int textureIndex : { material.albedoTextureIndex, material.roughnessTextureIndex, material.metalnessTextureIndex }) {
+        if(textureIndex >= 0) {
+            const TextureComponent &texture = m_scene.textures[textureIndex];
+            if(getRefcount(texture) == 1) {
+                getOrCreateComponentId(&texture, "texture", &material);
+            }
+        }
+    }
+}
+
+void Exporter::createQmlEntityIds(const Entity *entity, bool hasTransform)
+{
+    getOrCreateEntityId(entity);
+    if(hasTransform) {
+        getOrCreateTransformId(entity);
+    }
+    if(entity->meshComponentIndex >= 0) {
+        const MeshComponent &mesh = m_scene.meshes[entity->meshComponentIndex];
+        if(getRefcount(mesh) == 1) {
+            getOrCreateComponentId(&mesh, "mesh", entity);
+        }
+    }
+    if(entity->materialComponentIndex >= 0) {
+        const MaterialComponent &material = m_scene.materials[entity->materialComponentIndex];
+        if(getRefcount(material) == 1) {
+            createQmlMaterialIds(material, entity);
+        }
+    }
+    ++m_numExportedEntities;
+}
+
+int Exporter::createQmlEntityTreeIds(const Entity *entity, QHash<const Entity*, int> &subtreeSizes)
+{
+    createQmlEntityIds(entity, !entity->transform.isIdentity());
+
+    int subtreeSize = 1;
+    for(const Entity *childEntity : entity->children) {
+        subtreeSize += createQmlEntityTreeIds(childEntity, subtreeSizes);
+    }
+    subtreeSizes.insert(entity, subtreeSize);
+    return subtreeSize;
+}
+
+void Exporter::planQmlSegments(const Entity *entity, int depth, int maxTaskSize, const QHash<const Entity*, int> &subtreeSizes, QVector<QmlSegment> &segments) const
+{
+    if(entity->children.isEmpty() || subtreeSizes.value(entity) <= maxTaskSize) {
+        segments.append({QmlSegment::Subtree, entity, depth, QByteArray()});
+        return;
+    }
+    segments.append({QmlSegment::Begin, entity, depth, QByteArray()});
+    for(const Entity *childEntity : entity->children) {
+        planQmlSegments(childEntity, depth+1, maxTaskSize, subtreeSizes, segments);
+    }
+    segments.append({QmlSegment::End, entity, depth, QByteArray()});
 }
 
 void Exporter::writeQmlHeader(QTextStream &out, const QString &sceneName)
@@ -206,9 +972,37 @@ void Exporter::writeQmlFooter(QTextStream &out)
     out << "}\n";
 }
 
-void Exporter::writeQmlEntity(QTextStream &out, const Entity *entity, int depth)
+void Exporter::writeQmlComponents(QTextStream &out) const
 {
-    const QString id = getOrCreateEntityId(entity);
+    for(const MeshComponent &mesh : m_scene.meshes) {
+        if(getRefcount(mesh) > 1) {
+            writeQmlMesh(out, mesh, 1);
+        }
+    }
+    for(const TextureComponent &texture : m_scene.textures) {
+        if(getRefcount(texture) > 1) {
+            writeQmlTexture(out, texture, 1);
+        }
+    }
+    for(const MaterialComponent &material : m_scene.materials) {
+        if(getRefcount(material) > 1) {
+            writeQmlMaterial(out, material, 1);
+        }
+    }
+}
+
+void Exporter::writeQmlEntity(QTextStream &out, const Entity *entity, int depth) const
+{
+    writeQmlEntityBegin(out, entity, depth);
+    for(const Entity *childEntity : entity->children) {
+        writeQmlEntity(out, childEntity, depth+1);
+    }
+    writeQmlEntityEnd(out, depth);
+}
+
+void Exporter::writeQmlEntityBegin(QTextStream &out, const Entity *entity, int depth) const
+{
+    const QString id = getEntityId(entity);
     QVarLengthArray<QString, 3> componentIds;
 
     out << qml::indent(depth) << "Entity {\n";
@@ -221,11 +1015,41 @@ void Exporter::writeQmlEntity(QTextStream &out, const Entity *entity, int depth)
         componentIds.append(writeQmlTransform(out, entity, depth+1));
     }
 
+    writeQmlEntityComponents(out, entity, depth, componentIds);
+}
+
+void Exporter::writeQmlEntityEnd(QTextStream &out, int depth) const
+{
+    out << qml::indent(depth) << "}\n";
+}
+
+void Exporter::writeQmlChunkEntity(QTextStream &out, const ChunkItem &item, int depth) const
+{
+    const Entity *entity = item.entity;
+    const QString id = getEntityId(entity);
+    QVarLengthArray<QString, 3> componentIds;
+
+    out << qml::indent(depth) << "Entity {\n";
+    out << qml::indent(depth+1) << "id: " << qml::idPrintable(id) << "\n";
+    if(entity->name.length() > 0) {
+        out << qml::indent(depth+1) << "objectName: \"" << entity->name << "\"\n";
+    }
+
+    if(!item.worldMatrix.IsIdentity()) {
+        componentIds.append(writeQmlMatrixTransform(out, entity, item.worldMatrix, depth+1));
+    }
+    writeQmlEntityComponents(out, entity, depth, componentIds);
+
+    writeQmlEntityEnd(out, depth);
+}
+
+void Exporter::writeQmlEntityComponents(QTextStream &out, const Entity *entity, int depth, QVarLengthArray<QString, 3> &componentIds) const
+{
     if(entity->meshComponentIndex >= 0) {
         const MeshComponent &mesh = m_scene.meshes[entity->meshComponentIndex];
         Q_ASSERT(mesh.refcount > 0);
-        if(mesh.refcount == 1) {
-            componentIds.append(writeQmlMesh(out, mesh, entity, depth+1));
+        if(getRefcount(mesh) == 1) {
+            componentIds.append(writeQmlMesh(out, mesh, depth+1));
         }
         else {
             componentIds.append(getComponentId(&mesh));
@@ -234,8 +1058,8 @@ void Exporter::writeQmlEntity(QTextStream &out, const Entity *entity, int depth)
     if(entity->materialComponentIndex >= 0) {
         const MaterialComponent &material = m_scene.materials[entity->materialComponentIndex];
         Q_ASSERT(material.refcount > 0);
-        if(material.refcount == 1) {
-            componentIds.append(writeQmlMaterial(out, material, entity, depth+1));
+        if(getRefcount(material) == 1) {
+            componentIds.append(writeQmlMaterial(out, material, depth+1));
         }
         else {
             componentIds.append(getComponentId(&material));
@@ -252,18 +1076,11 @@ void Exporter::writeQmlEntity(QTextStream &out, const Entity *entity, int depth)
         }
         out << "]\n";
     }
-
-    for(const Entity *childEntity : entity->children) {
-        writeQmlEntity(out, childEntity, depth+1);
-    }
-
-    out << qml::indent(depth) << "}\n";
-    ++m_numExportedEntities;
 }
 
-QString Exporter::writeQmlMesh(QTextStream &out, const MeshComponent &mesh, const Entity *parentEntity, int depth)
+QString Exporter::writeQmlMesh(QTextStream &out, const MeshComponent &mesh, int depth) const
 {
-    const QString id = getOrCreateComponentId(&mesh, "mesh", parentEntity);
+    const QString id = getComponentId(&mesh);
     out << qml::indent(depth) << "Mesh {\n";
     out << qml::indent(depth+1) << "id: " << qml::idPrintable(id) << "\n";
     if(mesh.name.length() > 0) {
@@ -274,14 +1091,14 @@ QString Exporter::writeQmlMesh(QTextStream &out, const MeshComponent &mesh, cons
     return id;
 }
 
-QString Exporter::writeQmlMaterial(QTextStream &out, const MaterialComponent &material, const Entity *parentEntity, int depth)
+QString Exporter::writeQmlMaterial(QTextStream &out, const MaterialComponent &material, int depth) const
 {
-    auto resolveTextureId = [this, &out, &material, depth](int textureIndex) -> QString {
+    auto resolveTextureId = [this, &out, depth](int textureIndex) -> QString {
         if(textureIndex >= 0) {
             const TextureComponent &textureComponent = m_scene.textures[textureIndex];
             Q_ASSERT(textureComponent.refcount > 0);
-            if(textureComponent.refcount == 1) {
-                return writeQmlTexture(out, textureComponent, &material, depth+1);
+            if(getRefcount(textureComponent) == 1) {
+                return writeQmlTexture(out, textureComponent, depth+1);
             }
             else {
                 return getComponentId(&textureComponent);
@@ -290,7 +1107,7 @@ QString Exporter::writeQmlMaterial(QTextStream &out, const MaterialComponent &ma
         return QString();
     };
 
-    const QString id = getOrCreateComponentId(&material, "material", parentEntity);
+    const QString id = getComponentId(&material);
     out << qml::indent(depth) << "Material {\n";
     out << qml::indent(depth+1) << "id: " << qml::idPrintable(id) << "\n";
     if(material.name.length() > 0) {
@@ -331,9 +1148,9 @@ QString Exporter::writeQmlMaterial(QTextStream &out, const MaterialComponent &ma
     return id;
 }
 
-QString Exporter::writeQmlTexture(QTextStream &out, const TextureComponent &texture, const MaterialComponent *parentMaterial, int depth)
+QString Exporter::writeQmlTexture(QTextStream &out, const TextureComponent &texture, int depth) const
 {
-    const QString id = getOrCreateComponentId(&texture, "texture", parentMaterial);
+    const QString id = getComponentId(&texture);
     out << qml::indent(depth) << "Texture {\n";
     out << qml::indent(depth+1) << "id: " << qml::idPrintable(id) << "\n";
     out << qml::indent(depth+1) << "source: \"file:" << getTextureLogicalPath(texture, m_prefix) << "\"\n";
@@ -341,9 +1158,9 @@ QString Exporter::writeQmlTexture(QTextStream &out, const TextureComponent &text
     return id;
 }
 
-QString Exporter::writeQmlTransform(QTextStream &out, const Entity *entity, int depth)
+QString Exporter::writeQmlTransform(QTextStream &out, const Entity *entity, int depth) const
 {
-    const QString id = getOrCreateTransformId(entity);
+    const QString id = getTransformId(entity);
     const Transform &transform = entity->transform;
 
     out << qml::indent(depth) << "Transform {\n";
@@ -377,69 +1194,71 @@ QString Exporter::writeQmlTransform(QTextStream &out, const Entity *entity, int
     return id;
 }
 
-bool Exporter::writeMeshFile(const QString &targetPath, const MeshComponent &mesh) const
+QString Exporter::writeQmlMatrixTransform(QTextStream &out, const Entity *entity, const aiMatrix4x4 &matrix, int depth) const
 {
-    const aiMesh *data = mesh.mesh;
-    if(!data->HasPositions()) {
-        return false;
-    }
+    const QString id = getTransformId(entity);
+
+    out << qml::indent(depth) << "Transform {\n";
+    out << qml::indent(depth+1) << "id: " << qml::idPrintable(id) << "\n";
+    out << qml::indent(depth+1) << "matrix: Qt.matrix4x4("
+        << matrix.a1 << "," << matrix.a2 << "," << matrix.a3 << "," << matrix.a4 << ","
+        << matrix.b1 << "," << matrix.b2 << "," << matrix.b3 << "," << matrix.b4 << ","
+        << matrix.c1 << "," << matrix.c2 << "," << matrix.c3 << "," << matrix.c4 << ","
+        << matrix.d1 << "," << matrix.d2 << "," << matrix.d3 << "," << matrix.d4 << ")\n";
+    out << qml::indent(depth) << "}\n";
+    return id;
+}
 
+bool Exporter::writeMeshFile(const QString &targetPath, const MeshComponent &mesh) const
+{
     QFile outputFile(targetPath);
     if(!outputFile.open(QFile::WriteOnly | QFile::Truncate)) {
-        qCritical() << "Error: Failed to open output file for writing:" << targetPath;
         return false;
     }
 
-    QTextStream out(&outputFile);
+    if(m_meshFormat == MeshFormat::Binary) {
+        BinaryMeshWriter writer(&outputFile);
+        return writer.writeMesh(mesh.mesh);
+    }
+    else {
+        ObjWriter writer(&outputFile);
+        return writer.writeMesh(mesh.mesh);
+    }
+}
 
-    bool hasNormals = data->HasNormals();
-    bool hasUVs = data->HasTextureCoords(0);
+bool Exporter::writeTextureFile(const QString &targetPath, const TextureComponent &texture) const
+{
+    Q_ASSERT(texture.data);
 
-    for(unsigned int i=0; i<data->mNumVertices; ++i) {
-        const auto &v = data->mVertices[i];
-        out << "v " << v.x << ' ' << v.y << ' ' << v.z << '\n';
+    QByteArray imageData;
+    if(texture.height == 0) {
+        // Compressed image file (PNG, JPEG, etc.) embedded as-is; its size in bytes is stored in width.
+        imageData = QByteArray::fromRawData(reinterpret_cast<const char*>(texture.data), int(texture.width));
     }
-    if(hasNormals) {
-        for(unsigned int i=0; i<data->mNumVertices; ++i) {
-            const auto &n = data->mNormals[i];
-            out << "vn " << n.x << ' ' << n.y << ' ' << n.z << '\n';
+    else {
+        // Uncompressed BGRA texels.
+        const int numPixels = int(texture.width * texture.height);
+        QByteArray pixels(numPixels * 4, Qt::Uninitialized);
+        uchar *rgba = reinterpret_cast<uchar*>(pixels.data());
+        for(int i=0; i<numPixels; ++i) {
+            rgba[4*i + 0] = texture.data[4*i + 2];
+            rgba[4*i + 1] = texture.data[4*i + 1];
+            rgba[4*i + 2] = texture.data[4*i + 0];
+            rgba[4*i + 3] = texture.data[4*i + 3];
         }
-    }
-    if(hasUVs) {
-        for(unsigned int i=0; i<data->mNumVertices; ++i) {
-            const auto &t = data->mTextureCoords[0][i];
-            out << "vt " << t.x << ' ' << t.y << '\n';
+        auto writeFunc = [](void *context, void *data, int size) {
+            reinterpret_cast<QByteArray*>(context)->append(reinterpret_cast<const char*>(data), size);
+        };
+        if(!stbi_write_png_to_func(writeFunc, &imageData, int(texture.width), int(texture.height), 4, pixels.constData(), int(texture.width) * 4)) {
+            return false;
         }
     }
 
-    Q_ASSERT(data->mFaces);
-    for(unsigned int i=0; i<data->mNumFaces; ++i) {
-        const auto &f = data->mFaces[i];
-        out << "f ";
-        for(unsigned int j=0; j<f.mNumIndices; j++) {
-            const QString index = QString::number(f.mIndices[j] + 1);
-
-            if(hasNormals && hasUVs) {
-                out << index << '/' << index << '/' << index;
-            }
-            else if(hasUVs) {
-                out << index << '/' << index;
-            }
-            else if(hasNormals) {
-                out << index << "//" << index;
-            }
-            else {
-                out << index;
-            }
-
-            if(j+1 < f.mNumIndices) {
-                out << ' ';
-            }
-        }
-        out << '\n';
+    QFile outputFile(targetPath);
+    if(!outputFile.open(QFile::WriteOnly | QFile::Truncate)) {
+        return false;
     }
-
-    return true;
+    return outputFile.write(imageData) == imageData.size();
 }
 
 QString Exporter::createUniqueId(const QString &id)
@@ -468,6 +1287,12 @@ QString Exporter::getEntityId(const Entity *entity) const
     return m_entityIds.value(entity);
 }
 
+QString Exporter::getTransformId(const Entity *entity) const
+{
+    Q_ASSERT(m_transformIds.contains(entity));
+    return m_transformIds.value(entity);
+}
+
 QString Exporter::getOrCreateEntityId(const Entity *entity)
 {
     auto it = m_entityIds.find(entity);
@@ -495,6 +1320,14 @@ QString Exporter::getOrCreateTransformId(const Entity *entity)
     }
 }
 
+unsigned int Exporter::getRefcount(const Component &component) const
+{
+    if(m_chunkRefcounts) {
+        return m_chunkRefcounts->value(&component, 0);
+    }
+    return component.refcount;
+}
+
 QString Exporter::getComponentId(const Component *component) const
 {
     Q_ASSERT(m_componentIds.contains(component));
@@ -543,9 +1376,13 @@ QString Exporter::getOrCreateComponentId(const Component *component, const QStri
 
 QString Exporter::getMeshLogicalPath(const MeshComponent &mesh, const QString &prefix) const
 {
-    const QString meshFileId = getComponentId(&mesh).replace(QRegularExpression("_mesh$"), "");
+    QString meshFileId = getComponentId(&mesh);
+    if(meshFileId.endsWith(QLatin1String("_mesh"))) {
+        meshFileId.chop(5);
+    }
 
-    QString logicalPath = QString("%1/%2.obj").arg(m_meshDirectory.path()).arg(meshFileId);
+    const QString extension = (m_meshFormat == MeshFormat::Binary) ? "qmesh" : "obj";
+    QString logicalPath = QString("%1/%2.%3").arg(m_meshDirectory.path()).arg(meshFileId).arg(extension);
     if(prefix.length() > 0) {
         logicalPath.prepend(QString("%1/").arg(prefix));
     }
@@ -561,11 +1398,17 @@ QString Exporter::getTextureLogicalPath(const TextureComponent &texture, const Q
 {
     QString logicalPath;
     if(texture.data) {
-        const QString textureFileId = getComponentId(&texture).replace(QRegularExpression("_texture$"), "");
-        logicalPath = QString("%1/%2.png").arg(m_texturesDirectory.path()).arg(textureFileId);
+        QString textureFileId = m_sharedTextureNames.value(&texture);
+        if(textureFileId.isEmpty()) {
+            textureFileId = getComponentId(&texture);
+            if(textureFileId.endsWith(QLatin1String("_texture"))) {
+                textureFileId.chop(8);
+            }
+        }
+        logicalPath = QString("%1/%2.%3").arg(m_texturesDirectory.path()).arg(textureFileId).arg(qml::embeddedTextureExtension(texture));
     }
     else {
-        logicalPath = QString("%1/%2").arg(m_texturesDirectory.path()).arg(QFileInfo(texture.name).fileName());
+        logicalPath = QString("%1/%2").arg(m_texturesDirectory.path()).arg(m_textureFileNames.value(&texture));
     }
 
     if(prefix.length() > 0) {
@@ -579,6 +1422,16 @@ QString Exporter::getTextureAbsolutePath(const TextureComponent &texture) const
     return QString("%1/%2").arg(m_rootDirectory.absolutePath()).arg(getTextureLogicalPath(texture));
 }
 
+QString Exporter::getTextureSourcePath(const TextureComponent &texture) const
+{
+    return texture.data ? QString() : QDir::cleanPath(m_sourceDirectory.path() + QDir::separator() + texture.name);
+}
+
+QByteArray Exporter::hashTextureSource(const TextureComponent &texture) const
+{
+    return texture.data ? manifest::hashEmbeddedTextureSource(texture) : ExportManifest::hashFile(getTextureSourcePath(texture));
+}
+
 QString Exporter::colorString(const Color &c) const
 {
     switch(m_colorspace) {
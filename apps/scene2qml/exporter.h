@@ -8,11 +8,17 @@
 
 #include <QString>
 #include <QMap>
+#include <QHash>
+#include <QVector>
 #include <QDir>
+#include <QPair>
+#include <QVarLengthArray>
 
 #include "scene.h"
+#include "textureregistry.h"
 
 class QTextStream;
+class ExportManifest;
 
 enum class Colorspace
 {
@@ -20,42 +26,110 @@ enum class Colorspace
     sRGB,
 };
 
+enum class MeshFormat
+{
+    OBJ,
+    Binary,
+};
+
 class Exporter
 {
 public:
     explicit Exporter(const Scene &scene);
 
     void setPrefix(const QString &prefix);
+    void setSourceDirectory(const QString &path);
     void setMeshDirectory(const QString &path);
     void setTexturesDirectory(const QString &path);
     void setColorspace(Colorspace colorspace);
+    void setMeshFormat(MeshFormat format);
+    void setTextureLinksEnabled(bool enabled);
+    void setPartitioning(int maxEntitiesPerChunk);
+    // Upper bound of entities written to QML by a single parallel task; 0 chooses one based on thread count.
+    void setQmlTaskSize(int maxEntitiesPerTask);
+    void setBinarySceneEnabled(bool enabled);
+    void setManifest(ExportManifest *manifest);
+    void setTextureRegistry(TextureRegistry *registry);
 
     bool exportQml(const QString &path, const QString &sceneName);
     bool exportMeshes();
-    bool exportTextures(const QString &basePath);
+    bool exportTextures();
 
     int numExportedEntities() const { return m_numExportedEntities; }
     int numExportedMeshes() const { return m_numExportedMeshes; }
     int numExportedTextures() const { return m_numExportedTextures; }
+    int numUnchangedMeshes() const { return m_numUnchangedMeshes; }
+    int numUnchangedTextures() const { return m_numUnchangedTextures; }
+    int numSharedTextures() const { return m_numSharedTextures; }
 
 private:
+    struct ChunkItem
+    {
+        const Entity *entity;
+        aiMatrix4x4 worldMatrix;
+        aiVector3D center;
+        aiVector3D boundsMin;
+        aiVector3D boundsMax;
+    };
+    using Chunk = QVector<ChunkItem>;
+
+    struct TextureClaim
+    {
+        QByteArray sourceHash;
+        TextureRegistry::Claim claim = TextureRegistry::Claim::Owner;
+    };
+
+    struct QmlSegment
+    {
+        enum Type { Subtree, Begin, End };
+        Type type;
+        const Entity *entity;
+        int depth;
+        QByteArray text;
+    };
+
+    void claimSharedTextures();
+
+    bool exportQmlPartitioned(const QString &path, const QString &sceneName);
+    bool exportQmlBinaryScene(const QString &path, const QString &sceneName);
+    bool writeBinaryScene(const QString &path);
+    void collectChunkItems(const Entity *entity, const aiMatrix4x4 &parentMatrix, Chunk &items);
+    void partitionChunkItems(const Chunk &items, int depth, QVector<Chunk> &chunks) const;
+    bool writeQmlChunk(const QString &path, const QString &sceneName, const Chunk &items);
+
+    void createQmlComponentIds();
+    void createQmlMaterialIds(const MaterialComponent &material, const Entity *parentEntity);
+    void createQmlEntityIds(const Entity *entity, bool hasTransform);
+    int createQmlEntityTreeIds(const Entity *entity, QHash<const Entity*, int> &subtreeSizes);
+    void planQmlSegments(const Entity *entity, int depth, int maxTaskSize, const QHash<const Entity*, int> &subtreeSizes, QVector<QmlSegment> &segments) const;
+
     void writeQmlHeader(QTextStream &out, const QString &sceneName);
     void writeQmlFooter(QTextStream &out);
-    void writeQmlEntity(QTextStream &out, const Entity *entity, int depth);
-    QString writeQmlMesh(QTextStream &out, const MeshComponent &mesh, const Entity *parentEntity, int depth);
-    QString writeQmlMaterial(QTextStream &out, const MaterialComponent &material, const Entity *parentEntity, int depth);
-    QString writeQmlTexture(QTextStream &out, const TextureComponent &texture, const MaterialComponent *parentMaterial, int depth);
-    QString writeQmlTransform(QTextStream &out, const Entity *entity, int depth);
+    void writeQmlComponents(QTextStream &out) const;
+    void writeQmlEntity(QTextStream &out, const Entity *entity, int depth) const;
+    void writeQmlEntityBegin(QTextStream &out, const Entity *entity, int depth) const;
+    void writeQmlEntityEnd(QTextStream &out, int depth) const;
+    void writeQmlChunkEntity(QTextStream &out, const ChunkItem &item, int depth) const;
+    void writeQmlEntityComponents(QTextStream &out, const Entity *entity, int depth, QVarLengthArray<QString, 3> &componentIds) const;
+    QString writeQmlMesh(QTextStream &out, const MeshComponent &mesh, int depth) const;
+    QString writeQmlMaterial(QTextStream &out, const MaterialComponent &material, int depth) const;
+    QString writeQmlTexture(QTextStream &out, const TextureComponent &texture, int depth) const;
+    QString writeQmlTransform(QTextStream &out, const Entity *entity, int depth) const;
+    QString writeQmlMatrixTransform(QTextStream &out, const Entity *entity, const aiMatrix4x4 &matrix, int depth) const;
 
     bool writeMeshFile(const QString &targetPath, const MeshComponent &mesh) const;
+    bool writeTextureFile(const QString &targetPath, const TextureComponent &texture) const;
 
     QString createUniqueId(const QString &id);
     QString createUniqueId(const QString &hint, const QString &defaultName);
 
     QString getEntityId(const Entity *entity) const;
+    QString getTransformId(const Entity *entity) const;
     QString getOrCreateEntityId(const Entity *entity);
     QString getOrCreateTransformId(const Entity *entity);
 
+    unsigned int getRefcount(const Component &component) const;
+
     QString getComponentId(const Component *component) const;
     QString getOrCreateComponentId(const Component *component, const QString &defaultId, const Entity *parentEntity);
     QString getOrCreateComponentId(const Component *component, const QString &defaultId, const Component *parentComponent);
@@ -64,6 +138,8 @@ private:
     QString getMeshAbsolutePath(const MeshComponent &mesh) const;
     QString getTextureLogicalPath(const TextureComponent &texture, const QString &prefix="") const;
     QString getTextureAbsolutePath(const TextureComponent &texture) const;
+    QString getTextureSourcePath(const TextureComponent &texture) const;
+    QByteArray hashTextureSource(const TextureComponent &texture) const;
 
     QString colorString(const Color &c) const;
 
@@ -73,16 +149,32 @@ private:
     QMap<const Entity*, QString> m_entityIds;
     QMap<const Entity*, QString> m_transformIds;
     QMap<const Component*, QString> m_componentIds;
+    const QHash<const Component*, unsigned int> *m_chunkRefcounts;
+    QHash<const aiMesh*, QPair<aiVector3D, aiVector3D>> m_meshBounds;
+    QHash<const TextureComponent*, QString> m_sharedTextureNames;
+    QHash<const TextureComponent*, QString> m_textureFileNames;
+    QHash<const TextureComponent*, TextureClaim> m_textureClaims;
 
     QDir m_rootDirectory;
+    QDir m_sourceDirectory;
     QDir m_meshDirectory;
     QDir m_texturesDirectory;
 
     QString m_prefix;
 
     Colorspace m_colorspace;
+    MeshFormat m_meshFormat;
+    bool m_textureLinksEnabled;
+    int m_maxEntitiesPerChunk;
+    int m_maxEntitiesPerQmlTask;
+    bool m_binarySceneEnabled;
+    ExportManifest *m_manifest;
+    TextureRegistry *m_textureRegistry;
 
     int m_numExportedEntities;
     int m_numExportedMeshes;
     int m_numExportedTextures;
+    int m_numUnchangedMeshes;
+    int m_numUnchangedTextures;
+    int m_numSharedTextures;
 };
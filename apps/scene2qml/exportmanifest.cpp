@@ -0,0 +1,110 @@
+/*
+ * Copyright (C) 2018-2019 Michał Siejak
+ * This file is part of Quartz - a raytracing aspect for Qt3D.
+ * See LICENSE file for licensing information.
+ */
+
+#include "exportmanifest.h"
+
+#include <QCryptographicHash>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QDebug>
+
+namespace Config {
+static constexpr int ManifestVersion = 1;
+static constexpr QCryptographicHash::Algorithm HashAlgorithm = QCryptographicHash::Md5;
+} // Config
+
+QString ExportManifest::sidecarPath(const QString &outputPath)
+{
+    const QFileInfo outputInfo(outputPath);
+    return outputInfo.dir().filePath(QString("%1.manifest.json").arg(outputInfo.completeBaseName()));
+}
+
+QByteArray ExportManifest::hashFile(const QString &path)
+{
+    QFile file(path);
+    if(!file.open(QFile::ReadOnly)) {
+        return QByteArray();
+    }
+    QCryptographicHash hash(Config::HashAlgorithm);
+    if(!hash.addData(&file)) {
+        return QByteArray();
+    }
+    return hash.result().toHex();
+}
+
+bool ExportManifest::load(const QString &path)
+{
+    m_previousEntries.clear();
+    m_entries.clear();
+
+    QFile file(path);
+    if(!file.exists()) {
+        return true;
+    }
+    if(!file.open(QFile::ReadOnly)) {
+        qWarning() << "Warning: Cannot open export manifest file:" << path;
+        return false;
+    }
+
+    const QJsonObject document = QJsonDocument::fromJson(file.readAll()).object();
+    if(document.value("version").toInt() != Config::ManifestVersion) {
+        // Unknown or corrupted manifest: regenerate everything.
+        return true;
+    }
+
+    const QJsonObject files = document.value("files").toObject();
+    for(auto it = files.begin(); it != files.end(); ++it) {
+        const QJsonObject object = it.value().toObject();
+        Entry entry;
+        entry.sourceHash = object.value("source").toString().toLatin1();
+        entry.outputHash = object.value("output").toString().toLatin1();
+        m_previousEntries.insert(it.key(), entry);
+    }
+    return true;
+}
+
+bool ExportManifest::save(const QString &path) const
+{
+    QJsonObject files;
+    for(auto it = m_entries.begin(); it != m_entries.end(); ++it) {
+        files.insert(it.key(), QJsonObject{
+            {"source", QString::fromLatin1(it.value().sourceHash)},
+            {"output", QString::fromLatin1(it.value().outputHash)},
+        });
+    }
+
+    QFile file(path);
+    if(!file.open(QFile::WriteOnly | QFile::Truncate)) {
+        qCritical() << "Error: Cannot write export manifest file:" << path;
+        return false;
+    }
+    file.write(QJsonDocument(QJsonObject{{"version", Config::ManifestVersion}, {"files", files}}).toJson());
+    return true;
+}
+
+bool ExportManifest::isUpToDate(const QString &relativePath, const QByteArray &sourceHash, const QString &absolutePath) const
+{
+    auto it = m_previousEntries.find(relativePath);
+    if(it == m_previousEntries.end() || sourceHash.isEmpty() || it.value().sourceHash != sourceHash) {
+        return false;
+    }
+    // Output might have been modified or removed since it was generated.
+    return hashFile(absolutePath) == it.value().outputHash;
+}
+
+void ExportManifest::insert(const QString &relativePath, const QByteArray &sourceHash, const QByteArray &outputHash)
+{
+    m_entries.insert(relativePath, {sourceHash, outputHash});
+}
+
+void ExportManifest::keep(const QString &relativePath)
+{
+    Q_ASSERT(m_previousEntries.contains(relativePath));
+    m_entries.insert(relativePath, m_previousEntries.value(relativePath));
+}
@@ -0,0 +1,37 @@
+/*
+ * Copyright (C) 2018-2019 Michał Siejak
+ * This file is part of Quartz - a raytracing aspect for Qt3D.
+ * See LICENSE file for licensing information.
+ */
+
+#pragma once
+
+#include <QByteArray>
+#include <QHash>
+#include <QString>
+
+// Records content hashes of asset sources and of files generated from them, keyed by output path
+// relative to the output directory. Used to skip rewriting outputs whose source did not change since the last run.
+class ExportManifest
+{
+public:
+    static QString sidecarPath(const QString &outputPath);
+    static QByteArray hashFile(const QString &path);
+
+    bool load(const QString &path);
+    bool save(const QString &path) const;
+
+    bool isUpToDate(const QString &relativePath, const QByteArray &sourceHash, const QString &absolutePath) const;
+    void insert(const QString &relativePath, const QByteArray &sourceHash, const QByteArray &outputHash);
+    void keep(const QString &relativePath);
+
+private:
+    struct Entry
+    {
+        QByteArray sourceHash;
+        QByteArray outputHash;
+    };
+
+    QHash<QString, Entry> m_previousEntries;
+    QHash<QString, Entry> m_entries;
+};
@@ -0,0 +1,80 @@
+/*
+ * Copyright (C) 2018-2019 Michał Siejak
+ * This file is part of Quartz - a raytracing aspect for Qt3D.
+ * See LICENSE file for licensing information.
+ */
+
+#include "fileclone.h"
+
+#include <QFile>
+
+#if defined(Q_OS_LINUX)
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <linux/fs.h>
+#elif defined(Q_OS_MACOS)
+#include <unistd.h>
+#include <sys/clonefile.h>
+#elif defined(Q_OS_WIN)
+#include <windows.h>
+#endif
+
+static bool reflinkFile(const QString &sourcePath, const QString &targetPath)
+{
+#if defined(Q_OS_LINUX) && defined(FICLONE)
+    const int sourceFd = ::open(QFile::encodeName(sourcePath).constData(), O_RDONLY | O_CLOEXEC);
+    if(sourceFd < 0) {
+        return false;
+    }
+    const int targetFd = ::open(QFile::encodeName(targetPath).constData(), O_WRONLY | O_CREAT | O_EXCL | O_CLOEXEC, 0644);
+    if(targetFd < 0) {
+        ::close(sourceFd);
+        return false;
+    }
+    const bool result = ::ioctl(targetFd, FICLONE, sourceFd) == 0;
+    ::close(targetFd);
+    ::close(sourceFd);
+    if(!result) {
+        QFile::remove(targetPath);
+    }
+    return result;
+#elif defined(Q_OS_MACOS)
+    return ::clonefile(QFile::encodeName(sourcePath).constData(), QFile::encodeName(targetPath).constData(), 0) == 0;
+#else
+    Q_UNUSED(sourcePath);
+    Q_UNUSED(targetPath);
+    return false;
+#endif
+}
+
+static bool hardlinkFile(const QString &sourcePath, const QString &targetPath)
+{
+#if defined(Q_OS_UNIX)
+    return ::link(QFile::encodeName(sourcePath).constData(), QFile::encodeName(targetPath).constData()) == 0;
+#elif defined(Q_OS_WIN)
+    return CreateHardLinkW(reinterpret_cast<LPCWSTR>(targetPath.utf16()), reinterpret_cast<LPCWSTR>(sourcePath.utf16()), nullptr) != 0;
+#else
+    Q_UNUSED(sourcePath);
+    Q_UNUSED(targetPath);
+    return false;
+#endif
+}
+
+CloneMethod cloneFile(const QString &sourcePath, const QString &targetPath, bool allowLinks)
+{
+    if(!QFile::exists(sourcePath)) {
+        return CloneMethod::None;
+    }
+
+    QFile::remove(targetPath);
+    if(allowLinks) {
+        if(reflinkFile(sourcePath, targetPath)) {
+            return CloneMethod::Reflink;
+        }
+        if(hardlinkFile(sourcePath, targetPath)) {
+            return CloneMethod::Hardlink;
+        }
+    }
+    return QFile::copy(sourcePath, targetPath) ? CloneMethod::Copy : CloneMethod::None;
+}
@@ -0,0 +1,22 @@
+/*
+ * Copyright (C) 2018-2019 Michał Siejak
+ * This file is part of Quartz - a raytracing aspect for Qt3D.
+ * See LICENSE file for licensing information.
+ */
+
+#pragma once
+
+#include <QString>
+
+enum class CloneMethod
+{
+    None,
+    Reflink,
+    Hardlink,
+    Copy,
+};
+
+// Clones source file to target path using the cheapest method supported by the filesystem(s):
+// copy-on-write reflink, hard link, or (as a last resort, or if links are not allowed) a regular byte copy.
+// Existing target file is replaced.
+CloneMethod cloneFile(const QString &sourcePath, const QString &targetPath, bool allowLinks=true);
@@ -8,6 +8,13 @@
 
 #include <QDebug>
 #include <QFileInfo>
+#include <QHash>
+#include <QtConcurrent>
+
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <numeric>
 
 #include <assimp/DefaultLogger.hpp>
 
@@ -19,10 +26,121 @@ static constexpr unsigned int DefaultImportFlags =
         aiProcess_FindInvalidData |
         aiProcess_FindInstances;
 
+namespace Config {
+// Grid indices of quantized values must stay below this magnitude (2^62) to be representable as qint64.
+static constexpr double MaxQuantizedValue = 4611686018427387904.0;
+} // Config
+
+// Geometry values are compared either bit-exactly (epsilon == 0) or after quantization to a grid of epsilon spacing.
+static inline qint64 quantize(float value, float epsilon)
+{
+    quint32 bits;
+    std::memcpy(&bits, &value, sizeof(float));
+
+    if(epsilon > 0.0f) {
+        const double gridIndex = std::floor(double(value) / double(epsilon) + 0.5);
+        if(std::fabs(gridIndex) < Config::MaxQuantizedValue) {
+            return qint64(gridIndex);
+        }
+        // NaN, infinity or out of grid range: compare bit-exactly, mapped below any grid index so that the two never collide.
+        return std::numeric_limits<qint64>::min() + qint64(bits);
+    }
+    else {
+        return qint64(bits);
+    }
+}
+
+static inline void hashCombine(quint64 &seed, quint64 value)
+{
+    seed ^= value + 0x9e3779b97f4a7c15ull + (seed << 6) + (seed >> 2);
+}
+
+static void hashVectors(quint64 &seed, const aiVector3D *data, unsigned int count, int numComponents, float epsilon)
+{
+    for(unsigned int i=0; i<count; ++i) {
+        for(int c=0; c<numComponents; ++c) {
+            hashCombine(seed, quint64(quantize(data[i][c], epsilon)));
+        }
+    }
+}
+
+static bool compareVectors(const aiVector3D *a, const aiVector3D *b, unsigned int count, int numComponents, float epsilon)
+{
+    for(unsigned int i=0; i<count; ++i) {
+        for(int c=0; c<numComponents; ++c) {
+            if(quantize(a[i][c], epsilon) != quantize(b[i][c], epsilon)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+static quint64 hashMeshGeometry(const aiMesh *mesh, float epsilon)
+{
+    quint64 seed = 0;
+    hashCombine(seed, mesh->mNumVertices);
+    hashCombine(seed, mesh->mNumFaces);
+    hashCombine(seed, (mesh->HasNormals() ? 1 : 0) | (mesh->HasTextureCoords(0) ? 2 : 0) | (mesh->HasTangentsAndBitangents() ? 4 : 0));
+
+    hashVectors(seed, mesh->mVertices, mesh->mNumVertices, 3, epsilon);
+    if(mesh->HasNormals()) {
+        hashVectors(seed, mesh->mNormals, mesh->mNumVertices, 3, epsilon);
+    }
+    if(mesh->HasTextureCoords(0)) {
+        hashVectors(seed, mesh->mTextureCoords[0], mesh->mNumVertices, 2, epsilon);
+    }
+    if(mesh->HasTangentsAndBitangents()) {
+        hashVectors(seed, mesh->mTangents, mesh->mNumVertices, 3, epsilon);
+    }
+    for(unsigned int i=0; i<mesh->mNumFaces; ++i) {
+        const aiFace &f = mesh->mFaces[i];
+        hashCombine(seed, f.mNumIndices);
+        for(unsigned int j=0; j<f.mNumIndices; ++j) {
+            hashCombine(seed, f.mIndices[j]);
+        }
+    }
+    return seed;
+}
+
+static bool compareMeshGeometry(const aiMesh *a, const aiMesh *b, float epsilon)
+{
+    if(a->mNumVertices != b->mNumVertices || a->mNumFaces != b->mNumFaces) {
+        return false;
+    }
+    if(a->HasNormals() != b->HasNormals() || a->HasTextureCoords(0) != b->HasTextureCoords(0) || a->HasTangentsAndBitangents() != b->HasTangentsAndBitangents()) {
+        return false;
+    }
+
+    const unsigned int n = a->mNumVertices;
+    if(!compareVectors(a->mVertices, b->mVertices, n, 3, epsilon)) {
+        return false;
+    }
+    if(a->HasNormals() && !compareVectors(a->mNormals, b->mNormals, n, 3, epsilon)) {
+        return false;
+    }
+    if(a->HasTextureCoords(0) && !compareVectors(a->mTextureCoords[0], b->mTextureCoords[0], n, 2, epsilon)) {
+        return false;
+    }
+    if(a->HasTangentsAndBitangents() && !compareVectors(a->mTangents, b->mTangents, n, 3, epsilon)) {
+        return false;
+    }
+    for(unsigned int i=0; i<a->mNumFaces; ++i) {
+        const aiFace &fa = a->mFaces[i];
+        const aiFace &fb = b->mFaces[i];
+        if(fa.mNumIndices != fb.mNumIndices || std::memcmp(fa.mIndices, fb.mIndices, fa.mNumIndices * sizeof(unsigned int)) != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
 Importer::Importer()
     : m_importFlags(DefaultImportFlags)
 {
-    Assimp::DefaultLogger::create("", Assimp::Logger::NORMAL);
+    // The logger is global; create it only once since importers may be constructed concurrently in batch mode.
+    static const Assimp::Logger *logger = Assimp::DefaultLogger::create("", Assimp::Logger::NORMAL);
+    Q_UNUSED(logger);
 }
 
 void Importer::setImportFlag(unsigned int flag)
@@ -51,6 +169,66 @@ bool Importer::importScene(const QString &path)
     return true;
 }
 
+int Importer::deduplicateMeshes(float epsilon)
+{
+    if(!m_scene.root) {
+        return 0;
+    }
+
+    QVector<int> meshIndices;
+    for(int i=0; i<m_scene.meshes.size(); ++i) {
+        if(m_scene.meshes[i].refcount > 0) {
+            meshIndices.append(i);
+        }
+    }
+    const QVector<quint64> hashes = QtConcurrent::blockingMapped<QVector<quint64>>(meshIndices, [this, epsilon](int index) {
+        return hashMeshGeometry(m_scene.meshes[index].mesh, epsilon);
+    });
+
+    // First mesh (in scene order) with given geometry becomes the canonical one; hash collisions are resolved by full comparison.
+    QVector<int> canonicalMeshIndices(m_scene.meshes.size());
+    QHash<quint64, QVector<int>> canonicalMeshesByHash;
+    int numDuplicates = 0;
+    for(int i=0; i<meshIndices.size(); ++i) {
+        const int meshIndex = meshIndices[i];
+        canonicalMeshIndices[meshIndex] = meshIndex;
+
+        QVector<int> &candidates = canonicalMeshesByHash[hashes[i]];
+        for(int candidateIndex : candidates) {
+            if(compareMeshGeometry(m_scene.meshes[candidateIndex].mesh, m_scene.meshes[meshIndex].mesh, epsilon)) {
+                canonicalMeshIndices[meshIndex] = candidateIndex;
+                break;
+            }
+        }
+        if(canonicalMeshIndices[meshIndex] == meshIndex) {
+            candidates.append(meshIndex);
+        }
+        else {
+            ++numDuplicates;
+        }
+    }
+
+    if(numDuplicates > 0) {
+        remapMeshReferences(m_scene.root, canonicalMeshIndices);
+    }
+    return numDuplicates;
+}
+
+void Importer::remapMeshReferences(Entity *entity, const QVector<int> &canonicalMeshIndices)
+{
+    if(entity->meshComponentIndex >= 0) {
+        const int canonicalIndex = canonicalMeshIndices[entity->meshComponentIndex];
+        if(canonicalIndex != entity->meshComponentIndex) {
+            m_scene.meshes[entity->meshComponentIndex].refcount--;
+            m_scene.meshes[canonicalIndex].refcount++;
+            entity->meshComponentIndex = canonicalIndex;
+        }
+    }
+    for(Entity *childEntity : entity->children) {
+        remapMeshReferences(childEntity, canonicalMeshIndices);
+    }
+}
+
 Entity *Importer::processScene(const aiScene *scene)
 {
     for(unsigned int meshIndex=0; meshIndex < scene->mNumMeshes; ++meshIndex) {
@@ -72,6 +250,7 @@ Entity *Importer::processScene(const aiScene *scene)
         textureComponent.data = reinterpret_cast<const unsigned char*>(texture->pcData);
         m_scene.textures.append(textureComponent);
     }
+    deduplicateEmbeddedTextures();
 
     for(unsigned int materialIndex=0; materialIndex < scene->mNumMaterials; ++materialIndex) {
         const aiMaterial *material = scene->mMaterials[materialIndex];
@@ -113,6 +292,7 @@ Entity *Importer::processSceneNode(const aiNode *node)
     QScopedPointer<Entity> entity(new Entity);
     entity->name = QString::fromUtf8(node->mName.C_Str());
 
+    entity->transform.matrix = node->mTransformation;
     if(!node->mTransformation.IsIdentity()) {
         aiVector3D position, rotation, scaling;
         node->mTransformation.Decompose(scaling, rotation, position);
@@ -151,6 +331,44 @@ Entity *Importer::processSceneNode(const aiNode *node)
     return entity.take();
 }
 
+static int embeddedTextureSize(const TextureComponent &texture)
+{
+    return (texture.height == 0) ? int(texture.width) : int(texture.width * texture.height * sizeof(aiTexel));
+}
+
+void Importer::deduplicateEmbeddedTextures()
+{
+    const int numTextures = m_scene.textures.size();
+
+    QVector<int> textureIndices(numTextures);
+    std::iota(textureIndices.begin(), textureIndices.end(), 0);
+    const QVector<uint> hashes = QtConcurrent::blockingMapped<QVector<uint>>(textureIndices, [this](int index) {
+        const TextureComponent &texture = m_scene.textures[index];
+        return qHashBits(texture.data, size_t(embeddedTextureSize(texture)));
+    });
+
+    // Embedded textures with identical payloads are all referenced through the first one in scene order.
+    m_embeddedTextureIndices.resize(numTextures);
+    QHash<uint, QVector<int>> texturesByHash;
+    for(int i=0; i<numTextures; ++i) {
+        const TextureComponent &texture = m_scene.textures[i];
+        m_embeddedTextureIndices[i] = i;
+
+        QVector<int> &candidates = texturesByHash[hashes[i]];
+        for(int candidateIndex : candidates) {
+            const TextureComponent &candidate = m_scene.textures[candidateIndex];
+            if(candidate.width == texture.width && candidate.height == texture.height && candidate.format == texture.format
+                    && std::memcmp(candidate.data, texture.data, size_t(embeddedTextureSize(texture))) == 0) {
+                m_embeddedTextureIndices[i] = candidateIndex;
+                break;
+            }
+        }
+        if(m_embeddedTextureIndices[i] == i) {
+            candidates.append(i);
+        }
+    }
+}
+
 int Importer::processTextureReference(const aiMaterial *material, aiTextureType type)
 {
     if(material->GetTextureCount(type) == 0) {
@@ -161,10 +379,11 @@ int Importer::processTextureReference(const aiMaterial *material, aiTextureType
     material->GetTexture(type, 0, &path);
     if(path.data[0] == '*') {
         int textureIndex = QString::fromLocal8Bit(&path.data[1]).toInt();
-        if(textureIndex < 0 || textureIndex >= m_scene.textures.size()) {
+        if(textureIndex < 0 || textureIndex >= m_embeddedTextureIndices.size()) {
             qWarning() << "Warning: Found invalid embedded texture reference; ignoring.";
             return -1;
         }
+        textureIndex = m_embeddedTextureIndices[textureIndex];
         m_scene.textures[textureIndex].refcount++;
         return textureIndex;
     }
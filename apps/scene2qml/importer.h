@@ -23,6 +23,7 @@ public:
 
     void setImportFlag(unsigned int flag);
     bool importScene(const QString &path);
+    int deduplicateMeshes(float epsilon=0.0f);
 
     const Scene &scene() const
     {
@@ -33,11 +34,14 @@ private:
     Entity *processScene(const aiScene *scene);
     Entity *processSceneNode(const aiNode *node);
 
+    void deduplicateEmbeddedTextures();
     int processTextureReference(const aiMaterial *material, aiTextureType type);
     bool processMeshReference(unsigned int meshIndex, Entity *entity);
+    void remapMeshReferences(Entity *entity, const QVector<int> &canonicalMeshIndices);
 
     Scene m_scene;
     Assimp::Importer m_importer;
     QMap<QString, int> m_texturesByPath;
+    QVector<int> m_embeddedTextureIndices;
     unsigned int m_importFlags;
 };
@@ -7,9 +7,292 @@
 #include <QCoreApplication>
 #include <QCommandLineParser>
 #include <QTextStream>
+#include <QThreadPool>
+#include <QElapsedTimer>
+#include <QFileInfo>
+#include <QDir>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QAtomicInt>
+#include <QtConcurrent>
+#include <QDebug>
 
 #include "importer.h"
 #include "exporter.h"
+#include "exportmanifest.h"
+#include "textureregistry.h"
+
+#include <stb_image_write.h>
+
+namespace Config {
+// Default asset directories (relative to output directory) in batch mode.
+static constexpr const char *BatchMeshDirectory = "meshes";
+static constexpr const char *BatchTexturesDirectory = "textures";
+// Embedded texel arrays are encoded to PNG; favor encoding speed over file size.
+static constexpr int EmbeddedTextureCompressionLevel = 4;
+} // Config
+
+struct ConversionOptions
+{
+    QString prefix;
+    QString meshDirectory;
+    QString texturesDirectory;
+    unsigned int importFlags = 0;
+    bool dedup = false;
+    float dedupEpsilon = 0.0f;
+    bool srgb = false;
+    bool binaryScene = false;
+    int maxEntitiesPerChunk = 0;
+    bool binaryMeshes = false;
+    bool copyTextures = false;
+    bool force = false;
+    // Set in batch mode: meshes go to per-scene subdirectories and textures to a shared directory.
+    bool perSceneMeshDirectories = false;
+    TextureRegistry *textureRegistry = nullptr;
+};
+
+struct ConversionResult
+{
+    bool status = false;
+    bool qmlExported = false;
+    int numDuplicateMeshes = -1;
+    int numEntities = 0;
+    int numMeshes = 0;
+    int numTextures = 0;
+    int numUnchangedMeshes = 0;
+    int numUnchangedTextures = 0;
+    int numSharedTextures = 0;
+};
+
+static bool convertScene(const QString &sourcePath, const QString &targetPath, const ConversionOptions &options, ConversionResult &result)
+{
+    const QString sourceBasePath = QFileInfo(sourcePath).path();
+    const QString targetBaseName = QFileInfo(targetPath).baseName();
+
+    Importer importer;
+    if(options.importFlags != 0) {
+        importer.setImportFlag(options.importFlags);
+    }
+    if(!importer.importScene(sourcePath)) {
+        return false;
+    }
+    if(options.dedup) {
+        result.numDuplicateMeshes = importer.deduplicateMeshes(options.dedupEpsilon);
+    }
+
+    Exporter exporter(importer.scene());
+
+    if(!options.prefix.isEmpty()) {
+        exporter.setPrefix(options.prefix);
+    }
+    if(options.meshDirectory.isEmpty()) {
+        exporter.setMeshDirectory(QString("%1_meshes").arg(targetBaseName));
+    }
+    else if(options.perSceneMeshDirectories) {
+        exporter.setMeshDirectory(QString("%1/%2").arg(options.meshDirectory).arg(QFileInfo(targetPath).completeBaseName()));
+    }
+    else {
+        exporter.setMeshDirectory(options.meshDirectory);
+    }
+    if(options.texturesDirectory.isEmpty()) {
+        exporter.setTexturesDirectory(QString("%1_textures").arg(targetBaseName));
+    }
+    else {
+        exporter.setTexturesDirectory(options.texturesDirectory);
+    }
+    if(options.srgb) {
+        exporter.setColorspace(Colorspace::sRGB);
+    }
+    if(options.binaryScene) {
+        exporter.setBinarySceneEnabled(true);
+    }
+    if(options.maxEntitiesPerChunk > 0) {
+        exporter.setPartitioning(options.maxEntitiesPerChunk);
+    }
+    if(options.binaryMeshes) {
+        exporter.setMeshFormat(MeshFormat::Binary);
+    }
+    if(options.copyTextures) {
+        exporter.setTextureLinksEnabled(false);
+    }
+    exporter.setSourceDirectory(sourceBasePath);
+    exporter.setTextureRegistry(options.textureRegistry);
+
+    // Without previously recorded entries all files are rewritten, but the manifest is still updated.
+    const QString manifestPath = ExportManifest::sidecarPath(targetPath);
+    ExportManifest manifest;
+    if(!options.force) {
+        manifest.load(manifestPath);
+    }
+    exporter.setManifest(&manifest);
+
+    if(!exporter.exportQml(targetPath, QFileInfo(sourcePath).fileName())) {
+        return false;
+    }
+    result.qmlExported = true;
+
+    bool status = true;
+    status &= exporter.exportMeshes();
+    status &= exporter.exportTextures();
+    status &= manifest.save(manifestPath);
+
+    result.status = status;
+    result.numEntities = exporter.numExportedEntities();
+    result.numMeshes = exporter.numExportedMeshes();
+    result.numTextures = exporter.numExportedTextures();
+    result.numUnchangedMeshes = exporter.numUnchangedMeshes();
+    result.numUnchangedTextures = exporter.numUnchangedTextures();
+    result.numSharedTextures = exporter.numSharedTextures();
+    return status;
+}
+
+static void printConversionResult(QTextStream &out, const ConversionResult &result)
+{
+    if(result.numDuplicateMeshes >= 0) {
+        out << "  " << result.numDuplicateMeshes << " duplicate mesh(es) merged\n";
+    }
+    out << "  "
+        << result.numEntities << " entities, "
+        << result.numMeshes   << " mesh(es), "
+        << result.numTextures << " texture(s)";
+    if(result.numUnchangedMeshes > 0 || result.numUnchangedTextures > 0) {
+        out << " ("
+            << result.numUnchangedMeshes << " mesh(es), "
+            << result.numUnchangedTextures << " texture(s) unchanged)";
+    }
+    if(result.numSharedTextures > 0) {
+        out << " (" << result.numSharedTextures << " texture(s) shared)";
+    }
+    out << "\n";
+}
+
+static bool isWildcardPattern(const QString &path)
+{
+    return path.contains('*') || path.contains('?') || path.contains('[');
+}
+
+// Expands directories and wildcard patterns into lists of scene files supported by Assimp.
+static bool expandBatchInputs(const QStringList &args, QStringList &sourcePaths)
+{
+    Assimp::Importer importer;
+    auto isSupportedSceneFile = [&importer](const QFileInfo &fileInfo) {
+        const QString suffix = fileInfo.suffix();
+        return !suffix.isEmpty() && importer.IsExtensionSupported(QString(".%1").arg(suffix).toStdString());
+    };
+
+    for(const QString &arg : args) {
+        const QFileInfo argInfo(arg);
+        QFileInfoList entries;
+        if(argInfo.isDir()) {
+            entries = QDir(arg).entryInfoList(QDir::Files, QDir::Name);
+        }
+        else if(isWildcardPattern(argInfo.fileName())) {
+            entries = QDir(argInfo.path()).entryInfoList(QStringList() << argInfo.fileName(), QDir::Files, QDir::Name);
+        }
+        else if(argInfo.isFile()) {
+            sourcePaths.append(arg);
+            continue;
+        }
+        else {
+            qCritical() << "Error: Input file not found:" << arg;
+            return false;
+        }
+        for(const QFileInfo &entry : entries) {
+            if(isSupportedSceneFile(entry)) {
+                sourcePaths.append(entry.filePath());
+            }
+        }
+    }
+    return true;
+}
+
+static int runBatch(const QStringList &sourcePaths, const QString &outputDirectory, const ConversionOptions &options)
+{
+    struct BatchJob
+    {
+        QString sourcePath;
+        QString targetPath;
+        ConversionResult result;
+    };
+
+    QVector<BatchJob> jobs;
+    QHash<QString, QString> sourcesByTarget;
+    for(const QString &sourcePath : sourcePaths) {
+        const QString targetPath = QDir(outputDirectory).filePath(QString("%1.qml").arg(QFileInfo(sourcePath).completeBaseName()));
+        if(sourcesByTarget.contains(targetPath)) {
+            qCritical() << "Error: Input files" << sourcesByTarget.value(targetPath) << "and" << sourcePath << "map to the same output file:" << targetPath;
+            return 1;
+        }
+        sourcesByTarget.insert(targetPath, sourcePath);
+        jobs.append({sourcePath, targetPath, ConversionResult()});
+    }
+    if(jobs.isEmpty()) {
+        qCritical() << "Error: No supported input files found";
+        return 1;
+    }
+    if(!QDir().mkpath(outputDirectory)) {
+        qCritical() << "Error: Failed to create output directory:" << outputDirectory;
+        return 1;
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+
+    // Scenes are converted on the global thread pool; asset export within each scene runs on the same pool,
+    // so the total number of worker threads stays bounded by its maximum thread count.
+    QMutex outputMutex;
+    QAtomicInt numCompleted(0);
+    const int numJobs = jobs.size();
+    QtConcurrent::blockingMap(jobs, [&](BatchJob &job) {
+        convertScene(job.sourcePath, job.targetPath, options, job.result);
+
+        QString report;
+        QTextStream out(&report);
+        out << "[" << (numCompleted.fetchAndAddOrdered(1) + 1) << "/" << numJobs << "] "
+            << QFileInfo(job.targetPath).absoluteFilePath() << (job.result.status ? "\n" : " FAILED\n");
+        if(job.result.status) {
+            printConversionResult(out, job.result);
+        }
+        out.flush();
+
+        QMutexLocker lock(&outputMutex);
+        QTextStream(stdout) << report;
+    });
+
+    ConversionResult total;
+    total.numDuplicateMeshes = options.dedup ? 0 : -1;
+    QStringList failedSourcePaths;
+    for(const BatchJob &job : jobs) {
+        if(!job.result.status) {
+            failedSourcePaths.append(job.sourcePath);
+            continue;
+        }
+        if(options.dedup) {
+            total.numDuplicateMeshes += job.result.numDuplicateMeshes;
+        }
+        total.numEntities += job.result.numEntities;
+        total.numMeshes += job.result.numMeshes;
+        total.numTextures += job.result.numTextures;
+        total.numUnchangedMeshes += job.result.numUnchangedMeshes;
+        total.numUnchangedTextures += job.result.numUnchangedTextures;
+        total.numSharedTextures += job.result.numSharedTextures;
+    }
+
+    QTextStream out(stdout);
+    out << "\nConverted " << (numJobs - failedSourcePaths.size()) << " of " << numJobs << " scene(s) in "
+        << QString::number(timer.elapsed() / 1000.0, 'f', 2) << " s\n";
+    printConversionResult(out, total);
+    if(options.textureRegistry && options.textureRegistry->numConflicts() > 0) {
+        out << "  " << options.textureRegistry->numConflicts() << " texture(s) renamed to resolve file name conflicts between scenes\n";
+    }
+    if(!failedSourcePaths.isEmpty()) {
+        out << "Failed:\n";
+        for(const QString &sourcePath : failedSourcePaths) {
+            out << "  " << sourcePath << "\n";
+        }
+    }
+    return failedSourcePaths.isEmpty() ? 0 : 1;
+}
 
 int main(int argc, char* argv[])
 {
@@ -17,13 +300,18 @@ int main(int argc, char* argv[])
     QCoreApplication::setApplicationName("scene2qml");
     QCoreApplication::setApplicationVersion("1.0.3");
 
+    // Global encoder setting, read by exporters writing textures concurrently; set once before any export starts.
+    stbi_write_png_compression_level = Config::EmbeddedTextureCompressionLevel;
+
     QCommandLineParser parser;
     parser.setApplicationDescription("3D scene file to Quartz QML converter.");
     parser.addHelpOption();
     parser.addVersionOption();
-    parser.addPositionalArgument("source", "Source scene file path.");
-    parser.addPositionalArgument("output", "Output QML file path.");
+    parser.addPositionalArgument("source", "Source scene file path (in batch mode: one or more files, directories or wildcard patterns).");
+    parser.addPositionalArgument("output", "Output QML file path (omitted in batch mode).");
 
+    QCommandLineOption outputDirectoryOption(QStringList() << "o" << "output-dir", "Batch mode: convert all source scenes into QML files in given directory, sharing a common texture directory.", "path");
+    parser.addOption(outputDirectoryOption);
     QCommandLineOption prefixOption("p", "Prefix to be added to every asset source path.", "prefix");
     parser.addOption(prefixOption);
     QCommandLineOption meshDirectoryOption("m", "Custom mesh directory (relative to QML file location).", "path");
@@ -35,64 +323,113 @@ int main(int argc, char* argv[])
     parser.addOption(transformOption);
     QCommandLineOption srgbOption("srgb", "Assume color properties to be in sRGB colorspace.");
     parser.addOption(srgbOption);
+    QCommandLineOption binarySceneOption("binary-scene", "Export entity hierarchy to a binary scene file (.qscene) loaded by a SceneLoader node in the output QML file.");
+    parser.addOption(binarySceneOption);
+    QCommandLineOption partitionOption("partition", "Split entities into spatially partitioned QML files of at most given size, loaded from the output file by distance from its loadOrigin.", "max_entities");
+    parser.addOption(partitionOption);
+    QCommandLineOption dedupOption("dedup", "Export meshes with identical geometry only once.");
+    parser.addOption(dedupOption);
+    QCommandLineOption dedupEpsilonOption("dedup-epsilon", "Treat vertex attributes as equal if they quantize to the same multiple of epsilon (implies --dedup).", "epsilon");
+    parser.addOption(dedupEpsilonOption);
+    QCommandLineOption binaryMeshesOption("binary-meshes", "Export meshes in binary format (.qmesh) instead of Wavefront OBJ.");
+    parser.addOption(binaryMeshesOption);
+    QCommandLineOption forceOption("force", "Rewrite all mesh and texture files, even if unchanged since the previous conversion.");
+    parser.addOption(forceOption);
+    QCommandLineOption copyTexturesOption("copy-textures", "Always copy texture files instead of linking or cloning them.");
+    parser.addOption(copyTexturesOption);
+    QCommandLineOption jobsOption(QStringList() << "j" << "jobs", "Number of worker threads used to convert scenes and write asset files.", "count");
+    parser.addOption(jobsOption);
 
     parser.process(app);
 
+    const bool batchMode = parser.isSet(outputDirectoryOption);
     const QStringList args = parser.positionalArguments();
-    if(args.size() != 2) {
+    if((batchMode && args.isEmpty()) || (!batchMode && args.size() != 2)) {
         parser.showHelp(2);
     }
 
-    const QString sourcePath = args[0];
-    const QString targetPath = args[1];
-    const QString sourceBasePath = QFileInfo(sourcePath).path();
-    const QString targetBaseName = QFileInfo(targetPath).baseName();
-
-    QTextStream(stdout) << QFileInfo(targetPath).absoluteFilePath() << " ...\n";
+    if(parser.isSet(jobsOption)) {
+        bool ok;
+        const int numJobs = parser.value(jobsOption).toInt(&ok);
+        if(!ok || numJobs <= 0) {
+            qCritical() << "Error: Invalid number of jobs:" << parser.value(jobsOption);
+            return 1;
+        }
+        QThreadPool::globalInstance()->setMaxThreadCount(numJobs);
+    }
 
-    Importer importer;
+    ConversionOptions options;
+    options.prefix = parser.value(prefixOption);
+    options.meshDirectory = parser.value(meshDirectoryOption);
+    options.texturesDirectory = parser.value(textureDirectoryOption);
+    options.srgb = parser.isSet(srgbOption);
+    options.binaryScene = parser.isSet(binarySceneOption);
+    options.binaryMeshes = parser.isSet(binaryMeshesOption);
+    options.copyTextures = parser.isSet(copyTexturesOption);
+    options.force = parser.isSet(forceOption);
 
     if(parser.isSet(transformOption)) {
-        importer.setImportFlag(aiProcess_PreTransformVertices);
+        options.importFlags |= aiProcess_PreTransformVertices;
     }
-
-    if(!importer.importScene(sourcePath)) {
-        return 1;
+    if(options.binaryMeshes) {
+        // Binary meshes are loaded as-is at render time, so do the processing otherwise done by the mesh importer now.
+        // Assimp runs these steps in the same order as DefaultMeshImporter does, so generated normals are the same too.
+        options.importFlags |= aiProcess_Triangulate | aiProcess_GenNormals | aiProcess_CalcTangentSpace;
     }
 
-    Exporter exporter(importer.scene());
-
-    if(parser.isSet(prefixOption)) {
-        exporter.setPrefix(parser.value(prefixOption));
+    if(parser.isSet(dedupOption) || parser.isSet(dedupEpsilonOption)) {
+        options.dedup = true;
+        if(parser.isSet(dedupEpsilonOption)) {
+            bool ok;
+            options.dedupEpsilon = parser.value(dedupEpsilonOption).toFloat(&ok);
+            if(!ok || options.dedupEpsilon < 0.0f) {
+                qCritical() << "Error: Invalid mesh deduplication epsilon:" << parser.value(dedupEpsilonOption);
+                return 1;
+            }
+        }
     }
-    if(parser.isSet(meshDirectoryOption)) {
-        exporter.setMeshDirectory(parser.value(meshDirectoryOption));
-    }
-    else {
-        exporter.setMeshDirectory(QString("%1_meshes").arg(targetBaseName));
-    }
-    if(parser.isSet(textureDirectoryOption)) {
-        exporter.setTexturesDirectory(parser.value(textureDirectoryOption));
-    }
-    else {
-        exporter.setTexturesDirectory(QString("%1_textures").arg(targetBaseName));
+    if(options.binaryScene && parser.isSet(partitionOption)) {
+        qCritical() << "Error: Binary scene export and partitioning are mutually exclusive";
+        return 1;
     }
-    if(parser.isSet(srgbOption)) {
-        exporter.setColorspace(Colorspace::sRGB);
+    if(parser.isSet(partitionOption)) {
+        bool ok;
+        options.maxEntitiesPerChunk = parser.value(partitionOption).toInt(&ok);
+        if(!ok || options.maxEntitiesPerChunk <= 0) {
+            qCritical() << "Error: Invalid maximum number of entities per partition:" << parser.value(partitionOption);
+            return 1;
+        }
     }
 
-    if(!exporter.exportQml(targetPath, QFileInfo(sourcePath).fileName())) {
-        return 1;
+    if(batchMode) {
+        QStringList sourcePaths;
+        if(!expandBatchInputs(args, sourcePaths)) {
+            return 1;
+        }
+
+        TextureRegistry textureRegistry;
+        options.textureRegistry = &textureRegistry;
+        options.perSceneMeshDirectories = true;
+        if(options.meshDirectory.isEmpty()) {
+            options.meshDirectory = Config::BatchMeshDirectory;
+        }
+        if(options.texturesDirectory.isEmpty()) {
+            options.texturesDirectory = Config::BatchTexturesDirectory;
+        }
+        return runBatch(sourcePaths, parser.value(outputDirectoryOption), options);
     }
 
-    bool status = true;
-    status &= exporter.exportMeshes();
-    status &= exporter.exportTextures(sourceBasePath);
+    const QString sourcePath = args[0];
+    const QString targetPath = args[1];
+
+    QTextStream(stdout) << QFileInfo(targetPath).absoluteFilePath() << " ...\n";
 
-    QTextStream(stdout) << "  "
-                        << exporter.numExportedEntities() << " entities, "
-                        << exporter.numExportedMeshes()   << " mesh(es), "
-                        << exporter.numExportedTextures() << " texture(s)\n";
+    ConversionResult result;
+    if(!convertScene(sourcePath, targetPath, options, result) && !result.qmlExported) {
+        return 1;
+    }
 
-    return status ? 0 : 1;
+    QTextStream out(stdout);
+    printConversionResult(out, result);
+    return result.status ? 0 : 1;
 }
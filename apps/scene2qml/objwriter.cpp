@@ -0,0 +1,133 @@
+/*
+ * Copyright (C) 2018-2019 Michał Siejak
+ * This file is part of Quartz - a raytracing aspect for Qt3D.
+ * See LICENSE file for licensing information.
+ */
+
+#include "objwriter.h"
+
+#include <QIODevice>
+#include <charconv>
+#include <cstring>
+
+#include <assimp/mesh.h>
+
+namespace Config {
+static constexpr int BufferSize = 1 << 20;
+// Upper bound for a single formatted token: shortest round-trip float is at most 15 characters ("-1.2345678e-38").
+static constexpr int MaxTokenLength = 32;
+} // Config
+
+ObjWriter::ObjWriter(QIODevice *device)
+    : m_device(device)
+    , m_buffer(Config::BufferSize, Qt::Uninitialized)
+    , m_size(0)
+    , m_error(false)
+{
+    Q_ASSERT(m_device);
+}
+
+bool ObjWriter::writeMesh(const aiMesh *mesh)
+{
+    Q_ASSERT(mesh);
+    if(!mesh->HasPositions()) {
+        return false;
+    }
+
+    const bool hasNormals = mesh->HasNormals();
+    const bool hasUVs = mesh->HasTextureCoords(0);
+
+    writeVectors("v ", 2, &mesh->mVertices[0].x, mesh->mNumVertices, sizeof(aiVector3D) / sizeof(float), 3);
+    if(hasNormals) {
+        writeVectors("vn ", 3, &mesh->mNormals[0].x, mesh->mNumVertices, sizeof(aiVector3D) / sizeof(float), 3);
+    }
+    if(hasUVs) {
+        writeVectors("vt ", 3, &mesh->mTextureCoords[0][0].x, mesh->mNumVertices, sizeof(aiVector3D) / sizeof(float), 2);
+    }
+
+    Q_ASSERT(mesh->mFaces);
+    for(unsigned int i=0; i<mesh->mNumFaces && !m_error; ++i) {
+        const aiFace &f = mesh->mFaces[i];
+        put("f ", 2);
+        for(unsigned int j=0; j<f.mNumIndices; ++j) {
+            writeFaceIndex(f.mIndices[j] + 1, hasUVs, hasNormals);
+            put(j+1 < f.mNumIndices ? ' ' : '\n');
+        }
+    }
+
+    flush();
+    return !m_error;
+}
+
+void ObjWriter::writeVectors(const char *tag, int tagLength, const float *data, unsigned int count, int stride, int numComponents)
+{
+    for(unsigned int i=0; i<count && !m_error; ++i) {
+        const float *v = data + i * stride;
+        reserve(tagLength + numComponents * Config::MaxTokenLength);
+        put(tag, tagLength);
+        for(int c=0; c<numComponents; ++c) {
+            putFloat(v[c]);
+            put(c+1 < numComponents ? ' ' : '\n');
+        }
+    }
+}
+
+void ObjWriter::writeFaceIndex(unsigned int index, bool hasUVs, bool hasNormals)
+{
+    reserve(3 * Config::MaxTokenLength);
+    putIndex(index);
+    if(hasUVs) {
+        put('/');
+        putIndex(index);
+    }
+    if(hasNormals) {
+        put(hasUVs ? "/" : "//", hasUVs ? 1 : 2);
+        putIndex(index);
+    }
+}
+
+void ObjWriter::put(char c)
+{
+    reserve(1);
+    m_buffer.data()[m_size++] = c;
+}
+
+void ObjWriter::put(const char *str, int length)
+{
+    reserve(length);
+    std::memcpy(m_buffer.data() + m_size, str, length);
+    m_size += length;
+}
+
+void ObjWriter::putFloat(float value)
+{
+    reserve(Config::MaxTokenLength);
+    char *begin = m_buffer.data() + m_size;
+    const auto result = std::to_chars(begin, begin + Config::MaxTokenLength, value);
+    Q_ASSERT(result.ec == std::errc());
+    m_size += int(result.ptr - begin);
+}
+
+void ObjWriter::putIndex(unsigned int index)
+{
+    reserve(Config::MaxTokenLength);
+    char *begin = m_buffer.data() + m_size;
+    const auto result = std::to_chars(begin, begin + Config::MaxTokenLength, index);
+    Q_ASSERT(result.ec == std::errc());
+    m_size += int(result.ptr - begin);
+}
+
+void ObjWriter::reserve(int length)
+{
+    if(m_size + length > m_buffer.size()) {
+        flush();
+    }
+}
+
+void ObjWriter::flush()
+{
+    if(m_size > 0 && !m_error) {
+        m_error = m_device->write(m_buffer.constData(), m_size) != m_size;
+    }
+    m_size = 0;
+}
@@ -0,0 +1,38 @@
+/*
+ * Copyright (C) 2018-2019 Michał Siejak
+ * This file is part of Quartz - a raytracing aspect for Qt3D.
+ * See LICENSE file for licensing information.
+ */
+
+#pragma once
+
+#include <QByteArray>
+
+class QIODevice;
+struct aiMesh;
+
+// Writes Wavefront OBJ geometry using shortest round-trip float formatting,
+// i.e. parsing the output yields bit-exact values of the source data.
+class ObjWriter
+{
+public:
+    explicit ObjWriter(QIODevice *device);
+
+    bool writeMesh(const aiMesh *mesh);
+
+private:
+    void writeVectors(const char *tag, int tagLength, const float *data, unsigned int count, int stride, int numComponents);
+    void writeFaceIndex(unsigned int index, bool hasUVs, bool hasNormals);
+
+    void put(char c);
+    void put(const char *str, int length);
+    void putFloat(float value);
+    void putIndex(unsigned int index);
+    void reserve(int length);
+    void flush();
+
+    QIODevice *m_device;
+    QByteArray m_buffer;
+    int m_size;
+    bool m_error;
+};
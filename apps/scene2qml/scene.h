@@ -61,6 +61,7 @@ struct Transform
     Vector3D translation;
     Vector3D rotation;
     Vector3D scale = {1.0f, 1.0f, 1.0f};
+    aiMatrix4x4 matrix;
 
     bool isIdentity() const
     {
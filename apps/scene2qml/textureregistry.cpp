@@ -0,0 +1,41 @@
+/*
+ * Copyright (C) 2018-2019 Michał Siejak
+ * This file is part of Quartz - a raytracing aspect for Qt3D.
+ * See LICENSE file for licensing information.
+ */
+
+#include "textureregistry.h"
+
+#include <QDir>
+#include <QMutexLocker>
+
+TextureRegistry::Claim TextureRegistry::claim(const QString &targetPath, const QByteArray &sourceHash)
+{
+    const QString key = QDir::cleanPath(targetPath);
+
+    QMutexLocker lock(&m_mutex);
+    auto it = m_sourceHashes.find(key);
+    if(it == m_sourceHashes.end()) {
+        m_sourceHashes.insert(key, sourceHash);
+        return Claim::Owner;
+    }
+    // Unreadable sources have empty hashes and never match anything.
+    if(!sourceHash.isEmpty() && it.value() == sourceHash) {
+        ++m_numDuplicates;
+        return Claim::Duplicate;
+    }
+    ++m_numConflicts;
+    return Claim::Conflict;
+}
+
+int TextureRegistry::numDuplicates() const
+{
+    QMutexLocker lock(&m_mutex);
+    return m_numDuplicates;
+}
+
+int TextureRegistry::numConflicts() const
+{
+    QMutexLocker lock(&m_mutex);
+    return m_numConflicts;
+}
@@ -0,0 +1,36 @@
+/*
+ * Copyright (C) 2018-2019 Michał Siejak
+ * This file is part of Quartz - a raytracing aspect for Qt3D.
+ * See LICENSE file for licensing information.
+ */
+
+#pragma once
+
+#include <QByteArray>
+#include <QHash>
+#include <QMutex>
+#include <QString>
+
+// Tracks texture files written to a texture directory shared by several concurrently converted scenes,
+// so that each distinct texture is written only once.
+class TextureRegistry
+{
+public:
+    enum class Claim
+    {
+        Owner,      // Caller is responsible for writing the file.
+        Duplicate,  // File with the same source contents is written by another scene.
+        Conflict,   // File with different source contents is written by another scene.
+    };
+
+    Claim claim(const QString &targetPath, const QByteArray &sourceHash);
+
+    int numDuplicates() const;
+    int numConflicts() const;
+
+private:
+    mutable QMutex m_mutex;
+    QHash<QString, QByteArray> m_sourceHashes;
+    int m_numDuplicates = 0;
+    int m_numConflicts = 0;
+};
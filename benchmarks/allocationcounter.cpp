@@ -0,0 +1,116 @@
+/*
+ * Copyright (C) 2018-2019 Michał Siejak
+ * This file is part of Quartz - a raytracing aspect for Qt3D.
+ * See LICENSE file for licensing information.
+ */
+
+#include <allocationcounter.h>
+
+#include <atomic>
+#include <cstddef>
+#include <new>
+
+namespace {
+
+std::atomic<quint64> g_numAllocations{0};
+std::atomic<quint64> g_numBytes{0};
+
+inline void countAllocation(std::size_t size)
+{
+    g_numAllocations.fetch_add(1, std::memory_order_relaxed);
+    g_numBytes.fetch_add(size, std::memory_order_relaxed);
+}
+
+} // anonymous
+
+namespace AllocationCounter {
+
+Counters counters()
+{
+    Counters result;
+    result.numAllocations = g_numAllocations.load(std::memory_order_relaxed);
+    result.numBytes = g_numBytes.load(std::memory_order_relaxed);
+    return result;
+}
+
+} // AllocationCounter
+
+#if defined(__GLIBC__)
+
+// Qt containers allocate with malloc rather than operator new, hence counting is done one level lower.
+// Default operator new is implemented on top of malloc, so it is counted as well.
+extern "C" {
+
+void *__libc_malloc(std::size_t size);
+void *__libc_calloc(std::size_t count, std::size_t size);
+void *__libc_realloc(void *ptr, std::size_t size);
+
+void *malloc(std::size_t size) noexcept
+{
+    countAllocation(size);
+    return __libc_malloc(size);
+}
+
+void *calloc(std::size_t count, std::size_t size) noexcept
+{
+    countAllocation(count * size);
+    return __libc_calloc(count, size);
+}
+
+void *realloc(void *ptr, std::size_t size) noexcept
+{
+    countAllocation(size);
+    return __libc_realloc(ptr, size);
+}
+
+} // extern "C"
+
+bool AllocationCounter::countsMalloc()
+{
+    return true;
+}
+
+#else
+
+#include <cstdlib>
+
+void *operator new(std::size_t size)
+{
+    countAllocation(size);
+    if(void *ptr = std::malloc(size > 0 ? size : 1)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void *operator new[](std::size_t size)
+{
+    return operator new(size);
+}
+
+void operator delete(void *ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete[](void *ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void *ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete[](void *ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+
+bool AllocationCounter::countsMalloc()
+{
+    return false;
+}
+
+#endif
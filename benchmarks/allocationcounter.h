@@ -0,0 +1,26 @@
+/*
+ * Copyright (C) 2018-2019 Michał Siejak
+ * This file is part of Quartz - a raytracing aspect for Qt3D.
+ * See LICENSE file for licensing information.
+ */
+
+#pragma once
+
+#include <QtGlobal>
+
+// Process-wide heap allocation counters. Linking allocationcounter.cpp into an executable replaces
+// malloc family functions (glibc) or global operator new (elsewhere) with counting versions.
+namespace AllocationCounter {
+
+struct Counters
+{
+    quint64 numAllocations = 0;
+    quint64 numBytes = 0;
+};
+
+Counters counters();
+
+// Whether allocations made with malloc directly (e.g. by Qt containers) are counted as well.
+bool countsMalloc();
+
+} // AllocationCounter
@@ -0,0 +1,63 @@
+/*
+ * Copyright (C) 2018-2019 Michał Siejak
+ * This file is part of Quartz - a raytracing aspect for Qt3D.
+ * See LICENSE file for licensing information.
+ */
+
+#include <benchdata.h>
+
+#include <QDir>
+
+namespace BenchmarkData {
+
+QByteArray generateImage8(int size, int channels)
+{
+    QByteArray pixels(size * size * channels, Qt::Uninitialized);
+    quint32 state = Config::RandomSeed;
+    for(int y=0; y<size; ++y) {
+        for(int x=0; x<size; ++x) {
+            for(int c=0; c<channels; ++c) {
+                // Smooth gradient with a little noise so that compressed sizes are realistic.
+                state = state * 1664525u + 1013904223u;
+                const int gradient = ((x + y * (c + 1)) * 255) / (size * (c + 2));
+                const int noise = int(state >> 28) - 8;
+                pixels[(y * size + x) * channels + c] = char(qBound(0, gradient + noise, 255));
+            }
+        }
+    }
+    return pixels;
+}
+
+QVector<float> generateImage32f(int size, int channels)
+{
+    QVector<float> pixels(size * size * channels);
+    quint32 state = Config::RandomSeed;
+    for(int y=0; y<size; ++y) {
+        for(int x=0; x<size; ++x) {
+            for(int c=0; c<channels; ++c) {
+                state = state * 1664525u + 1013904223u;
+                const float gradient = 4.0f * float(x + y * (c + 1)) / float(size * (c + 2));
+                const float noise = float(state >> 8) / float(1 << 24);
+                pixels[(y * size + x) * channels + c] = gradient * (0.9f + 0.2f * noise);
+            }
+        }
+    }
+    return pixels;
+}
+
+QString meshFileName(int gridSize, const char *extension)
+{
+    return QStringLiteral("grid_%1.%2").arg(gridSize).arg(QLatin1String(extension));
+}
+
+QString imageFileName(int imageSize, const char *extension)
+{
+    return QStringLiteral("noise_%1.%2").arg(imageSize).arg(QLatin1String(extension));
+}
+
+QString dataPath(const QString &fileName)
+{
+    return QDir(QStringLiteral(QUARTZ_BENCHMARK_DATA_DIR)).filePath(fileName);
+}
+
+} // BenchmarkData
@@ -0,0 +1,32 @@
+/*
+ * Copyright (C) 2018-2019 Michał Siejak
+ * This file is part of Quartz - a raytracing aspect for Qt3D.
+ * See LICENSE file for licensing information.
+ */
+
+#pragma once
+
+#include <QByteArray>
+#include <QString>
+#include <QVector>
+
+// Deterministic inputs shared by the benchmark data generator and the benchmarks.
+namespace BenchmarkData {
+
+namespace Config {
+static constexpr quint32 RandomSeed = 0x9e3779b9u;
+static constexpr int MeshGridSizes[] = { 64, 256 };
+static constexpr int ImageSizes[] = { 512, 2048 };
+static constexpr int JpegQuality = 90;
+} // Config
+
+QByteArray generateImage8(int size, int channels);
+QVector<float> generateImage32f(int size, int channels);
+
+QString meshFileName(int gridSize, const char *extension);
+QString imageFileName(int imageSize, const char *extension);
+
+// Absolute path of a file generated at build time.
+QString dataPath(const QString &fileName);
+
+} // BenchmarkData
@@ -0,0 +1,189 @@
+/*
+ * Copyright (C) 2018-2019 Michał Siejak
+ * This file is part of Quartz - a raytracing aspect for Qt3D.
+ * See LICENSE file for licensing information.
+ */
+
+// Generates deterministic benchmark inputs: grid meshes (OBJ, PLY) and noise images (PNG, JPEG, HDR).
+
+#include <benchdata.h>
+
+#include <QByteArray>
+#include <QDir>
+#include <QFile>
+#include <QTextStream>
+#include <QVector>
+#include <QtEndian>
+
+#include <cmath>
+#include <stb_image_write.h>
+
+namespace {
+
+struct Vertex
+{
+    float position[3];
+    float normal[3];
+    float texcoord[2];
+};
+
+// Wavy height field with (size+1)^2 vertices and 2*size^2 triangles.
+void generateGrid(int size, QVector<Vertex> &vertices, QVector<quint32> &indices)
+{
+    const int numVertsPerSide = size + 1;
+    vertices.resize(numVertsPerSide * numVertsPerSide);
+    for(int y=0; y<numVertsPerSide; ++y) {
+        for(int x=0; x<numVertsPerSide; ++x) {
+            const float u = float(x) / size;
+            const float v = float(y) / size;
+            const float phaseU = 8.0f * float(M_PI) * u;
+            const float phaseV = 8.0f * float(M_PI) * v;
+            const float height = 0.05f * std::sin(phaseU) * std::cos(phaseV);
+            const float dhdu = 0.05f * 8.0f * float(M_PI) * std::cos(phaseU) * std::cos(phaseV);
+            const float dhdv = -0.05f * 8.0f * float(M_PI) * std::sin(phaseU) * std::sin(phaseV);
+            const float normalLength = std::sqrt(dhdu*dhdu + 1.0f + dhdv*dhdv);
+
+            Vertex &vertex = vertices[y * numVertsPerSide + x];
+            vertex = { {u - 0.5f, height, v - 0.5f}, {-dhdu / normalLength, 1.0f / normalLength, -dhdv / normalLength}, {u, v} };
+        }
+    }
+
+    indices.clear();
+    indices.reserve(6 * size * size);
+    for(int y=0; y<size; ++y) {
+        for(int x=0; x<size; ++x) {
+            const quint32 i0 = quint32(y * numVertsPerSide + x);
+            const quint32 i1 = i0 + 1;
+            const quint32 i2 = i0 + quint32(numVertsPerSide);
+            const quint32 i3 = i2 + 1;
+            indices << i0 << i2 << i1 << i1 << i2 << i3;
+        }
+    }
+}
+
+bool writeObj(const QString &path, const QVector<Vertex> &vertices, const QVector<quint32> &indices)
+{
+    QFile file(path);
+    if(!file.open(QFile::WriteOnly | QFile::Truncate)) {
+        return false;
+    }
+
+    QTextStream out(&file);
+    out.setRealNumberPrecision(6);
+    for(const Vertex &v : vertices) {
+        out << "v " << v.position[0] << ' ' << v.position[1] << ' ' << v.position[2] << '\n';
+    }
+    for(const Vertex &v : vertices) {
+        out << "vt " << v.texcoord[0] << ' ' << v.texcoord[1] << '\n';
+    }
+    for(const Vertex &v : vertices) {
+        out << "vn " << v.normal[0] << ' ' << v.normal[1] << ' ' << v.normal[2] << '\n';
+    }
+    for(int i=0; i<indices.size(); i+=3) {
+        out << 'f';
+        for(int j=0; j<3; ++j) {
+            const quint32 index = indices[i + j] + 1;
+            out << ' ' << index << '/' << index << '/' << index;
+        }
+        out << '\n';
+    }
+    out.flush();
+    return out.status() == QTextStream::Ok;
+}
+
+template<typename T>
+void appendLittleEndian(QByteArray &data, T value)
+{
+    char bytes[sizeof(T)];
+    qToLittleEndian(value, bytes);
+    data.append(bytes, int(sizeof(T)));
+}
+
+bool writePly(const QString &path, const QVector<Vertex> &vertices, const QVector<quint32> &indices)
+{
+    QFile file(path);
+    if(!file.open(QFile::WriteOnly | QFile::Truncate)) {
+        return false;
+    }
+
+    QByteArray data;
+    data.append("ply\nformat binary_little_endian 1.0\n");
+    data.append("element vertex " + QByteArray::number(vertices.size()) + '\n');
+    data.append("property float x\nproperty float y\nproperty float z\n");
+    data.append("property float nx\nproperty float ny\nproperty float nz\n");
+    data.append("property float s\nproperty float t\n");
+    data.append("element face " + QByteArray::number(indices.size() / 3) + '\n');
+    data.append("property list uchar int vertex_indices\nend_header\n");
+
+    for(const Vertex &v : vertices) {
+        for(float value : v.position) { appendLittleEndian(data, value); }
+        for(float value : v.normal)   { appendLittleEndian(data, value); }
+        for(float value : v.texcoord) { appendLittleEndian(data, value); }
+    }
+    for(int i=0; i<indices.size(); i+=3) {
+        data.append(char(3));
+        for(int j=0; j<3; ++j) {
+            appendLittleEndian(data, qint32(indices[i + j]));
+        }
+    }
+    return file.write(data) == data.size();
+}
+
+void appendToByteArray(void *context, void *data, int size)
+{
+    static_cast<QByteArray*>(context)->append(static_cast<const char*>(data), size);
+}
+
+bool writeFile(const QString &path, const QByteArray &data)
+{
+    QFile file(path);
+    return file.open(QFile::WriteOnly | QFile::Truncate) && file.write(data) == data.size();
+}
+
+} // anonymous
+
+int main(int argc, char **argv)
+{
+    if(argc != 2) {
+        QTextStream(stderr) << "Usage: " << argv[0] << " <output directory>\n";
+        return 1;
+    }
+
+    const QDir outputDir(QString::fromLocal8Bit(argv[1]));
+    if(!QDir().mkpath(outputDir.absolutePath())) {
+        QTextStream(stderr) << "Cannot create output directory: " << outputDir.absolutePath() << '\n';
+        return 1;
+    }
+
+    using namespace BenchmarkData;
+
+    for(int gridSize : Config::MeshGridSizes) {
+        QVector<Vertex> vertices;
+        QVector<quint32> indices;
+        generateGrid(gridSize, vertices, indices);
+        if(!writeObj(outputDir.filePath(meshFileName(gridSize, "obj")), vertices, indices)
+                || !writePly(outputDir.filePath(meshFileName(gridSize, "ply")), vertices, indices)) {
+            QTextStream(stderr) << "Failed to write benchmark meshes\n";
+            return 1;
+        }
+    }
+
+    for(int imageSize : Config::ImageSizes) {
+        const QByteArray pixels = generateImage8(imageSize, 3);
+        const QVector<float> radiance = generateImage32f(imageSize, 3);
+
+        QByteArray png, jpg, hdr;
+        bool result = stbi_write_png_to_func(appendToByteArray, &png, imageSize, imageSize, 3, pixels.constData(), imageSize * 3)
+                && stbi_write_jpg_to_func(appendToByteArray, &jpg, imageSize, imageSize, 3, pixels.constData(), Config::JpegQuality)
+                && stbi_write_hdr_to_func(appendToByteArray, &hdr, imageSize, imageSize, 3, radiance.constData());
+        result = result
+                && writeFile(outputDir.filePath(imageFileName(imageSize, "png")), png)
+                && writeFile(outputDir.filePath(imageFileName(imageSize, "jpg")), jpg)
+                && writeFile(outputDir.filePath(imageFileName(imageSize, "hdr")), hdr);
+        if(!result) {
+            QTextStream(stderr) << "Failed to write benchmark images\n";
+            return 1;
+        }
+    }
+    return 0;
+}
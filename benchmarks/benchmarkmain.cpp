@@ -0,0 +1,25 @@
+/*
+ * Copyright (C) 2018-2019 Michał Siejak
+ * This file is part of Quartz - a raytracing aspect for Qt3D.
+ * See LICENSE file for licensing information.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <QCoreApplication>
+#include <QLoggingCategory>
+
+int main(int argc, char **argv)
+{
+    // Importers log every asset they load which would otherwise dominate benchmark output.
+    QLoggingCategory::setFilterRules(QStringLiteral("raytrace.import.info=false"));
+
+    QCoreApplication app(argc, argv);
+
+    benchmark::Initialize(&argc, argv);
+    if(benchmark::ReportUnrecognizedArguments(argc, argv)) {
+        return 1;
+    }
+    benchmark::RunSpecifiedBenchmarks();
+    return 0;
+}
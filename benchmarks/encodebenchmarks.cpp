@@ -0,0 +1,101 @@
+/*
+ * Copyright (C) 2018-2019 Michał Siejak
+ * This file is part of Quartz - a raytracing aspect for Qt3D.
+ * See LICENSE file for licensing information.
+ */
+
+#include <benchdata.h>
+
+#include <imagewriter.h>
+
+#include <benchmark/benchmark.h>
+
+#include <cstring>
+
+using namespace Qt3DRaytrace;
+using namespace BenchmarkData;
+
+namespace {
+
+QImageData makeImage8(int size)
+{
+    QImageData image;
+    image.width = size;
+    image.height = size;
+    image.channels = 3;
+    image.type = QImageData::ValueType::UInt8;
+    image.format = QImageData::Format::RGB;
+    image.data = generateImage8(size, image.channels);
+    return image;
+}
+
+QImageData makeImage32f(int size)
+{
+    const QVector<float> pixels = generateImage32f(size, 3);
+
+    QImageData image;
+    image.width = size;
+    image.height = size;
+    image.channels = 3;
+    image.type = QImageData::ValueType::Float32;
+    image.format = QImageData::Format::RGB;
+    image.data.resize(pixels.size() * int(sizeof(float)));
+    std::memcpy(image.data.data(), pixels.constData(), size_t(image.data.size()));
+    return image;
+}
+
+void benchmarkEncode(benchmark::State &state, const QImageData &image, const QString &format, int numSamples = 0)
+{
+    QByteArray output;
+    for(auto _ : state) {
+        if(!ImageWriter::encode(image, format, Config::JpegQuality, numSamples, output)) {
+            state.SkipWithError("Encoding failed");
+            break;
+        }
+        benchmark::DoNotOptimize(output.constData());
+    }
+    state.SetBytesProcessed(state.iterations() * image.data.size());
+    state.counters["output_bytes"] = double(output.size());
+}
+
+void BM_EncodeImage_PNG(benchmark::State &state)
+{
+    benchmarkEncode(state, makeImage8(int(state.range(0))), QStringLiteral("png"));
+}
+
+void BM_EncodeImage_JPG(benchmark::State &state)
+{
+    benchmarkEncode(state, makeImage8(int(state.range(0))), QStringLiteral("jpg"));
+}
+
+void BM_EncodeImage_BMP(benchmark::State &state)
+{
+    benchmarkEncode(state, makeImage8(int(state.range(0))), QStringLiteral("bmp"));
+}
+
+void BM_EncodeImage_TGA(benchmark::State &state)
+{
+    benchmarkEncode(state, makeImage8(int(state.range(0))), QStringLiteral("tga"));
+}
+
+void BM_EncodeImage_HDR(benchmark::State &state)
+{
+    // Non-zero sample count also exercises the header rewrite used by quartz-merge.
+    benchmarkEncode(state, makeImage32f(int(state.range(0))), QStringLiteral("hdr"), 1024);
+}
+
+void imageSizes(benchmark::internal::Benchmark *benchmark)
+{
+    for(int imageSize : Config::ImageSizes) {
+        benchmark->Arg(imageSize);
+    }
+    benchmark->Unit(benchmark::kMillisecond);
+}
+
+} // anonymous
+
+BENCHMARK(BM_EncodeImage_PNG)->Apply(imageSizes);
+BENCHMARK(BM_EncodeImage_JPG)->Apply(imageSizes);
+BENCHMARK(BM_EncodeImage_BMP)->Apply(imageSizes);
+BENCHMARK(BM_EncodeImage_TGA)->Apply(imageSizes);
+BENCHMARK(BM_EncodeImage_HDR)->Apply(imageSizes);
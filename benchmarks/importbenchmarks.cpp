@@ -0,0 +1,104 @@
+/*
+ * Copyright (C) 2018-2019 Michał Siejak
+ * This file is part of Quartz - a raytracing aspect for Qt3D.
+ * See LICENSE file for licensing information.
+ */
+
+#include <benchdata.h>
+
+#include <io/defaultmeshimporter_p.h>
+#include <io/defaultimageimporter_p.h>
+#include <io/importstatistics_p.h>
+
+#include <benchmark/benchmark.h>
+
+#include <QFileInfo>
+#include <QUrl>
+
+namespace Qt3DRaytrace {
+// Normally defined by the aspect; importers are linked into benchmarks without it.
+Q_LOGGING_CATEGORY(logImport, "raytrace.import")
+} // Qt3DRaytrace
+
+using namespace Qt3DRaytrace;
+using namespace BenchmarkData;
+
+namespace {
+
+template<typename Importer, typename Data>
+void benchmarkImport(benchmark::State &state, const QString &fileName)
+{
+    const QString path = dataPath(fileName);
+    const QUrl url = QUrl::fromLocalFile(path);
+    if(!QFileInfo::exists(path)) {
+        state.SkipWithError("Benchmark input file not found; build the quartz-benchdata target first");
+        return;
+    }
+
+    // Records would otherwise accumulate across iterations, and recycling them is not part of what is being measured.
+    Raytrace::ImportStatistics *statistics = Raytrace::ImportStatistics::instance();
+    const bool statisticsEnabled = statistics->isEnabled();
+    statistics->setEnabled(false);
+
+    Importer importer;
+    for(auto _ : state) {
+        Data data;
+        if(!importer.import(url, data)) {
+            state.SkipWithError("Import failed");
+            break;
+        }
+        benchmark::DoNotOptimize(data);
+    }
+    state.SetBytesProcessed(state.iterations() * QFileInfo(path).size());
+
+    statistics->setEnabled(statisticsEnabled);
+}
+
+void BM_ImportMesh_OBJ(benchmark::State &state)
+{
+    benchmarkImport<Raytrace::DefaultMeshImporter, QGeometryData>(state, meshFileName(int(state.range(0)), "obj"));
+}
+
+void BM_ImportMesh_PLY(benchmark::State &state)
+{
+    benchmarkImport<Raytrace::DefaultMeshImporter, QGeometryData>(state, meshFileName(int(state.range(0)), "ply"));
+}
+
+void BM_ImportImage_PNG(benchmark::State &state)
+{
+    benchmarkImport<Raytrace::DefaultImageImporter, QImageData>(state, imageFileName(int(state.range(0)), "png"));
+}
+
+void BM_ImportImage_JPG(benchmark::State &state)
+{
+    benchmarkImport<Raytrace::DefaultImageImporter, QImageData>(state, imageFileName(int(state.range(0)), "jpg"));
+}
+
+void BM_ImportImage_HDR(benchmark::State &state)
+{
+    benchmarkImport<Raytrace::DefaultImageImporter, QImageData>(state, imageFileName(int(state.range(0)), "hdr"));
+}
+
+void meshSizes(benchmark::internal::Benchmark *benchmark)
+{
+    for(int gridSize : Config::MeshGridSizes) {
+        benchmark->Arg(gridSize);
+    }
+    benchmark->Unit(benchmark::kMillisecond);
+}
+
+void imageSizes(benchmark::internal::Benchmark *benchmark)
+{
+    for(int imageSize : Config::ImageSizes) {
+        benchmark->Arg(imageSize);
+    }
+    benchmark->Unit(benchmark::kMillisecond);
+}
+
+} // anonymous
+
+BENCHMARK(BM_ImportMesh_OBJ)->Apply(meshSizes);
+BENCHMARK(BM_ImportMesh_PLY)->Apply(meshSizes);
+BENCHMARK(BM_ImportImage_PNG)->Apply(imageSizes);
+BENCHMARK(BM_ImportImage_JPG)->Apply(imageSizes);
+BENCHMARK(BM_ImportImage_HDR)->Apply(imageSizes);
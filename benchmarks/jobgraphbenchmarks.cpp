@@ -0,0 +1,261 @@
+/*
+ * Copyright (C) 2018-2019 Michał Siejak
+ * This file is part of Quartz - a raytracing aspect for Qt3D.
+ * See LICENSE file for licensing information.
+ */
+
+#include <stubaspect.h>
+#include <allocationcounter.h>
+
+#include <backend/managers_p.h>
+#include <frontend/qgeometryrenderer_p.h>
+#include <frontend/qmaterial_p.h>
+#include <replay/scenechangelog_p.h>
+
+#include <Qt3DRaytrace/qgeometrydata.h>
+#include <Qt3DRaytrace/qgeometryrenderer.h>
+#include <Qt3DRaytrace/qmaterial.h>
+
+#include <Qt3DCore/QNodeCreatedChange>
+#include <Qt3DCore/QPropertyUpdatedChange>
+#include <Qt3DCore/QTransform>
+#include <Qt3DCore/private/qbackendnode_p.h>
+#include <Qt3DCore/private/qentity_p.h>
+#include <Qt3DCore/private/qtransform_p.h>
+
+#include <benchmark/benchmark.h>
+
+#include <QElapsedTimer>
+#include <QtMath>
+
+#include <memory>
+
+using namespace Qt3DCore;
+using namespace Qt3DRaytrace;
+
+using Raytrace::SceneChangeLog::NodeType;
+
+namespace {
+
+namespace Config {
+static constexpr int EntityCounts[] = { 1000, 10000, 100000, 1000000 };
+static constexpr int AnimatedPermille[] = { 10, 100, 1000 };
+static constexpr int EntitiesPerGroup = 1000;
+static constexpr int NumMeshes = 16;
+static constexpr int NumMaterials = 64;
+static constexpr int NumEmissiveMaterials = 1;
+static constexpr qint64 FrameInterval = 16666667; // ns
+} // Config
+
+// Backend scene of N renderable entities driven through QRaytraceAspect and a stub renderer.
+class BenchmarkScene
+{
+public:
+    explicit BenchmarkScene(int numEntities)
+        : m_numEntities(numEntities)
+    {
+        createScene();
+        renderer()->setSceneRoot(m_aspect.nodeManagers()->entityManager.lookupResource(m_rootEntityId));
+
+        // Initial frame processes all newly created nodes; benchmarks measure steady state from here.
+        runFrame();
+    }
+
+    int numEntities() const { return m_numEntities; }
+    Benchmark::StubRenderer *renderer() const { return m_aspect.renderer(); }
+
+    // Delivers translation updates to a window of entity transforms, as synced from an animated frontend scene.
+    void animate(int numAnimated)
+    {
+        const float phase = qDegreesToRadians(float(m_frameNumber % 360));
+        for(int index=0; index<numAnimated; ++index) {
+            const int entityIndex = (m_animationCursor + index) % m_transforms.size();
+            const QVector3D translation(float(entityIndex % Config::EntitiesPerGroup), qSin(phase + float(entityIndex)), 0.0f);
+
+            QBackendNode *transform = m_transforms[entityIndex];
+            auto change = QPropertyUpdatedChangePtr::create(transform->peerId());
+            change->setPropertyName("translation");
+            change->setValue(QVariant::fromValue(translation));
+            QBackendNodePrivate::get(transform)->sceneChangeEvent(change);
+        }
+        m_animationCursor = (m_animationCursor + numAnimated) % m_transforms.size();
+    }
+
+    void runFrame()
+    {
+        m_aspect.runFrame(m_frameNumber * Config::FrameInterval);
+        ++m_frameNumber;
+    }
+
+private:
+    template<typename T>
+    QNodeId createNode(NodeType type, const T &data)
+    {
+        const QNodeId id = QNodeId::createId();
+        auto node = Raytrace::SceneChangeLog::createProxyNode(type, id);
+        auto change = QNodeCreatedChangePtr<T>::create(node.get());
+        change->data = data;
+        m_aspect.aspectPrivate()->createBackendNode(change);
+        return id;
+    }
+
+    QNodeId createTransform(const QVector3D &translation)
+    {
+        QTransformData data;
+        data.rotation = QQuaternion();
+        data.scale = QVector3D(1.0f, 1.0f, 1.0f);
+        data.translation = translation;
+        const QNodeId id = createNode(NodeType::Transform, data);
+        m_transforms.append(m_aspect.nodeManagers()->transformManager.lookupResource(id));
+        return id;
+    }
+
+    QNodeId createEntity(QNodeId parentId, const QVector<QNodeIdTypePair> &components)
+    {
+        QEntityData data;
+        data.parentEntityId = parentId;
+        data.componentIdsAndTypes = components;
+        return createNode(NodeType::Entity, data);
+    }
+
+    void createScene()
+    {
+        QVector<QNodeId> meshes;
+        for(int index=0; index<Config::NumMeshes; ++index) {
+            // Geometry payload is irrelevant to the CPU job graph; a single quad per mesh suffices.
+            QGeometryData geometry;
+            geometry.vertices.resize(4);
+            geometry.faces = { QTriangle{{0, 1, 2}}, QTriangle{{2, 3, 0}} };
+
+            QGeometryRendererData data;
+            data.geometryId = createNode(NodeType::Geometry, geometry);
+            meshes.append(createNode(NodeType::GeometryRenderer, data));
+        }
+
+        QVector<QNodeId> materials;
+        for(int index=0; index<Config::NumMaterials; ++index) {
+            QMaterialData data;
+            data.albedo = QColor::fromHsv((index * 360) / Config::NumMaterials, 128, 255);
+            data.roughness = 0.5f;
+            data.metalness = 0.0f;
+            data.emission = Qt::white;
+            data.emissionIntensity = (index < Config::NumEmissiveMaterials) ? 1.0f : 0.0f;
+            materials.append(createNode(NodeType::Material, data));
+        }
+
+        // Entities are grouped under intermediate parents to keep hierarchy depth & fan-out realistic.
+        m_rootEntityId = createEntity(QNodeId(), {});
+        m_transforms.reserve(m_numEntities + m_numEntities / Config::EntitiesPerGroup + 1);
+
+        QNodeId groupEntityId;
+        for(int index=0; index<m_numEntities; ++index) {
+            const int groupIndex = index / Config::EntitiesPerGroup;
+            if(index % Config::EntitiesPerGroup == 0) {
+                const QNodeId groupTransformId = createTransform(QVector3D(0.0f, 0.0f, float(groupIndex)));
+                groupEntityId = createEntity(m_rootEntityId, {
+                    QNodeIdTypePair{groupTransformId, &Qt3DCore::QTransform::staticMetaObject},
+                });
+            }
+
+            const QNodeId transformId = createTransform(QVector3D(float(index % Config::EntitiesPerGroup), 0.0f, 0.0f));
+            createEntity(groupEntityId, {
+                QNodeIdTypePair{transformId, &Qt3DCore::QTransform::staticMetaObject},
+                QNodeIdTypePair{meshes[index % meshes.size()], &QGeometryRenderer::staticMetaObject},
+                QNodeIdTypePair{materials[index % materials.size()], &QMaterial::staticMetaObject},
+            });
+        }
+    }
+
+    const int m_numEntities;
+    Benchmark::StubAspect m_aspect;
+
+    QNodeId m_rootEntityId;
+    QVector<QBackendNode*> m_transforms;
+    int m_animationCursor = 0;
+    qint64 m_frameNumber = 0;
+};
+
+// Building a large scene takes much longer than measuring it, so it is kept between benchmark runs with the same entity count.
+BenchmarkScene &benchmarkScene(int numEntities)
+{
+    static std::unique_ptr<BenchmarkScene> scene;
+    if(!scene || scene->numEntities() != numEntities) {
+        scene.reset();
+        scene.reset(new BenchmarkScene(numEntities));
+    }
+    return *scene;
+}
+
+template<typename Function>
+void benchmarkFrames(benchmark::State &state, BenchmarkScene &scene, Function prepareFrame)
+{
+    double prepareTime = 0.0;
+    double jobsTime = 0.0;
+    const AllocationCounter::Counters allocationsBegin = AllocationCounter::counters();
+
+    QElapsedTimer timer;
+    for(auto _ : state) {
+        timer.start();
+        prepareFrame();
+        const qint64 prepareEnd = timer.nsecsElapsed();
+        scene.runFrame();
+        const qint64 frameEnd = timer.nsecsElapsed();
+
+        prepareTime += double(prepareEnd) * 1e-6;
+        jobsTime += double(frameEnd - prepareEnd) * 1e-6;
+    }
+
+    const AllocationCounter::Counters allocationsEnd = AllocationCounter::counters();
+    state.counters["entities"] = scene.numEntities();
+    state.counters["renderables"] = scene.renderer()->numRenderables();
+    state.counters["sync_ms"] = benchmark::Counter(prepareTime, benchmark::Counter::kAvgIterations);
+    state.counters["jobs_ms"] = benchmark::Counter(jobsTime, benchmark::Counter::kAvgIterations);
+    state.counters["allocs"] = benchmark::Counter(double(allocationsEnd.numAllocations - allocationsBegin.numAllocations), benchmark::Counter::kAvgIterations);
+    state.counters["alloc_bytes"] = benchmark::Counter(double(allocationsEnd.numBytes - allocationsBegin.numBytes), benchmark::Counter::kAvgIterations);
+    state.SetItemsProcessed(state.iterations() * scene.numEntities());
+}
+
+// Steady state animation: a fraction of entity transforms changes every frame.
+void BM_JobGraph_Animate(benchmark::State &state)
+{
+    BenchmarkScene &scene = benchmarkScene(int(state.range(0)));
+    const int numAnimated = int((state.range(0) * state.range(1)) / 1000);
+    benchmarkFrames(state, scene, [&scene, numAnimated]() {
+        scene.animate(numAnimated);
+    });
+    state.counters["animated"] = numAnimated;
+}
+
+// Worst case: every frame re-gathers scene entities and rebuilds all per-instance data.
+void BM_JobGraph_FullUpdate(benchmark::State &state)
+{
+    BenchmarkScene &scene = benchmarkScene(int(state.range(0)));
+    benchmarkFrames(state, scene, [&scene]() {
+        scene.renderer()->markDirty(Raytrace::AbstractRenderer::AllDirty, nullptr);
+    });
+}
+
+void animateArguments(benchmark::internal::Benchmark *benchmark)
+{
+    benchmark->ArgNames({"entities", "animated_permille"});
+    for(int numEntities : Config::EntityCounts) {
+        for(int animatedPermille : Config::AnimatedPermille) {
+            benchmark->Args({numEntities, animatedPermille});
+        }
+    }
+    benchmark->Unit(benchmark::kMillisecond);
+}
+
+void fullUpdateArguments(benchmark::internal::Benchmark *benchmark)
+{
+    benchmark->ArgNames({"entities"});
+    for(int numEntities : Config::EntityCounts) {
+        benchmark->Arg(numEntities);
+    }
+    benchmark->Unit(benchmark::kMillisecond);
+}
+
+} // anonymous
+
+BENCHMARK(BM_JobGraph_Animate)->Apply(animateArguments)->UseRealTime();
+BENCHMARK(BM_JobGraph_FullUpdate)->Apply(fullUpdateArguments)->UseRealTime();
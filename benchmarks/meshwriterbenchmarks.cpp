@@ -0,0 +1,68 @@
+/*
+ * Copyright (C) 2018-2019 Michał Siejak
+ * This file is part of Quartz - a raytracing aspect for Qt3D.
+ * See LICENSE file for licensing information.
+ */
+
+#include <benchdata.h>
+
+#include <objwriter.h>
+
+#include <benchmark/benchmark.h>
+
+#include <QBuffer>
+#include <QFileInfo>
+
+#include <assimp/Importer.hpp>
+#include <assimp/postprocess.h>
+#include <assimp/scene.h>
+
+using namespace BenchmarkData;
+
+namespace {
+
+void BM_WriteMesh_OBJ(benchmark::State &state)
+{
+    const QString path = dataPath(meshFileName(int(state.range(0)), "obj"));
+    if(!QFileInfo::exists(path)) {
+        state.SkipWithError("Benchmark input file not found; build the quartz-benchdata target first");
+        return;
+    }
+
+    // Same indexed mesh layout as scene2qml exports.
+    Assimp::Importer importer;
+    const aiScene *scene = importer.ReadFile(path.toStdString(), aiProcess_JoinIdenticalVertices);
+    if(!scene || scene->mNumMeshes == 0) {
+        state.SkipWithError("Mesh import failed");
+        return;
+    }
+    const aiMesh *mesh = scene->mMeshes[0];
+
+    QByteArray output;
+    QBuffer buffer(&output);
+    buffer.open(QIODevice::WriteOnly);
+    for(auto _ : state) {
+        // Rewinding reuses the already allocated output.
+        buffer.seek(0);
+        ObjWriter writer(&buffer);
+        if(!writer.writeMesh(mesh)) {
+            state.SkipWithError("Writing failed");
+            break;
+        }
+        benchmark::DoNotOptimize(output.constData());
+    }
+    state.SetBytesProcessed(state.iterations() * output.size());
+    state.counters["vertices"] = double(mesh->mNumVertices);
+}
+
+void meshSizes(benchmark::internal::Benchmark *benchmark)
+{
+    for(int gridSize : Config::MeshGridSizes) {
+        benchmark->Arg(gridSize);
+    }
+    benchmark->Unit(benchmark::kMillisecond);
+}
+
+} // anonymous
+
+BENCHMARK(BM_WriteMesh_OBJ)->Apply(meshSizes);
@@ -0,0 +1,146 @@
+/*
+ * Copyright (C) 2018-2019 Michał Siejak
+ * This file is part of Quartz - a raytracing aspect for Qt3D.
+ * See LICENSE file for licensing information.
+ */
+
+#include <stubaspect.h>
+
+#include <replay/scenechangereplayer_p.h>
+#include <utility/latencyhistogram.h>
+
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QTextStream>
+
+using namespace Qt3DRaytrace;
+
+using Utility::LatencyHistogram;
+
+namespace {
+
+namespace Config {
+static constexpr qint64 FrameInterval = 16666667; // ns
+} // Config
+
+struct FrameTimes
+{
+    LatencyHistogram times{LatencyHistogram::Resolution::Nanoseconds};
+    qint64 totalTime = 0;
+
+    void add(qint64 time)
+    {
+        times.addNanoseconds(time);
+        totalTime += time;
+    }
+};
+
+void printFrameTimes(QTextStream &out, const char *name, const FrameTimes &frameTimes)
+{
+    const quint64 numFrames = frameTimes.times.count();
+    const double meanTime = numFrames > 0 ? double(frameTimes.totalTime) * 1e-6 / double(numFrames) : 0.0;
+    out << name << ": mean " << meanTime << " ms"
+        << ", median " << frameTimes.times.percentile(0.5) << " ms"
+        << ", p95 " << frameTimes.times.percentile(0.95) << " ms"
+        << ", p99 " << frameTimes.times.percentile(0.99) << " ms"
+        << ", max " << frameTimes.times.maximum() << " ms\n";
+}
+
+} // anonymous
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("quartz-replay");
+    QCoreApplication::setApplicationVersion("1.0.0");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Replays a recorded scene change log (QUARTZ_RECORD) at full speed through the aspect "
+                                     "with a stub renderer, without a window or GPU, and reports per-frame CPU timings.");
+    parser.addHelpOption();
+    parser.addVersionOption();
+    parser.addPositionalArgument("log", "Scene change log path.");
+
+    QCommandLineOption warmupOption("warmup", "Number of initial frames excluded from reported timings.", "frames", "0");
+    parser.addOption(warmupOption);
+    QCommandLineOption csvOption("csv", "Write per-frame timings to a CSV file.", "path");
+    parser.addOption(csvOption);
+
+    parser.process(app);
+
+    const QStringList positionalArguments = parser.positionalArguments();
+    if(positionalArguments.size() != 1) {
+        parser.showHelp(2);
+    }
+    const int numWarmupFrames = parser.value(warmupOption).toInt();
+
+    QFile csvFile;
+    QTextStream csv;
+    if(parser.isSet(csvOption)) {
+        csvFile.setFileName(parser.value(csvOption));
+        if(!csvFile.open(QFile::WriteOnly | QFile::Truncate | QFile::Text)) {
+            QTextStream(stderr) << "Error: " << csvFile.fileName() << ": " << csvFile.errorString() << '\n';
+            return 1;
+        }
+        csv.setDevice(&csvFile);
+        csv << "frame,events,renderables,sync_ms,jobs_ms\n";
+    }
+
+    Benchmark::StubAspect aspect;
+    Raytrace::SceneChangeReplayer replayer(aspect.aspectPrivate(), aspect.renderer(), aspect.nodeManagers());
+    if(!replayer.open(positionalArguments[0], Raytrace::SceneChangeReplayer::Speed::Maximum)) {
+        return 1;
+    }
+
+    // Each frame applies one recorded frame worth of scene changes (sync), then builds and runs aspect jobs (jobs).
+    FrameTimes syncTimes;
+    FrameTimes jobsTimes;
+    FrameTimes frameTimes;
+
+    QElapsedTimer replayTimer;
+    replayTimer.start();
+
+    QElapsedTimer timer;
+    bool replaying = true;
+    for(int frameNumber=0; replaying; ++frameNumber) {
+        const quint64 numEventsBegin = replayer.numEventsReplayed();
+
+        timer.start();
+        replaying = replayer.advance();
+        const qint64 syncTime = timer.nsecsElapsed();
+        aspect.runFrame(frameNumber * Config::FrameInterval);
+        const qint64 frameTime = timer.nsecsElapsed();
+        const qint64 jobsTime = frameTime - syncTime;
+
+        if(frameNumber >= numWarmupFrames) {
+            syncTimes.add(syncTime);
+            jobsTimes.add(jobsTime);
+            frameTimes.add(frameTime);
+        }
+        if(csv.device()) {
+            csv << frameNumber << ',' << (replayer.numEventsReplayed() - numEventsBegin) << ',' << aspect.renderer()->numRenderables() << ','
+                << double(syncTime) * 1e-6 << ',' << double(jobsTime) * 1e-6 << '\n';
+        }
+    }
+
+    const double replayTime = double(replayTimer.nsecsElapsed()) * 1e-9;
+    const quint64 numFramesReported = frameTimes.times.count();
+
+    QTextStream out(stdout);
+    out << "Replayed " << replayer.numEventsReplayed() << " events, " << replayer.numFramesReplayed() << " frames in " << replayTime << " s\n";
+    out << "Renderables: " << aspect.renderer()->numRenderables() << ", emissives: " << aspect.renderer()->numEmissives() << '\n';
+    if(numFramesReported > 0) {
+        out << "Timings of " << numFramesReported << " frames";
+        if(numWarmupFrames > 0) {
+            out << " (" << numWarmupFrames << " warmup frames excluded)";
+        }
+        out << ":\n";
+        printFrameTimes(out, "  sync ", syncTimes);
+        printFrameTimes(out, "  jobs ", jobsTimes);
+        printFrameTimes(out, "  frame", frameTimes);
+        out << "  throughput: " << double(numFramesReported) / (double(frameTimes.totalTime) * 1e-9) << " frames/s\n";
+    }
+    return 0;
+}
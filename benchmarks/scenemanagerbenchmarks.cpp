@@ -0,0 +1,231 @@
+/*
+ * Copyright (C) 2018-2019 Michał Siejak
+ * This file is part of Quartz - a raytracing aspect for Qt3D.
+ * See LICENSE file for licensing information.
+ */
+
+#include <renderers/vulkan/renderer.h>
+#include <renderers/vulkan/managers/scenemanager.h>
+#include <utility/lockstatistics.h>
+
+#include <benchmark/benchmark.h>
+
+#include <QThread>
+#include <QVector>
+
+#include <memory>
+#include <string>
+
+using namespace Qt3DCore;
+using namespace Qt3DRaytrace;
+
+using Utility::LockStatistics;
+
+namespace {
+
+namespace Config {
+static constexpr int NumMaterials = 1024;
+static constexpr int NumGeometries = 256;
+static constexpr int NumTextures = 256;
+} // Config
+
+// Scene manager of a renderer which is never initialized. Only materials can be added without a Vulkan device;
+// geometry and texture lookups miss, but take the same lock and hash the same kind of key as in a real scene.
+class BenchmarkScene
+{
+public:
+    BenchmarkScene()
+        : m_sceneManager(&m_renderer)
+    {
+        for(int index=0; index<Config::NumMaterials; ++index) {
+            m_materialIds.append(QNodeId::createId());
+            m_sceneManager.addOrUpdateMaterial(m_materialIds.last(), material(index));
+        }
+        for(int index=0; index<Config::NumGeometries; ++index) {
+            m_geometryIds.append(QNodeId::createId());
+        }
+        for(int index=0; index<Config::NumTextures; ++index) {
+            m_textureIds.append(QNodeId::createId());
+        }
+    }
+
+    Vulkan::SceneManager &sceneManager() { return m_sceneManager; }
+
+    QNodeId materialId(quint32 index) const { return m_materialIds[int(index % Config::NumMaterials)]; }
+    QNodeId geometryId(quint32 index) const { return m_geometryIds[int(index % Config::NumGeometries)]; }
+    QNodeId textureId(quint32 index) const { return m_textureIds[int(index % Config::NumTextures)]; }
+
+    static Vulkan::Material material(quint32 index)
+    {
+        Vulkan::Material material = {};
+        material.albedo.data[0] = float(index % 256) / 255.0f;
+        material.albedo.data[3] = 0.5f;
+        return material;
+    }
+
+private:
+    Vulkan::Renderer m_renderer;
+    Vulkan::SceneManager m_sceneManager;
+    QVector<QNodeId> m_materialIds;
+    QVector<QNodeId> m_geometryIds;
+    QVector<QNodeId> m_textureIds;
+};
+
+BenchmarkScene &benchmarkScene()
+{
+    // Never destroyed: releasing scene manager resources requires a Vulkan device.
+    static BenchmarkScene *scene = new BenchmarkScene;
+    return *scene;
+}
+
+// Per-thread pseudo-random sequence so that concurrent threads do not look up identical keys in lockstep.
+class Sequence
+{
+public:
+    explicit Sequence(int seed)
+        : m_state(quint32(seed) * 2654435761u + 1u)
+    {}
+
+    quint32 next()
+    {
+        m_state ^= m_state << 13;
+        m_state ^= m_state >> 17;
+        m_state ^= m_state << 5;
+        return m_state;
+    }
+
+private:
+    quint32 m_state;
+};
+
+// Same lookups as UpdateInstanceBufferJob & BuildSceneTLASJob make for every renderable entity.
+void lookupInstance(BenchmarkScene &scene, Sequence &sequence)
+{
+    Vulkan::Geometry geometry;
+    benchmark::DoNotOptimize(scene.sceneManager().lookupMaterialIndex(scene.materialId(sequence.next())));
+    benchmark::DoNotOptimize(scene.sceneManager().lookupGeometry(scene.geometryId(sequence.next()), geometry));
+}
+
+// Same lookups & update as UpdateMaterialsJob makes for every dirty material.
+void updateMaterial(BenchmarkScene &scene, Sequence &sequence)
+{
+    const quint32 index = sequence.next();
+    Vulkan::Material material = BenchmarkScene::material(index);
+    material.albedoTexture = scene.sceneManager().lookupTextureIndex(scene.textureId(sequence.next()));
+    material.roughnessTexture = scene.sceneManager().lookupTextureIndex(scene.textureId(sequence.next()));
+    material.metalnessTexture = scene.sceneManager().lookupTextureIndex(scene.textureId(sequence.next()));
+    scene.sceneManager().addOrUpdateMaterial(scene.materialId(index), material);
+}
+
+struct LockCounters
+{
+    explicit LockCounters(const LockStatistics &statistics)
+    {
+        for(auto access : { LockStatistics::Read, LockStatistics::Write }) {
+            numAcquisitions[access] = statistics.numAcquisitions(access);
+            numContended[access] = statistics.numContended(access);
+            waitTime[access] = statistics.totalWaitTime(access);
+            holdTime[access] = statistics.totalHoldTime(access);
+        }
+    }
+
+    quint64 numAcquisitions[2];
+    quint64 numContended[2];
+    double waitTime[2];
+    double holdTime[2];
+};
+
+template<typename Function>
+void benchmarkLookups(benchmark::State &state, Function function)
+{
+    BenchmarkScene &scene = benchmarkScene();
+    const bool instrumented = state.range(0) != 0;
+
+    // Threads synchronize on entering and leaving the benchmark loop, so thread 0 may (re)configure and report shared state.
+    std::unique_ptr<LockCounters> countersBegin;
+    if(state.thread_index() == 0) {
+        LockStatistics::setEnabled(instrumented);
+        countersBegin.reset(new LockCounters(scene.sceneManager().lockStatistics()));
+    }
+
+    Sequence sequence(state.thread_index());
+    for(auto _ : state) {
+        function(scene, sequence);
+    }
+    state.SetItemsProcessed(state.iterations());
+
+    if(state.thread_index() == 0) {
+        LockStatistics::setEnabled(false);
+        if(instrumented) {
+            const LockCounters countersEnd(scene.sceneManager().lockStatistics());
+            for(auto access : { LockStatistics::Read, LockStatistics::Write }) {
+                const char *prefix = (access == LockStatistics::Read) ? "read" : "write";
+                const double numLocks = double(countersEnd.numAcquisitions[access] - countersBegin->numAcquisitions[access]);
+                const double numContended = double(countersEnd.numContended[access] - countersBegin->numContended[access]);
+                const double waitTime = (countersEnd.waitTime[access] - countersBegin->waitTime[access]) * 1e6;
+                const double holdTime = (countersEnd.holdTime[access] - countersBegin->holdTime[access]) * 1e6;
+                if(numLocks > 0.0) {
+                    state.counters[std::string(prefix) + "_locks"] = numLocks;
+                    state.counters[std::string(prefix) + "_contended_pct"] = 100.0 * numContended / numLocks;
+                    state.counters[std::string(prefix) + "_wait_ns"] = waitTime / numLocks;
+                    state.counters[std::string(prefix) + "_hold_ns"] = holdTime / numLocks;
+                }
+            }
+        }
+    }
+}
+
+// Read-only lookups of concurrently running instance buffer & TLAS jobs.
+void BM_SceneManager_InstanceLookups(benchmark::State &state)
+{
+    benchmarkLookups(state, [](BenchmarkScene &scene, Sequence &sequence) {
+        lookupInstance(scene, sequence);
+    });
+}
+
+// Texture lookups and material updates of UpdateMaterialsJob, issued from every thread.
+void BM_SceneManager_MaterialUpdates(benchmark::State &state)
+{
+    benchmarkLookups(state, [](BenchmarkScene &scene, Sequence &sequence) {
+        updateMaterial(scene, sequence);
+    });
+}
+
+// Instance lookups on all threads but one, which concurrently updates materials.
+void BM_SceneManager_LookupsWithWriter(benchmark::State &state)
+{
+    const bool writer = (state.thread_index() == 0);
+    benchmarkLookups(state, [writer](BenchmarkScene &scene, Sequence &sequence) {
+        if(writer) {
+            updateMaterial(scene, sequence);
+        }
+        else {
+            lookupInstance(scene, sequence);
+        }
+    });
+}
+
+void threadArguments(benchmark::internal::Benchmark *benchmark, int minThreads)
+{
+    benchmark->ArgNames({"instrumented"});
+    benchmark->Arg(0)->Arg(1);
+    benchmark->ThreadRange(minThreads, qMax(minThreads, QThread::idealThreadCount()));
+    benchmark->UseRealTime();
+}
+
+void lookupArguments(benchmark::internal::Benchmark *benchmark)
+{
+    threadArguments(benchmark, 1);
+}
+
+void writerArguments(benchmark::internal::Benchmark *benchmark)
+{
+    // Needs at least one reader besides the writer thread.
+    threadArguments(benchmark, 2);
+}
+
+} // anonymous
+
+BENCHMARK(BM_SceneManager_InstanceLookups)->Apply(lookupArguments);
+BENCHMARK(BM_SceneManager_MaterialUpdates)->Apply(lookupArguments);
+BENCHMARK(BM_SceneManager_LookupsWithWriter)->Apply(writerArguments);
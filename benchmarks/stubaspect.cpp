@@ -0,0 +1,46 @@
+/*
+ * Copyright (C) 2018-2019 Michał Siejak
+ * This file is part of Quartz - a raytracing aspect for Qt3D.
+ * See LICENSE file for licensing information.
+ */
+
+#include <stubaspect.h>
+
+#include <backend/managers_p.h>
+
+using namespace Qt3DCore;
+
+namespace Qt3DRaytrace {
+namespace Benchmark {
+
+StubAspect::StubAspect()
+{
+    m_aspectPrivate = static_cast<QRaytraceAspectPrivate*>(QAbstractAspectPrivate::get(&m_aspect));
+    m_renderer = new StubRenderer;
+
+    // Same as QRaytraceAspect::onRegistered() with a stub renderer.
+    m_aspectPrivate->m_nodeManagers.reset(new Raytrace::NodeManagers);
+    m_aspectPrivate->m_renderer.reset(m_renderer);
+    m_aspectPrivate->m_renderer->setNodeManagers(m_aspectPrivate->m_nodeManagers.get());
+    m_aspectPrivate->registerBackendTypes();
+    m_renderer->initialize();
+
+    m_jobManager.initialize();
+}
+
+StubAspect::~StubAspect()
+{
+    // Same as QRaytraceAspect::onUnregistered().
+    m_aspectPrivate->m_renderer.reset();
+    m_aspectPrivate->m_nodeManagers.reset();
+}
+
+void StubAspect::runFrame(qint64 time)
+{
+    const QVector<QAspectJobPtr> jobs = m_aspectPrivate->createFrameJobs(time);
+    m_jobManager.enqueueJobs(jobs);
+    m_jobManager.waitForAllJobs();
+}
+
+} // Benchmark
+} // Qt3DRaytrace
@@ -0,0 +1,43 @@
+/*
+ * Copyright (C) 2018-2019 Michał Siejak
+ * This file is part of Quartz - a raytracing aspect for Qt3D.
+ * See LICENSE file for licensing information.
+ */
+
+#pragma once
+
+#include <stubrenderer.h>
+
+#include <qraytraceaspect_p.h>
+
+#include <Qt3DCore/private/qaspectjobmanager_p.h>
+
+namespace Qt3DRaytrace {
+namespace Benchmark {
+
+// QRaytraceAspect with a stub renderer, running its frame jobs on a private job manager.
+// Backend nodes are created directly, as scene change replay does, so that neither frontend objects nor an aspect engine need to exist.
+class StubAspect
+{
+public:
+    StubAspect();
+    ~StubAspect();
+
+    QRaytraceAspectPrivate *aspectPrivate() const { return m_aspectPrivate; }
+    Raytrace::NodeManagers *nodeManagers() const { return m_aspectPrivate->m_nodeManagers.get(); }
+    StubRenderer *renderer() const { return m_renderer; }
+
+    // Creates jobs of one frame and waits until all of them have finished.
+    void runFrame(qint64 time);
+
+    Q_DISABLE_COPY(StubAspect)
+
+private:
+    QRaytraceAspect m_aspect;
+    QRaytraceAspectPrivate *m_aspectPrivate;
+    StubRenderer *m_renderer;
+    Qt3DCore::QAspectJobManager m_jobManager;
+};
+
+} // Benchmark
+} // Qt3DRaytrace
@@ -0,0 +1,206 @@
+/*
+ * Copyright (C) 2018-2019 Michał Siejak
+ * This file is part of Quartz - a raytracing aspect for Qt3D.
+ * See LICENSE file for licensing information.
+ */
+
+#include <stubrenderer.h>
+
+#include <renderers/vulkan/scenerecords.h>
+#include <backend/managers_p.h>
+#include <utility/tracing.h>
+
+using namespace Qt3DCore;
+
+namespace Qt3DRaytrace {
+namespace Benchmark {
+
+void StubJob::run()
+{
+    Utility::TraceScope trace(m_name);
+    m_function();
+}
+
+StubRenderer::StubRenderer()
+{
+    m_updateWorldTransformJob = Raytrace::UpdateWorldTransformJobPtr::create();
+    m_updateInstancesJob = QSharedPointer<StubJob>::create("UpdateInstanceBufferJob", [this]() { updateInstances(); });
+    m_updateEmittersJob = QSharedPointer<StubJob>::create("UpdateEmittersJob", [this]() { updateEmitters(); });
+
+    // Textures are never uploaded, hence there are no texture jobs for materials & emitters to wait for.
+    Vulkan::SceneJobGraph::JobFactory sceneJobFactory;
+    sceneJobFactory.createGeometryJobs = [this]() { return createGeometryJobs(); };
+    sceneJobFactory.createTextureJobs = []() { return QVector<QAspectJobPtr>(); };
+    sceneJobFactory.createMaterialJobs = [this](bool forceAllDirty) { return createMaterialJobs(forceAllDirty); };
+    sceneJobFactory.createSceneTLASJob = [this]() -> QAspectJobPtr {
+        return QSharedPointer<StubJob>::create("BuildSceneTopLevelAccelerationStructureJob", [this]() { updateGeometryInstances(); });
+    };
+    m_sceneJobGraph.reset(new Vulkan::SceneJobGraph(sceneJobFactory, m_updateWorldTransformJob, m_updateInstancesJob, m_updateEmittersJob));
+}
+
+void StubRenderer::markDirty(DirtySet changes, Raytrace::BackendNode *node)
+{
+    Q_UNUSED(node);
+    m_dirtySet |= changes;
+}
+
+QRenderStatistics StubRenderer::statistics() const
+{
+    QRenderStatistics stats = {};
+    stats.numFramesRendered = m_frameNumber;
+    return stats;
+}
+
+void StubRenderer::setSceneRoot(Raytrace::Entity *rootEntity)
+{
+    m_sceneRoot = rootEntity;
+    m_updateWorldTransformJob->setRoot(m_sceneRoot);
+}
+
+QImageData StubRenderer::grabImage(QRenderImage type)
+{
+    Q_UNUSED(type);
+    return QImageData{};
+}
+
+QVector<QAspectJobPtr> StubRenderer::createGeometryJobs()
+{
+    auto *geometryManager = &m_nodeManagers->geometryManager;
+    auto dirtyGeometry = geometryManager->acquireDirtyComponents();
+
+    QVector<QAspectJobPtr> geometryJobs;
+    geometryJobs.reserve(dirtyGeometry.size());
+    for(const QNodeId &geometryId : dirtyGeometry) {
+        Raytrace::HGeometry handle = geometryManager->lookupHandle(geometryId);
+        if(!handle.isNull()) {
+            geometryJobs.append(QSharedPointer<StubJob>::create("BuildGeometryJob", [this, handle]() { updateGeometry(handle); }));
+        }
+    }
+    return geometryJobs;
+}
+
+QVector<QAspectJobPtr> StubRenderer::createMaterialJobs(bool forceAllDirty)
+{
+    auto *materialManager = &m_nodeManagers->materialManager;
+
+    QVector<Raytrace::HMaterial> dirtyMaterialHandles;
+    if(forceAllDirty) {
+        dirtyMaterialHandles = materialManager->activeHandles();
+        materialManager->clearDirtyComponents();
+    }
+    else {
+        auto dirtyMaterials = materialManager->acquireDirtyComponents();
+        dirtyMaterialHandles.reserve(dirtyMaterials.size());
+        for(const QNodeId &materialId : dirtyMaterials) {
+            Raytrace::HMaterial handle = materialManager->lookupHandle(materialId);
+            if(!handle.isNull()) {
+                dirtyMaterialHandles.append(handle);
+            }
+        }
+    }
+    return { QSharedPointer<StubJob>::create("UpdateMaterialsJob", [this, dirtyMaterialHandles]() { updateMaterials(dirtyMaterialHandles); }) };
+}
+
+QVector<QAspectJobPtr> StubRenderer::jobsToExecute(qint64 time)
+{
+    Q_UNUSED(time);
+    Q_ASSERT(m_nodeManagers);
+
+    QVector<QAspectJobPtr> jobs;
+    if(!m_sceneRoot) {
+        return jobs;
+    }
+
+    const Vulkan::SceneJobGraph::Frame sceneFrame = m_sceneJobGraph->beginFrame(m_dirtySet, jobs);
+    m_dirtySet = DirtyFlag::NoneDirty;
+    ++m_frameNumber;
+
+    if(sceneFrame.sceneEntitiesDirty) {
+        // NO LOCK: Same as Vulkan::SceneManager::gatherEntities(), called from aspect thread only.
+        m_entities.gather(&m_nodeManagers->entityManager);
+    }
+    if(renderables().size() == 0) {
+        return jobs;
+    }
+
+    m_sceneJobGraph->endFrame(sceneFrame, jobs);
+    return jobs;
+}
+
+void StubRenderer::updateGeometry(Raytrace::HGeometry handle)
+{
+    const Raytrace::Geometry *geometry = m_nodeManagers->geometryManager.data(handle);
+    if(!geometry) {
+        return;
+    }
+
+    GeometryInfo geometryInfo;
+    geometryInfo.numVertices = uint32_t(geometry->vertices().size());
+    geometryInfo.numIndices = uint32_t(geometry->faces().size()) * 3;
+    geometryInfo.blasHandle = geometry->peerId().id();
+
+    QWriteLocker lock(&m_rwlock);
+    m_geometry.addOrUpdateResource(geometry->peerId(), geometryInfo);
+}
+
+void StubRenderer::updateMaterials(const QVector<Raytrace::HMaterial> &handles)
+{
+    for(const auto &handle : handles) {
+        const Raytrace::Material *material = handle.data();
+
+        Vulkan::Material materialData = {};
+        material->albedo().writeToBuffer(materialData.albedo.data);
+        material->emission().writeToBuffer(materialData.emission.data);
+        materialData.albedo.data[3] = material->roughness();
+        materialData.emission.data[3] = material->metalness();
+        materialData.albedoTexture = ~0u;
+        materialData.roughnessTexture = ~0u;
+        materialData.metalnessTexture = ~0u;
+
+        QWriteLocker lock(&m_rwlock);
+        m_materials.addOrUpdateResource(material->peerId(), materialData);
+    }
+}
+
+void StubRenderer::updateInstances()
+{
+    m_instances.resize(renderables().size());
+    Vulkan::writeEntityInstances<GeometryInfo>(*this, m_instances.data());
+}
+
+void StubRenderer::updateEmitters()
+{
+    m_emitters = Vulkan::gatherEmitters(*this, m_settings, ~0u);
+}
+
+void StubRenderer::updateGeometryInstances()
+{
+    m_geometryInstances = Vulkan::gatherGeometryInstances<GeometryInstance, GeometryInfo>(*this);
+}
+
+uint32_t StubRenderer::lookupGeometry(QNodeId geometryNodeId, GeometryInfo &geometry) const
+{
+    QReadLocker lock(&m_rwlock);
+    return m_geometry.lookupResource(geometryNodeId, geometry);
+}
+
+uint32_t StubRenderer::lookupGeometryIndex(QNodeId geometryNodeId) const
+{
+    QReadLocker lock(&m_rwlock);
+    return m_geometry.lookupIndex(geometryNodeId);
+}
+
+uint32_t StubRenderer::lookupMaterialIndex(QNodeId materialNodeId) const
+{
+    QReadLocker lock(&m_rwlock);
+    return m_materials.lookupIndex(materialNodeId);
+}
+
+uint32_t StubRenderer::lookupRenderableIndex(QNodeId entityNodeId) const
+{
+    QReadLocker lock(&m_rwlock);
+    return m_entities.lookupRenderableIndex(entityNodeId);
+}
+
+} // Benchmark
+} // Qt3DRaytrace
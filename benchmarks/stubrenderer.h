@@ -0,0 +1,132 @@
+/*
+ * Copyright (C) 2018-2019 Michał Siejak
+ * This file is part of Quartz - a raytracing aspect for Qt3D.
+ * See LICENSE file for licensing information.
+ */
+
+#pragma once
+
+#include <backend/abstractrenderer_p.h>
+#include <backend/handles_p.h>
+#include <jobs/updateworldtransformjob_p.h>
+#include <renderers/vulkan/glsl.h>
+#include <renderers/vulkan/scenejobgraph.h>
+#include <renderers/vulkan/managers/sceneentities.h>
+#include <renderers/vulkan/managers/sceneresourceset.h>
+
+#include <QReadWriteLock>
+#include <QVector>
+
+#include <functional>
+
+namespace Qt3DRaytrace {
+namespace Benchmark {
+
+// Aspect job running a function; stands in for renderer jobs whose work is done on the GPU.
+class StubJob final : public Qt3DCore::QAspectJob
+{
+public:
+    StubJob(const char *name, std::function<void()> function)
+        : m_name(name)
+        , m_function(std::move(function))
+    {}
+    void run() override;
+
+private:
+    const char *m_name;
+    std::function<void()> m_function;
+};
+
+// Host-only renderer running the CPU side of Vulkan::Renderer: it builds the job graph through the same SceneJobGraph
+// and fills instance, emitter & TLAS instance records in host memory instead of uploading them to a device.
+class StubRenderer final : public Raytrace::AbstractRenderer
+{
+public:
+    struct GeometryInfo
+    {
+        uint32_t numVertices = 0;
+        uint32_t numIndices = 0;
+        uint64_t blasHandle = 0;
+    };
+
+    // Same layout as Vulkan::GeometryInstance.
+    struct GeometryInstance
+    {
+        float transform[12];
+        uint32_t instanceCustomIndex : 24;
+        uint32_t mask : 8;
+        uint32_t instanceOffset : 24;
+        uint32_t flags : 8;
+        uint64_t blasHandle;
+    };
+
+    StubRenderer();
+
+    bool initialize() override { return true; }
+    void shutdown() override {}
+
+    void markDirty(DirtySet changes, Raytrace::BackendNode *node) override;
+
+    QSurface *surface() const override { return nullptr; }
+    Raytrace::Entity *sceneRoot() const override { return m_sceneRoot; }
+    Raytrace::RenderSettings *settings() const override { return m_settings; }
+    QRenderStatistics statistics() const override;
+
+    void setSurface(QObject *surfaceObject) override { Q_UNUSED(surfaceObject); }
+    void setSceneRoot(Raytrace::Entity *rootEntity) override;
+    void setSettings(Raytrace::RenderSettings *settings) override { m_settings = settings; }
+    void setNodeManagers(Raytrace::NodeManagers *nodeManagers) override { m_nodeManagers = nodeManagers; }
+
+    QImageData grabImage(QRenderImage type) override;
+
+    Qt3DCore::QAbstractFrameAdvanceService *frameAdvanceService() const override { return nullptr; }
+
+    QVector<Qt3DCore::QAspectJobPtr> jobsToExecute(qint64 time) override;
+
+    int numRenderables() const { return renderables().size(); }
+    int numEmissives() const { return emissives().size(); }
+
+    // Same lookups as Vulkan::SceneManager, used to fill scene records.
+    uint32_t lookupGeometry(Qt3DCore::QNodeId geometryNodeId, GeometryInfo &geometry) const;
+    uint32_t lookupGeometryIndex(Qt3DCore::QNodeId geometryNodeId) const;
+    uint32_t lookupMaterialIndex(Qt3DCore::QNodeId materialNodeId) const;
+    uint32_t lookupRenderableIndex(Qt3DCore::QNodeId entityNodeId) const;
+
+    const QVector<Raytrace::HEntity> &renderables() const { return m_entities.renderables(); }
+    const QVector<Raytrace::HEntity> &emissives() const { return m_entities.emissives(); }
+
+private:
+    QVector<Qt3DCore::QAspectJobPtr> createGeometryJobs();
+    QVector<Qt3DCore::QAspectJobPtr> createMaterialJobs(bool forceAllDirty);
+
+    void updateGeometry(Raytrace::HGeometry handle);
+    void updateMaterials(const QVector<Raytrace::HMaterial> &handles);
+    void updateInstances();
+    void updateEmitters();
+    void updateGeometryInstances();
+
+    Raytrace::NodeManagers *m_nodeManagers = nullptr;
+    Raytrace::Entity *m_sceneRoot = nullptr;
+    Raytrace::RenderSettings *m_settings = nullptr;
+    DirtySet m_dirtySet = AllDirty;
+    int m_frameNumber = 0;
+
+    Raytrace::UpdateWorldTransformJobPtr m_updateWorldTransformJob;
+    Qt3DCore::QAspectJobPtr m_updateInstancesJob;
+    Qt3DCore::QAspectJobPtr m_updateEmittersJob;
+    QSharedPointer<Vulkan::SceneJobGraph> m_sceneJobGraph;
+
+    // Same containers & locking as Vulkan::SceneManager.
+    Vulkan::SceneEntities m_entities;
+    Vulkan::SceneResourceSet<GeometryInfo> m_geometry;
+    Vulkan::SceneResourceSet<Vulkan::Material> m_materials;
+    mutable QReadWriteLock m_rwlock;
+
+    // Host memory standing in for instance, emitter & TLAS instance buffers.
+    QVector<Vulkan::EntityInstance> m_instances;
+    QVector<Vulkan::Emitter> m_emitters;
+    QVector<GeometryInstance> m_geometryInstances;
+};
+
+} // Benchmark
+} // Qt3DRaytrace
@@ -0,0 +1,55 @@
+/*
+ * Copyright (C) 2018-2019 Michał Siejak
+ * This file is part of Quartz - a raytracing aspect for Qt3D.
+ * See LICENSE file for licensing information.
+ */
+
+#pragma once
+
+#include <Qt3DRaytrace/qt3draytrace_global.h>
+#include <QtCore/qmetatype.h>
+
+#include <QString>
+#include <QVector>
+
+namespace Qt3DRaytrace {
+
+struct QAssetImportStep
+{
+    QString name;
+    double time;
+};
+
+// Metrics of a single asset import. All times are in milliseconds.
+struct QAssetImportRecord
+{
+    enum class Type {
+        Mesh,
+        Image,
+    };
+
+    Type type = Type::Mesh;
+    QString source;
+    QString importer;
+    bool succeeded = false;
+
+    qint64 fileSize = 0;
+    double readTime = 0.0;
+    double decodeTime = 0.0;
+    double conversionTime = 0.0;
+    QVector<QAssetImportStep> steps; // Individual post-processing steps included in decodeTime.
+
+    quint64 numVertices = 0;
+    quint64 numIndices = 0;
+    quint64 numTexels = 0;
+    qint64 peakTemporaryMemory = 0; // Estimated size of intermediate buffers (file contents, decoder output) alive at once.
+
+    double totalTime() const
+    {
+        return readTime + decodeTime + conversionTime;
+    }
+};
+
+} // Qt3DRaytrace
+
+Q_DECLARE_METATYPE(Qt3DRaytrace::QAssetImportRecord)
@@ -9,6 +9,8 @@
 #include <Qt3DRaytrace/qt3draytrace_global.h>
 #include <Qt3DRaytrace/qimagedata.h>
 #include <Qt3DRaytrace/qrenderimage.h>
+#include <Qt3DRaytrace/qrenderstatistics.h>
+#include <Qt3DRaytrace/qassetimportstatistics.h>
 
 #include <Qt3DCore/qabstractaspect.h>
 
@@ -29,6 +31,20 @@ public:
 
     bool queryRenderStatistics(QRenderStatistics &statistics) const;
 
+    void setTracingEnabled(bool enabled);
+    bool isTracingEnabled() const;
+    bool dumpTrace(const QString &path) const;
+
+    // Startup timing is process-wide: all aspect instances share (and restart) a single set of timings.
+    static bool queryStartupStatistics(QStartupStatistics &statistics);
+    static void restartStartupTiming();
+    static void beginStartupPhase(QStartupPhase phase);
+    static void endStartupPhase(QStartupPhase phase);
+
+    QVector<QAssetImportRecord> importRecords() const;
+    QVector<QAssetImportRecord> slowestImports(int count) const;
+    bool dumpImportStatistics(const QString &path) const;
+
 public slots:
     void suspendJobs();
     void resumeJobs();
@@ -36,6 +52,8 @@ public slots:
 
 signals:
     void imageReady(Qt3DRaytrace::QRenderImage type, Qt3DRaytrace::QImageDataPtr image);
+    // Emitted together with imageReady(), carrying render statistics captured with the image.
+    void imageReadyWithStatistics(Qt3DRaytrace::QRenderImage type, Qt3DRaytrace::QImageDataPtr image, const Qt3DRaytrace::QRenderStatistics &statistics);
 
 protected:
     QRaytraceAspect(QRaytraceAspectPrivate &dd, QObject *parent);
@@ -7,6 +7,7 @@
 #pragma once
 
 #include <Qt3DRaytrace/qt3draytrace_global.h>
+#include <Qt3DRaytrace/qrenderstatistics.h>
 #include <QtCore/qmetatype.h>
 
 namespace Qt3DRaytrace {
@@ -17,14 +18,6 @@ enum class QRenderImage
     FinalLDR,
 };
 
-struct QRenderStatistics
-{
-    double cpuFrameTime;
-    double gpuFrameTime;
-    double totalRenderTime;
-    unsigned int numFramesRendered;
-};
-
 } // Qt3DRaytrace
 
 Q_DECLARE_METATYPE(Qt3DRaytrace::QRenderImage)
@@ -27,6 +27,7 @@ class QT3DRAYTRACESHARED_EXPORT QRenderSettings : public Qt3DCore::QComponent
     Q_PROPERTY(int secondarySamples READ secondarySamples WRITE setSecondarySamples NOTIFY secondarySamplesChanged)
     Q_PROPERTY(int minDepth READ minDepth WRITE setMinDepth NOTIFY minDepthChanged)
     Q_PROPERTY(int maxDepth READ maxDepth WRITE setMaxDepth NOTIFY maxDepthChanged)
+    Q_PROPERTY(int randomSeed READ randomSeed WRITE setRandomSeed NOTIFY randomSeedChanged)
     Q_PROPERTY(float directRadianceClamp READ directRadianceClamp WRITE setDirectRadianceClamp NOTIFY directRadianceClampChanged)
     Q_PROPERTY(float indirectRadianceClamp READ indirectRadianceClamp WRITE setIndirectRadianceClamp NOTIFY indirectRadianceClampChanged)
     Q_PROPERTY(QColor skyColor READ skyColor WRITE setSkyColor NOTIFY skyColorChanged)
@@ -41,6 +42,7 @@ public:
     int secondarySamples() const;
     int minDepth() const;
     int maxDepth() const;
+    int randomSeed() const;
     float directRadianceClamp() const;
     float indirectRadianceClamp() const;
     QColor skyColor() const;
@@ -54,6 +56,7 @@ public slots:
     void setSecondarySamples(int secondarySamples);
     void setMinDepth(int minDepth);
     void setMaxDepth(int maxDepth);
+    void setRandomSeed(int seed);
     void setDirectRadianceClamp(float clamp);
     void setIndirectRadianceClamp(float clamp);
     void setSkyColor(const QColor &skyColor);
@@ -67,6 +70,7 @@ signals:
     void secondarySamplesChanged(int secondarySamples);
     void minDepthChanged(int minDepth);
     void maxDepthChanged(int maxDepth);
+    void randomSeedChanged(int seed);
     void directRadianceClampChanged(float clamp);
     void indirectRadianceClampChanged(float clamp);
     void skyColorChanged(const QColor &skyColor);
@@ -0,0 +1,106 @@
+/*
+ * Copyright (C) 2018-2019 Michał Siejak
+ * This file is part of Quartz - a raytracing aspect for Qt3D.
+ * See LICENSE file for licensing information.
+ */
+
+#pragma once
+
+#include <Qt3DRaytrace/qt3draytrace_global.h>
+#include <QtCore/qmetatype.h>
+
+namespace Qt3DRaytrace {
+
+struct QLatencyStatistics
+{
+    double p50;
+    double p95;
+    double p99;
+    double max;
+    quint64 numSamples;
+};
+
+// Times are in milliseconds; wait times include contended acquisitions only.
+struct QLockStatistics
+{
+    quint64 numReadLocks;
+    quint64 numWriteLocks;
+    quint64 numContendedReadLocks;
+    quint64 numContendedWriteLocks;
+    double totalReadWaitTime;
+    double totalWriteWaitTime;
+    double totalReadHoldTime;
+    double totalWriteHoldTime;
+    QLatencyStatistics readWaitTimes;
+    QLatencyStatistics writeWaitTimes;
+};
+
+struct QRenderResourceStatistics
+{
+    unsigned int numGeometries;
+    unsigned int numBottomLevelAccelerationStructures;
+    unsigned int numTextures;
+    unsigned int numDescriptors;
+    unsigned int descriptorCapacity;
+    quint64 geometryBytes;
+    quint64 accelerationStructureBytes;
+    quint64 textureBytes;
+    unsigned int numDeviceAllocations;
+    quint64 deviceAllocatedBytes;
+    quint64 deviceLocalMemoryCapacity;
+    quint64 stagingBytesLastFrame;
+    quint64 hostPayloadBytes;
+    unsigned int numPendingLoads;
+    unsigned int numPendingUploads;
+};
+
+struct QRenderStatistics
+{
+    double cpuFrameTime;
+    double gpuFrameTime;
+    double totalRenderTime;
+    unsigned int numFramesRendered;
+    QLatencyStatistics cpuFrameTimes;
+    QLatencyStatistics gpuFrameTimes;
+    QLatencyStatistics geometryLoadTimes;
+    QLatencyStatistics textureLoadTimes;
+    QLatencyStatistics geometryBuildTimes;
+    QLatencyStatistics textureUploadTimes;
+    QRenderResourceStatistics resources;
+    QLockStatistics sceneLock;
+};
+
+enum class QStartupPhase
+{
+    SceneLoading,
+    NodeCreation,
+    RendererInitialization,
+    GeometryImport,
+    TextureImport,
+    GeometryConversion,
+    AccelerationStructureBuild,
+    TextureUpload,
+};
+
+static constexpr int QStartupPhaseCount = int(QStartupPhase::TextureUpload) + 1;
+
+// All times are in seconds relative to the start of scene loading.
+struct QStartupPhaseTiming
+{
+    double begin;
+    double end;
+    double totalTime; // Sum of all timed sections; exceeds (end - begin) when sections ran concurrently.
+    unsigned int count;
+};
+
+struct QStartupStatistics
+{
+    QStartupPhaseTiming phases[QStartupPhaseCount];
+    double timeToFirstFrame;
+    double timeToCompleteFrame;
+    bool complete;
+};
+
+} // Qt3DRaytrace
+
+Q_DECLARE_METATYPE(Qt3DRaytrace::QRenderStatistics)
@@ -53,6 +53,7 @@ public:
     QQmlEngine *qmlEngine() const;
 
     void setSource(const QUrl &source);
+    QUrl source() const;
     Qt3DCore::Quick::QQmlAspectEngine *engine() const;
 
     enum CameraAspectRatioMode {
@@ -64,9 +65,13 @@ public:
     CameraAspectRatioMode cameraAspectRatioMode() const;
     void setCameraAspectRatioMode(CameraAspectRatioMode mode);
 
+public slots:
+    void reload();
+
 signals:
     void cameraAspectRatioModeChanged(CameraAspectRatioMode mode);
     void aboutToClose();
+    void sceneLoaded(Qt3DCore::QEntity *root);
 
 protected:
     Qt3DQuickWindow(Qt3DQuickWindowPrivate &dd, QWindow *parent);
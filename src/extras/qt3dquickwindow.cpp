@@ -7,13 +7,66 @@
 #include <qt3dquickwindow_p.h>
 
 #include <Qt3DCore/QEntity>
+#include <QQmlEngine>
 #include <QPlatformSurfaceEvent>
+#include <QTimerEvent>
+#include <QDebug>
 
 namespace Qt3DRaytraceExtras {
 namespace Quick {
 
+namespace Config {
+static constexpr int IncubationTimeSlice = 10;
+} // Config
+
+IncubationController::IncubationController(QObject *parent)
+    : QObject(parent)
+{}
+
+void IncubationController::incubatingObjectCountChanged(int count)
+{
+    if(count > 0 && !m_timer.isActive()) {
+        m_timer.start(0, this);
+    }
+    else if(count == 0) {
+        m_timer.stop();
+    }
+}
+
+void IncubationController::timerEvent(QTimerEvent *event)
+{
+    if(event->timerId() == m_timer.timerId()) {
+        incubateFor(Config::IncubationTimeSlice);
+    }
+}
+
+SceneIncubator::SceneIncubator(Qt3DQuickWindowPrivate *window)
+    : QQmlIncubator(QQmlIncubator::Asynchronous)
+    , m_window(window)
+{
+    Q_ASSERT(m_window);
+}
+
+void SceneIncubator::setInitialState(QObject *object)
+{
+    m_window->attachScene(object);
+}
+
+void SceneIncubator::statusChanged(Status status)
+{
+    if(status == QQmlIncubator::Ready) {
+        m_window->finalizeScene(object());
+    }
+    else if(status == QQmlIncubator::Error) {
+        qWarning() << "Failed to create scene:" << errors();
+        Qt3DRaytrace::QRaytraceAspect::endStartupPhase(Qt3DRaytrace::QStartupPhase::SceneLoading);
+    }
+}
+
 Qt3DQuickWindowPrivate::Qt3DQuickWindowPrivate()
     : m_engine(new Qt3DCore::Quick::QQmlAspectEngine)
+    , m_incubationController(new IncubationController)
+    , m_root(new Qt3DCore::QEntity)
     , m_raytraceAspect(new Qt3DRaytrace::QRaytraceAspect)
     , m_inputAspect(new Qt3DInput::QInputAspect)
     , m_logicAspect(new Qt3DLogic::QLogicAspect)
@@ -21,6 +74,88 @@ Qt3DQuickWindowPrivate::Qt3DQuickWindowPrivate()
     , m_initialized(false)
 {}
 
+Qt3DQuickWindowPrivate::~Qt3DQuickWindowPrivate()
+{
+    unloadScene();
+    if(!m_initialized) {
+        delete m_root;
+    }
+}
+
+void Qt3DQuickWindowPrivate::loadScene()
+{
+    Q_Q(Qt3DQuickWindow);
+
+    unloadScene();
+    if(m_source.isEmpty()) {
+        return;
+    }
+
+    Qt3DRaytrace::QRaytraceAspect::beginStartupPhase(Qt3DRaytrace::QStartupPhase::SceneLoading);
+
+    m_component.reset(new QQmlComponent(m_engine->qmlEngine(), m_source, QQmlComponent::Asynchronous));
+    if(m_component->isLoading()) {
+        QObject::connect(m_component.get(), &QQmlComponent::statusChanged, q, [this]() { createScene(); });
+    }
+    else {
+        createScene();
+    }
+}
+
+void Qt3DQuickWindowPrivate::unloadScene()
+{
+    if(m_incubator) {
+        m_incubator->clear();
+        m_incubator.reset();
+    }
+    delete m_scene.data();
+    m_component.reset();
+}
+
+void Qt3DQuickWindowPrivate::createScene()
+{
+    Q_ASSERT(m_component);
+
+    if(m_component->isLoading()) {
+        return;
+    }
+    if(m_component->isError()) {
+        qWarning() << "Failed to load scene:" << m_component->errors();
+        Qt3DRaytrace::QRaytraceAspect::endStartupPhase(Qt3DRaytrace::QStartupPhase::SceneLoading);
+        return;
+    }
+
+    // QML source is loaded asynchronously, but Qt 5 incubation still builds the whole object tree in a single step;
+    // only binding evaluation & component completion are spread over time slices. The scene root is attached as soon
+    // as that tree exists, before its bindings are complete.
+    m_incubator.reset(new SceneIncubator(this));
+    m_component->create(*m_incubator, m_engine->qmlEngine()->rootContext());
+}
+
+void Qt3DQuickWindowPrivate::attachScene(QObject *object)
+{
+    Qt3DCore::QEntity *scene = qobject_cast<Qt3DCore::QEntity*>(object);
+    if(scene) {
+        scene->setParent(m_root);
+        m_scene = scene;
+    }
+    else {
+        qWarning() << "Scene root object must be an Entity";
+    }
+}
+
+void Qt3DQuickWindowPrivate::finalizeScene(QObject *object)
+{
+    Q_Q(Qt3DQuickWindow);
+    Qt3DRaytrace::QRaytraceAspect::endStartupPhase(Qt3DRaytrace::QStartupPhase::SceneLoading);
+    if(m_scene && m_scene == object) {
+        q->sceneCreated(object);
+    }
+    else {
+        delete object;
+    }
+}
+
 Qt3DQuickWindow::Qt3DQuickWindow(QWindow *parent)
     : QWindow(*new Qt3DQuickWindowPrivate, parent)
 {
@@ -77,6 +212,27 @@ void Qt3DQuickWindow::setSource(const QUrl &source)
 {
     Q_D(Qt3DQuickWindow);
     d->m_source = source;
+    if(d->m_initialized) {
+        reload();
+    }
+}
+
+QUrl Qt3DQuickWindow::source() const
+{
+    Q_D(const Qt3DQuickWindow);
+    return d->m_source;
+}
+
+void Qt3DQuickWindow::reload()
+{
+    Q_D(Qt3DQuickWindow);
+    if(d->m_initialized) {
+        // Drop cached QML components so that edited files are parsed again. Scene assets (meshes & textures)
+        // are reused by the raytrace aspect if their source files have not changed.
+        d->m_engine->qmlEngine()->clearComponentCache();
+        Qt3DRaytrace::QRaytraceAspect::restartStartupTiming();
+        d->loadScene();
+    }
 }
 
 Qt3DCore::Quick::QQmlAspectEngine *Qt3DQuickWindow::engine() const
@@ -128,10 +284,10 @@ void Qt3DQuickWindow::showEvent(QShowEvent *event)
     QWindow::showEvent(event);
 
     if(!d->m_initialized) {
-        connect(d->m_engine.get(), &Qt3DCore::Quick::QQmlAspectEngine::sceneCreated, this, &Qt3DQuickWindow::sceneCreated);
-        d->m_engine->setSource(d->m_source);
-        // TODO: Setup incubation controller.
+        d->m_engine->qmlEngine()->setIncubationController(d->m_incubationController.get());
+        d->m_engine->aspectEngine()->setRootEntity(Qt3DCore::QEntityPtr(d->m_root));
         d->m_initialized = true;
+        d->loadScene();
     }
 }
 
@@ -150,6 +306,8 @@ void Qt3DQuickWindow::sceneCreated(QObject *root)
     if(inputSettings) {
         inputSettings->setEventSource(this);
     }
+
+    emit sceneLoaded(qobject_cast<Qt3DCore::QEntity*>(root));
 }
 
 void Qt3DQuickWindow::updateCameraAspectRatio()
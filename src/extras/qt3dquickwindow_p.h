@@ -17,19 +17,66 @@
 #include <Qt3DRaytrace/qraytraceaspect.h>
 #include <Qt3DRaytrace/qcamera.h>
 
+#include <QQmlComponent>
+#include <QQmlIncubator>
+#include <QQmlIncubationController>
+
+#include <QBasicTimer>
 #include <QPointer>
 #include <QScopedPointer>
 
 namespace Qt3DRaytraceExtras {
 namespace Quick {
 
+class Qt3DQuickWindowPrivate;
+
+// Drives asynchronous QML incubation in small time slices on the GUI thread.
+class IncubationController final : public QObject, public QQmlIncubationController
+{
+public:
+    explicit IncubationController(QObject *parent = nullptr);
+
+protected:
+    void incubatingObjectCountChanged(int count) override;
+    void timerEvent(QTimerEvent *event) override;
+
+private:
+    QBasicTimer m_timer;
+};
+
+class SceneIncubator final : public QQmlIncubator
+{
+public:
+    explicit SceneIncubator(Qt3DQuickWindowPrivate *window);
+
+protected:
+    void setInitialState(QObject *object) override;
+    void statusChanged(Status status) override;
+
+private:
+    Qt3DQuickWindowPrivate *m_window;
+};
+
 class Qt3DQuickWindowPrivate : public QWindowPrivate
 {
     Q_DECLARE_PUBLIC(Qt3DQuickWindow)
 public:
     Qt3DQuickWindowPrivate();
+    ~Qt3DQuickWindowPrivate();
+
+    void loadScene();
+    void unloadScene();
+    void createScene();
+    void attachScene(QObject *object);
+    void finalizeScene(QObject *object);
 
     QScopedPointer<Qt3DCore::Quick::QQmlAspectEngine> m_engine;
+    QScopedPointer<IncubationController> m_incubationController;
+    QScopedPointer<QQmlComponent> m_component;
+    QScopedPointer<SceneIncubator> m_incubator;
+
+    Qt3DCore::QEntity *m_root;
+    QPointer<Qt3DCore::QEntity> m_scene;
 
     Qt3DRaytrace::QRaytraceAspect *m_raytraceAspect;
     Qt3DInput::QInputAspect *m_inputAspect;
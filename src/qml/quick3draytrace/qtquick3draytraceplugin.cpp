@@ -19,6 +19,7 @@
 #include <Qt3DRaytrace/qcamera.h>
 #include <Qt3DRaytrace/qcameralens.h>
 #include <Qt3DRaytrace/qrendersettings.h>
+#include <Qt3DRaytrace/qsceneloader.h>
 
 void Qt3DQuick3DRaytracePlugin::registerTypes(const char *uri)
 {
@@ -50,6 +51,9 @@ void Qt3DQuick3DRaytracePlugin::registerTypes(const char *uri)
     // Settings
     qmlRegisterType<Qt3DRaytrace::QRenderSettings>(uri, 1, 0, "RenderSettings");
 
+    // Scene
+    qmlRegisterType<Qt3DRaytrace::QSceneLoader>(uri, 1, 0, "SceneLoader");
+
     // Module
     qmlRegisterModule(uri, 1, 0);
 }
@@ -9,6 +9,7 @@
 #include <qt3draytrace_global_p.h>
 #include <Qt3DRaytrace/qimagedata.h>
 #include <Qt3DRaytrace/qrenderimage.h>
+#include <Qt3DRaytrace/qrenderstatistics.h>
 
 #include <QVector>
 #include <Qt3DCore/QAspectJob>
@@ -15,6 +15,12 @@ BackendNode::BackendNode(QBackendNode::Mode mode)
     : QBackendNode(mode)
 {}
 
+void BackendNode::sceneChangeEvent(const QSceneChangePtr &change)
+{
+    SceneChangeRecorder::recordSceneChange(change);
+    QBackendNode::sceneChangeEvent(change);
+}
+
 void BackendNode::markDirty(AbstractRenderer::DirtySet changes)
 {
     Q_ASSERT(m_renderer);
@@ -8,6 +8,8 @@
 
 #include <qt3draytrace_global_p.h>
 #include <backend/abstractrenderer_p.h>
+#include <replay/scenechangerecorder_p.h>
+#include <utility/startuptiming.h>
 
 #include <Qt3DCore/QBackendNode>
 
@@ -25,6 +27,7 @@ public:
     }
 
 protected:
+    void sceneChangeEvent(const Qt3DCore::QSceneChangePtr &change) override;
     void markDirty(AbstractRenderer::DirtySet changes);
 
     AbstractRenderer *m_renderer = nullptr;
@@ -41,6 +44,8 @@ public:
 
     virtual Qt3DCore::QBackendNode *create(const Qt3DCore::QNodeCreatedChangeBasePtr &change) const override
     {
+        Utility::StartupPhaseScope startupPhase(QStartupPhase::NodeCreation);
+        SceneChangeRecorder::recordNodeCreated(change);
         BackendNodeType *backendNode = m_manager->getOrCreateResource(change->subjectId());
         backendNode->setRenderer(m_renderer);
         return backendNode;
@@ -53,6 +58,7 @@ public:
 
     void destroy(Qt3DCore::QNodeId id) const override
     {
+        SceneChangeRecorder::recordNodeDestroyed(id);
         m_manager->releaseResource(id);
     }
 
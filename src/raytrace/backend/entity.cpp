@@ -31,6 +31,8 @@ EntityMapper::EntityMapper(NodeManagers *managers, AbstractRenderer *renderer)
 
 QBackendNode *EntityMapper::create(const Qt3DCore::QNodeCreatedChangeBasePtr &change) const
 {
+    SceneChangeRecorder::recordNodeCreated(change);
+
     EntityManager &entityManager = m_nodeManagers->entityManager;
     HEntity entityHandle = entityManager.getOrAcquireHandle(change->subjectId());
     Entity *entity = entityManager.data(entityHandle);
@@ -49,6 +51,7 @@ QBackendNode *EntityMapper::get(Qt3DCore::QNodeId id) const
 void EntityMapper::destroy(Qt3DCore::QNodeId id) const
 {
     Q_ASSERT(m_nodeManagers);
+    SceneChangeRecorder::recordNodeDestroyed(id);
     m_nodeManagers->entityManager.releaseResource(id);
 }
 
@@ -15,6 +15,11 @@ using namespace Qt3DCore;
 namespace Qt3DRaytrace {
 namespace Raytrace {
 
+static qint64 payloadSize(const QGeometryData &data)
+{
+    return qint64(data.vertices.size()) * qint64(sizeof(QVertex)) + qint64(data.faces.size()) * qint64(sizeof(QTriangle));
+}
+
 void Geometry::setManager(GeometryManager *manager)
 {
     Q_ASSERT(manager);
@@ -26,7 +31,7 @@ void Geometry::sceneChangeEvent(const QSceneChangePtr &change)
     if(change->type() == PropertyUpdated) {
         QPropertyUpdatedChangePtr propertyChange = qSharedPointerCast<QPropertyUpdatedChange>(change);
         if(propertyChange->propertyName() == QByteArrayLiteral("data")) {
-            m_data = propertyChange->value().value<QGeometryData>();
+            setData(propertyChange->value().value<QGeometryData>());
             if(m_manager) {
                 m_manager->markComponentDirty(peerId());
             }
@@ -39,7 +44,7 @@ void Geometry::sceneChangeEvent(const QSceneChangePtr &change)
 void Geometry::initializeFromPeer(const QNodeCreatedChangeBasePtr &change)
 {
     const auto typedChange = qSharedPointerCast<Qt3DCore::QNodeCreatedChange<QGeometryData>>(change);
-    m_data = typedChange->data;
+    setData(typedChange->data);
 
     if(m_manager) {
         m_manager->markComponentDirty(peerId());
@@ -47,5 +52,26 @@ void Geometry::initializeFromPeer(const QNodeCreatedChangeBasePtr &change)
     markDirty(AbstractRenderer::GeometryDirty);
 }
 
+void Geometry::clearData()
+{
+    setData(QGeometryData());
+}
+
+void Geometry::setData(const QGeometryData &data)
+{
+    if(m_manager) {
+        m_manager->addPayloadBytes(payloadSize(data) - payloadSize(m_data));
+    }
+    m_data = data;
+}
+
+void GeometryNodeMapper::destroy(QNodeId id) const
+{
+    if(Geometry *geometry = m_manager->lookupResource(id)) {
+        geometry->clearData();
+    }
+    BackendNodeMapper::destroy(id);
+}
+
 } // Raytrace
 } // Qt3DRaytrace
@@ -24,10 +24,12 @@ public:
     const QVector<QTriangle> &faces() const { return m_data.faces; }
 
     void setManager(GeometryManager *manager);
+    void clearData();
     void sceneChangeEvent(const Qt3DCore::QSceneChangePtr &change) override;
 
 private:
     void initializeFromPeer(const Qt3DCore::QNodeCreatedChangeBasePtr &change) override;
+    void setData(const QGeometryData &data);
 
     GeometryManager *m_manager = nullptr;
     QGeometryData m_data;
@@ -46,6 +48,8 @@ public:
         geometry->setManager(m_manager);
         return geometry;
     }
+
+    void destroy(Qt3DCore::QNodeId id) const override;
 };
 
 } // Raytrace
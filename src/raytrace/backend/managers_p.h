@@ -18,7 +18,10 @@
 #include <backend/distantlight_p.h>
 #include <backend/cameralens_p.h>
 
+#include <utility/latencyhistogram.h>
+
 #include <QVector>
+#include <QAtomicInteger>
 
 namespace Qt3DRaytrace {
 namespace Raytrace {
@@ -60,11 +63,38 @@ private:
     QVector<Qt3DCore::QNodeId> m_dirtyComponents;
 };
 
+class PayloadCounter
+{
+public:
+    void addPayloadBytes(qint64 bytes) { m_payloadBytes.fetchAndAddRelaxed(bytes); }
+    qint64 payloadBytes() const { return m_payloadBytes.load(); }
+
+private:
+    QAtomicInteger<qint64> m_payloadBytes;
+};
+
+class PendingLoadCounter
+{
+public:
+    void addPendingLoads(int count) { m_numPendingLoads.fetchAndAddRelaxed(count); }
+    void finishPendingLoad(double loadTime)
+    {
+        m_numPendingLoads.fetchAndSubRelaxed(1);
+        m_loadTimes.add(loadTime);
+    }
+    int numPendingLoads() const { return m_numPendingLoads.load(); }
+    const Utility::LatencyHistogram &loadTimes() const { return m_loadTimes; }
+
+private:
+    QAtomicInt m_numPendingLoads;
+    Utility::LatencyHistogram m_loadTimes;
+};
+
 class TransformManager : public Qt3DCore::QResourceManager<Transform, Qt3DCore::QNodeId> {};
-class GeometryManager : public ComponentManager<Geometry> {};
-class GeometryRendererManager : public ComponentManager<GeometryRenderer> {};
-class TextureManager : public ComponentManager<AbstractTexture> {};
-class TextureImageManager : public ComponentManager<TextureImage> {};
+class GeometryManager : public ComponentManager<Geometry>, public PayloadCounter {};
+class GeometryRendererManager : public ComponentManager<GeometryRenderer>, public PendingLoadCounter {};
+class TextureManager : public ComponentManager<AbstractTexture>, public PendingLoadCounter {};
+class TextureImageManager : public ComponentManager<TextureImage>, public PayloadCounter {};
 class MaterialManager : public ComponentManager<Material> {};
 class DistantLightManager : public ComponentManager<DistantLight> {};
 class CameraManager : public ComponentManager<CameraLens> {};
@@ -53,6 +53,9 @@ void RenderSettings::sceneChangeEvent(const QSceneChangePtr &change)
         else if(propertyChange->propertyName() == QByteArrayLiteral("maxDepth")) {
             m_maxDepth = propertyChange->value().value<unsigned int>();
         }
+        else if(propertyChange->propertyName() == QByteArrayLiteral("randomSeed")) {
+            m_randomSeed = static_cast<unsigned int>(propertyChange->value().value<int>());
+        }
         else if(propertyChange->propertyName() == QByteArrayLiteral("directRadianceClamp")) {
             m_directRadianceClamp = propertyChange->value().value<float>();
         }
@@ -87,6 +90,7 @@ void RenderSettings::initializeFromPeer(const QNodeCreatedChangeBasePtr &change)
     m_secondarySamples = static_cast<unsigned int>(data.secondarySamples);
     m_minDepth = static_cast<unsigned int>(data.minDepth);
     m_maxDepth = static_cast<unsigned int>(data.maxDepth);
+    m_randomSeed = static_cast<unsigned int>(data.randomSeed);
     m_directRadianceClamp = data.directRadianceClamp;
     m_indirectRadianceClamp = data.indirectRadianceClamp;
 
@@ -100,7 +104,7 @@ void RenderSettings::initializeFromPeer(const QNodeCreatedChangeBasePtr &change)
 
 QBackendNode *RenderSettingsMapper::create(const QNodeCreatedChangeBasePtr &change) const
 {
-    Q_UNUSED(change);
+    SceneChangeRecorder::recordNodeCreated(change);
 
     if(m_renderer->settings() != nullptr) {
         qCWarning(logAspect) << "RenderSettings component already exists";
@@ -121,7 +125,8 @@ QBackendNode *RenderSettingsMapper::get(QNodeId id) const
 
 void RenderSettingsMapper::destroy(QNodeId id) const
 {
-    Q_UNUSED(id);
+    SceneChangeRecorder::recordNodeDestroyed(id);
+
     RenderSettings *settings = m_renderer->settings();
     m_renderer->setSettings(nullptr);
     delete settings;
@@ -26,6 +26,7 @@ public:
     unsigned int secondarySamples() const { return m_secondarySamples; }
     unsigned int minDepth() const { return m_minDepth; }
     unsigned int maxDepth() const { return m_maxDepth; }
+    unsigned int randomSeed() const { return m_randomSeed; }
 
     float directRadianceClamp() const;
     float indirectRadianceClamp() const;
@@ -49,6 +50,7 @@ private:
     unsigned int m_secondarySamples;
     unsigned int m_minDepth;
     unsigned int m_maxDepth;
+    unsigned int m_randomSeed;
     float m_directRadianceClamp;
     float m_indirectRadianceClamp;
     QColor m_skyColor;
@@ -15,6 +15,11 @@ using namespace Qt3DCore;
 namespace Qt3DRaytrace {
 namespace Raytrace {
 
+static qint64 payloadSize(const QImageData &data)
+{
+    return qint64(data.data.size());
+}
+
 void TextureImage::setManager(TextureImageManager *manager)
 {
     Q_ASSERT(manager);
@@ -26,7 +31,7 @@ void TextureImage::sceneChangeEvent(const QSceneChangePtr &change)
     if(change->type() == PropertyUpdated) {
         QPropertyUpdatedChangePtr propertyChange = qSharedPointerCast<QPropertyUpdatedChange>(change);
         if(propertyChange->propertyName() == QByteArrayLiteral("data")) {
-            m_data = propertyChange->value().value<QImageData>();
+            setData(propertyChange->value().value<QImageData>());
             if(m_manager) {
                 m_manager->markComponentDirty(peerId());
             }
@@ -39,7 +44,7 @@ void TextureImage::sceneChangeEvent(const QSceneChangePtr &change)
 void TextureImage::initializeFromPeer(const QNodeCreatedChangeBasePtr &change)
 {
     const auto typedChange = qSharedPointerCast<Qt3DCore::QNodeCreatedChange<QImageData>>(change);
-    m_data = typedChange->data;
+    setData(typedChange->data);
 
     if(m_manager) {
         m_manager->markComponentDirty(peerId());
@@ -47,5 +52,26 @@ void TextureImage::initializeFromPeer(const QNodeCreatedChangeBasePtr &change)
     markDirty(AbstractRenderer::TextureDirty);
 }
 
+void TextureImage::clearData()
+{
+    setData(QImageData());
+}
+
+void TextureImage::setData(const QImageData &data)
+{
+    if(m_manager) {
+        m_manager->addPayloadBytes(payloadSize(data) - payloadSize(m_data));
+    }
+    m_data = data;
+}
+
+void TextureImageNodeMapper::destroy(QNodeId id) const
+{
+    if(TextureImage *textureImage = m_manager->lookupResource(id)) {
+        textureImage->clearData();
+    }
+    BackendNodeMapper::destroy(id);
+}
+
 } // Raytrace
 } // Qt3DRaytrace
@@ -22,10 +22,12 @@ public:
     const QImageData &data() const { return m_data; }
 
     void setManager(TextureImageManager *manager);
+    void clearData();
     void sceneChangeEvent(const Qt3DCore::QSceneChangePtr &change) override;
 
 private:
     void initializeFromPeer(const Qt3DCore::QNodeCreatedChangeBasePtr &change) override;
+    void setData(const QImageData &data);
 
     TextureImageManager *m_manager = nullptr;
     QImageData m_data;
@@ -44,6 +46,8 @@ public:
         textureImage->setManager(m_manager);
         return textureImage;
     }
+
+    void destroy(Qt3DCore::QNodeId id) const override;
 };
 
 } // Raytrace
@@ -6,6 +6,8 @@
 
 #include <frontend/qmesh_p.h>
 #include <io/defaultmeshimporter_p.h>
+#include <io/binarymeshimporter_p.h>
+#include <io/assetcache_p.h>
 
 using namespace Qt3DCore;
 
@@ -45,9 +47,15 @@ void QMesh::setSource(const QUrl &source)
 }
 
 MeshLoader::MeshLoader(const QMesh *mesh)
-    : m_importer(new Raytrace::DefaultMeshImporter)
-    , m_source(mesh->source())
-{}
+    : m_source(mesh->source())
+{
+    if(Raytrace::BinaryMeshImporter::canImport(m_source)) {
+        m_importer.reset(new Raytrace::BinaryMeshImporter);
+    }
+    else {
+        m_importer.reset(new Raytrace::DefaultMeshImporter);
+    }
+}
 
 QGeometry *MeshLoader::create()
 {
@@ -59,14 +67,20 @@ QGeometry *MeshLoader::create()
     }
 
     QGeometryData geometryData;
-    if(m_importer->import(m_source, geometryData)) {
-        QGeometry *geometry = new QGeometry;
-        geometry->setData(geometryData);
-        return geometry;
+    QDateTime lastModified;
+    if(Raytrace::AssetCache::instance()->findGeometry(m_source, geometryData, lastModified)) {
+        qCInfo(logImport) << "Reusing cached mesh:" << m_source.toString();
+    }
+    else if(m_importer->import(m_source, geometryData)) {
+        Raytrace::AssetCache::instance()->insertGeometry(m_source, lastModified, geometryData);
     }
     else {
         return nullptr;
     }
+
+    QGeometry *geometry = new QGeometry;
+    geometry->setData(geometryData);
+    return geometry;
 }
 
 } // Qt3DRaytrace
@@ -50,6 +50,12 @@ int QRenderSettings::maxDepth() const
     return d->m_settings.maxDepth;
 }
 
+int QRenderSettings::randomSeed() const
+{
+    Q_D(const QRenderSettings);
+    return d->m_settings.randomSeed;
+}
+
 float QRenderSettings::directRadianceClamp() const
 {
     Q_D(const QRenderSettings);
@@ -145,6 +151,15 @@ void QRenderSettings::setMaxDepth(int maxDepth)
     }
 }
 
+void QRenderSettings::setRandomSeed(int seed)
+{
+    Q_D(QRenderSettings);
+    if(d->m_settings.randomSeed != seed) {
+        d->m_settings.randomSeed = seed;
+        emit randomSeedChanged(seed);
+    }
+}
+
 void QRenderSettings::setDirectRadianceClamp(float clamp)
 {
     Q_D(QRenderSettings);
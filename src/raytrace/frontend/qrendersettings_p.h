@@ -20,6 +20,7 @@ struct QRenderSettingsData
     int secondarySamples = 1;
     int minDepth = 1;
     int maxDepth = 3;
+    int randomSeed = 0;
 
     float directRadianceClamp = 0.0f;
     float indirectRadianceClamp = 0.0f;
@@ -0,0 +1,159 @@
+/*
+ * Copyright (C) 2018-2019 Michał Siejak
+ * This file is part of Quartz - a raytracing aspect for Qt3D.
+ * See LICENSE file for licensing information.
+ */
+
+#include <frontend/qsceneloader_p.h>
+#include <io/binarysceneimporter_p.h>
+
+#include <Qt3DRaytrace/qmesh.h>
+#include <Qt3DRaytrace/qmaterial.h>
+#include <Qt3DRaytrace/qtexture.h>
+#include <Qt3DRaytrace/qcolorspace.h>
+
+#include <Qt3DCore/QTransform>
+#include <QMatrix4x4>
+
+using namespace Qt3DCore;
+
+namespace Qt3DRaytrace {
+
+QSceneLoader::QSceneLoader(QNode *parent)
+    : QSceneLoader(*new QSceneLoaderPrivate, parent)
+{}
+
+QSceneLoader::QSceneLoader(QSceneLoaderPrivate &dd, QNode *parent)
+    : QEntity(dd, parent)
+{}
+
+QUrl QSceneLoader::source() const
+{
+    Q_D(const QSceneLoader);
+    return d->m_source;
+}
+
+QSceneLoader::Status QSceneLoader::status() const
+{
+    Q_D(const QSceneLoader);
+    return d->m_status;
+}
+
+void QSceneLoader::setSource(const QUrl &source)
+{
+    Q_D(QSceneLoader);
+    if(d->m_source != source) {
+        d->m_source = source;
+        d->loadScene();
+        emit sourceChanged(source);
+    }
+}
+
+void QSceneLoaderPrivate::setStatus(QSceneLoader::Status status)
+{
+    Q_Q(QSceneLoader);
+    if(m_status != status) {
+        m_status = status;
+        emit q->statusChanged(status);
+    }
+}
+
+void QSceneLoaderPrivate::loadScene()
+{
+    Q_Q(QSceneLoader);
+
+    delete m_scene.data();
+    if(m_source.isEmpty()) {
+        setStatus(QSceneLoader::None);
+        return;
+    }
+
+    setStatus(QSceneLoader::Loading);
+
+    Raytrace::SceneData sceneData;
+    Raytrace::BinarySceneImporter importer;
+    if(!importer.import(m_source, sceneData)) {
+        setStatus(QSceneLoader::Error);
+        return;
+    }
+
+    // Whole subtree is built while detached and attached with a single reparent,
+    // so that node creation changes for all of its nodes are sent to the backend in one batch.
+    m_scene = createScene(sceneData);
+    m_scene->setParent(q);
+    setStatus(QSceneLoader::Ready);
+}
+
+QEntity *QSceneLoaderPrivate::createScene(const Raytrace::SceneData &data) const
+{
+    auto toColor = [&data](const float *c) -> QColor {
+        const QColor color = QColor::fromRgbF(qreal(c[0]), qreal(c[1]), qreal(c[2]));
+        return data.linearColors ? to_sRgb(color) : color;
+    };
+
+    QEntity *scene = new QEntity;
+
+    QVector<QTexture*> textures;
+    textures.reserve(data.textures.size());
+    for(const Raytrace::SceneData::Texture &textureData : data.textures) {
+        QTexture *texture = new QTexture(scene);
+        texture->setSource(m_source.resolved(QUrl(textureData.source)));
+        textures.append(texture);
+    }
+
+    QVector<QMaterial*> materials;
+    materials.reserve(data.materials.size());
+    for(const Raytrace::SceneData::Material &materialData : data.materials) {
+        QMaterial *material = new QMaterial(scene);
+        material->setObjectName(materialData.name);
+        material->setAlbedo(toColor(materialData.albedo));
+        material->setRoughness(materialData.roughness);
+        material->setMetalness(materialData.metalness);
+        material->setEmission(toColor(materialData.emission));
+        material->setEmissionIntensity(materialData.emissionIntensity);
+        if(materialData.albedoTexture >= 0) {
+            material->setAlbedoTexture(textures[materialData.albedoTexture]);
+        }
+        if(materialData.roughnessTexture >= 0) {
+            material->setRoughnessTexture(textures[materialData.roughnessTexture]);
+        }
+        if(materialData.metalnessTexture >= 0) {
+            material->setMetalnessTexture(textures[materialData.metalnessTexture]);
+        }
+        materials.append(material);
+    }
+
+    QVector<QMesh*> meshes;
+    meshes.reserve(data.meshes.size());
+    for(const Raytrace::SceneData::Mesh &meshData : data.meshes) {
+        QMesh *mesh = new QMesh(scene);
+        mesh->setObjectName(meshData.name);
+        mesh->setSource(m_source.resolved(QUrl(meshData.source)));
+        meshes.append(mesh);
+    }
+
+    QVector<QEntity*> entities;
+    entities.reserve(data.entities.size());
+    for(const Raytrace::SceneData::Entity &entityData : data.entities) {
+        QEntity *entity = new QEntity(entityData.parent >= 0 ? entities[entityData.parent] : scene);
+        entity->setObjectName(entityData.name);
+
+        const QMatrix4x4 matrix(entityData.matrix);
+        if(!matrix.isIdentity()) {
+            QTransform *transform = new QTransform(entity);
+            transform->setMatrix(matrix);
+            entity->addComponent(transform);
+        }
+        if(entityData.mesh >= 0) {
+            entity->addComponent(meshes[entityData.mesh]);
+        }
+        if(entityData.material >= 0) {
+            entity->addComponent(materials[entityData.material]);
+        }
+        entities.append(entity);
+    }
+
+    return scene;
+}
+
+} // Qt3DRaytrace
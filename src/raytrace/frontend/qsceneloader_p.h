@@ -0,0 +1,34 @@
+/*
+ * Copyright (C) 2018-2019 Michał Siejak
+ * This file is part of Quartz - a raytracing aspect for Qt3D.
+ * See LICENSE file for licensing information.
+ */
+
+#pragma once
+
+#include <Qt3DRaytrace/qsceneloader.h>
+#include <Qt3DCore/private/qentity_p.h>
+
+#include <QPointer>
+
+namespace Qt3DRaytrace {
+
+namespace Raytrace {
+struct SceneData;
+} // Raytrace
+
+class QSceneLoaderPrivate : public Qt3DCore::QEntityPrivate
+{
+public:
+    Q_DECLARE_PUBLIC(QSceneLoader)
+
+    void setStatus(QSceneLoader::Status status);
+    void loadScene();
+    Qt3DCore::QEntity *createScene(const Raytrace::SceneData &data) const;
+
+    QUrl m_source;
+    QSceneLoader::Status m_status = QSceneLoader::None;
+    QPointer<Qt3DCore::QEntity> m_scene;
+};
+
+} // Qt3DRaytrace
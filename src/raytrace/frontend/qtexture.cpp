@@ -6,6 +6,7 @@
 
 #include <frontend/qtexture_p.h>
 #include <io/defaultimageimporter_p.h>
+#include <io/assetcache_p.h>
 
 using namespace Qt3DCore;
 
@@ -59,14 +60,20 @@ QTextureImage *TextureImageLoader::create()
     }
 
     QImageData imageData;
-    if(m_importer->import(m_source, imageData)) {
-        QTextureImage *image = new QTextureImage;
-        image->setData(imageData);
-        return image;
+    QDateTime lastModified;
+    if(Raytrace::AssetCache::instance()->findImage(m_source, imageData, lastModified)) {
+        qCInfo(logImport) << "Reusing cached texture image:" << m_source.toString();
+    }
+    else if(m_importer->import(m_source, imageData)) {
+        Raytrace::AssetCache::instance()->insertImage(m_source, lastModified, imageData);
     }
     else {
         return nullptr;
     }
+
+    QTextureImage *image = new QTextureImage;
+    image->setData(imageData);
+    return image;
 }
 
 } // Qt3DRaytrace
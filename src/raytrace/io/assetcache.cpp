@@ -0,0 +1,131 @@
+/*
+ * Copyright (C) 2018-2019 Michał Siejak
+ * This file is part of Quartz - a raytracing aspect for Qt3D.
+ * See LICENSE file for licensing information.
+ */
+
+#include <io/common_p.h>
+#include <io/assetcache_p.h>
+
+#include <QFileInfo>
+#include <QMutexLocker>
+
+#include <algorithm>
+#include <limits>
+
+namespace Qt3DRaytrace {
+namespace Raytrace {
+
+namespace Config {
+static constexpr qint64 DefaultMaxCacheSize = qint64(2) * 1024 * 1024 * 1024;
+static constexpr qint64 CostUnit = 1024;
+} // Config
+
+Q_GLOBAL_STATIC(AssetCache, g_assetCache)
+
+static QString geometryKey(const QUrl &url)
+{
+    return QStringLiteral("geometry:") + url.toString();
+}
+
+static QString imageKey(const QUrl &url)
+{
+    return QStringLiteral("image:") + url.toString();
+}
+
+static int costFromSize(qint64 size)
+{
+    return int(std::min<qint64>(size / Config::CostUnit + 1, std::numeric_limits<int>::max()));
+}
+
+AssetCache::AssetCache()
+{
+    m_entries.setMaxCost(costFromSize(Config::DefaultMaxCacheSize));
+}
+
+AssetCache *AssetCache::instance()
+{
+    return g_assetCache();
+}
+
+bool AssetCache::findGeometry(const QUrl &url, QGeometryData &data, QDateTime &lastModified)
+{
+    Entry entry;
+    if(find(geometryKey(url), url, entry, lastModified)) {
+        data = entry.geometry;
+        return true;
+    }
+    return false;
+}
+
+void AssetCache::insertGeometry(const QUrl &url, const QDateTime &lastModified, const QGeometryData &data)
+{
+    const qint64 size = data.vertices.size() * qint64(sizeof(QVertex)) + data.faces.size() * qint64(sizeof(QTriangle));
+    insert(geometryKey(url), new Entry{lastModified, data, QImageData()}, size);
+}
+
+bool AssetCache::findImage(const QUrl &url, QImageData &data, QDateTime &lastModified)
+{
+    Entry entry;
+    if(find(imageKey(url), url, entry, lastModified)) {
+        data = entry.image;
+        return true;
+    }
+    return false;
+}
+
+void AssetCache::insertImage(const QUrl &url, const QDateTime &lastModified, const QImageData &data)
+{
+    insert(imageKey(url), new Entry{lastModified, QGeometryData(), data}, data.data.size());
+}
+
+void AssetCache::setMaxSize(qint64 bytes)
+{
+    QMutexLocker lock(&m_mutex);
+    m_entries.setMaxCost(costFromSize(std::max<qint64>(bytes, 0)));
+}
+
+void AssetCache::clear()
+{
+    QMutexLocker lock(&m_mutex);
+    m_entries.clear();
+}
+
+bool AssetCache::queryLastModified(const QUrl &url, QDateTime &lastModified)
+{
+    QFileInfo fileInfo(getAssetPathFromUrl(url));
+    if(!fileInfo.exists()) {
+        return false;
+    }
+    // Note: Resources embedded via qrc have no modification time but can never change at runtime.
+    lastModified = fileInfo.lastModified();
+    return true;
+}
+
+bool AssetCache::find(const QString &key, const QUrl &url, Entry &entry, QDateTime &lastModified)
+{
+    if(!queryLastModified(url, lastModified)) {
+        return false;
+    }
+
+    QMutexLocker lock(&m_mutex);
+    Entry *cachedEntry = m_entries.object(key);
+    if(!cachedEntry) {
+        return false;
+    }
+    if(cachedEntry->lastModified != lastModified) {
+        m_entries.remove(key);
+        return false;
+    }
+    entry = *cachedEntry;
+    return true;
+}
+
+void AssetCache::insert(const QString &key, Entry *entry, qint64 size)
+{
+    QMutexLocker lock(&m_mutex);
+    m_entries.insert(key, entry, costFromSize(size));
+}
+
+} // Raytrace
+} // Qt3DRaytrace
@@ -0,0 +1,59 @@
+/*
+ * Copyright (C) 2018-2019 Michał Siejak
+ * This file is part of Quartz - a raytracing aspect for Qt3D.
+ * See LICENSE file for licensing information.
+ */
+
+#pragma once
+
+#include <qt3draytrace_global_p.h>
+
+#include <Qt3DRaytrace/qgeometrydata.h>
+#include <Qt3DRaytrace/qimagedata.h>
+
+#include <QCache>
+#include <QDateTime>
+#include <QMutex>
+#include <QUrl>
+
+namespace Qt3DRaytrace {
+namespace Raytrace {
+
+// Process-wide cache of imported asset data keyed by source URL and file modification time.
+// Cached data is implicitly shared with scene nodes, so it costs no extra memory while the asset is in use.
+class AssetCache
+{
+public:
+    AssetCache();
+
+    static AssetCache *instance();
+
+    // On a miss, lastModified receives the source file modification time, which must be passed back on insert.
+    // Querying it before import ensures that a file modified during import is not cached as up-to-date.
+    bool findGeometry(const QUrl &url, QGeometryData &data, QDateTime &lastModified);
+    void insertGeometry(const QUrl &url, const QDateTime &lastModified, const QGeometryData &data);
+
+    bool findImage(const QUrl &url, QImageData &data, QDateTime &lastModified);
+    void insertImage(const QUrl &url, const QDateTime &lastModified, const QImageData &data);
+
+    void setMaxSize(qint64 bytes);
+    void clear();
+
+private:
+    struct Entry
+    {
+        QDateTime lastModified;
+        QGeometryData geometry;
+        QImageData image;
+    };
+
+    static bool queryLastModified(const QUrl &url, QDateTime &lastModified);
+    bool find(const QString &key, const QUrl &url, Entry &entry, QDateTime &lastModified);
+    void insert(const QString &key, Entry *entry, qint64 size);
+
+    QCache<QString, Entry> m_entries;
+    QMutex m_mutex;
+};
+
+} // Raytrace
+} // Qt3DRaytrace
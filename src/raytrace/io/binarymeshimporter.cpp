@@ -0,0 +1,137 @@
+/*
+ * Copyright (C) 2018-2019 Michał Siejak
+ * This file is part of Quartz - a raytracing aspect for Qt3D.
+ * See LICENSE file for licensing information.
+ */
+
+#include <io/common_p.h>
+#include <io/binarymeshimporter_p.h>
+#include <io/importstatistics_p.h>
+
+#include <QFile>
+#include <QFileInfo>
+#include <QtEndian>
+#include <QElapsedTimer>
+#include <QScopeGuard>
+
+#include <climits>
+#include <cstring>
+
+namespace Qt3DRaytrace {
+namespace Raytrace {
+
+static constexpr char    BinaryMeshMagic[4] = { 'Q', 'M', 'S', 'H' };
+static constexpr quint32 BinaryMeshVersion = 1;
+static constexpr qint64  BinaryMeshHeaderSize = 16;
+static constexpr qint64  BinaryMeshVertexSize = 11 * sizeof(float);
+static constexpr qint64  BinaryMeshTriangleSize = 3 * sizeof(quint32);
+// QVector allocations (including their header) are limited to 2 GB in Qt 5.
+static constexpr qint64  BinaryMeshMaxArraySize = qint64(INT_MAX) - 64;
+
+static_assert(sizeof(QVertex) == BinaryMeshVertexSize, "QVertex layout must match binary mesh vertex layout");
+static_assert(sizeof(QTriangle) == BinaryMeshTriangleSize, "QTriangle layout must match binary mesh triangle layout");
+
+template<typename T>
+static void convertFromLittleEndian(T *data, int count)
+{
+#if Q_BYTE_ORDER == Q_BIG_ENDIAN
+    quint32 *words = reinterpret_cast<quint32*>(data);
+    const int numWords = count * int(sizeof(T) / sizeof(quint32));
+    for(int i=0; i<numWords; ++i) {
+        words[i] = qFromLittleEndian(words[i]);
+    }
+#else
+    Q_UNUSED(data);
+    Q_UNUSED(count);
+#endif
+}
+
+bool BinaryMeshImporter::canImport(const QUrl &url)
+{
+    return QFileInfo(url.path()).suffix().compare(QStringLiteral("qmesh"), Qt::CaseInsensitive) == 0;
+}
+
+bool BinaryMeshImporter::import(const QUrl &url, QGeometryData &data)
+{
+    QAssetImportRecord record;
+    record.type = QAssetImportRecord::Type::Mesh;
+    record.source = url.toString();
+    record.importer = QStringLiteral("qmesh");
+
+    const bool result = importMesh(url, data, record);
+    if(result) {
+        record.succeeded = true;
+        record.numVertices = quint64(data.vertices.size());
+        record.numIndices = quint64(data.faces.size()) * 3;
+    }
+    ImportStatistics::instance()->addRecord(record);
+    return result;
+}
+
+bool BinaryMeshImporter::importMesh(const QUrl &url, QGeometryData &data, QAssetImportRecord &record)
+{
+    QFile meshFile(getAssetPathFromUrl(url));
+    if(!meshFile.open(QFile::ReadOnly)) {
+        qCCritical(logImport) << "Cannot open mesh file:" << url.toString();
+        return false;
+    }
+
+    qCInfo(logImport) << "Loading mesh:" << url.toString();
+    record.fileSize = meshFile.size();
+
+    QElapsedTimer timer;
+    timer.start();
+
+    uchar header[BinaryMeshHeaderSize];
+    if(meshFile.read(reinterpret_cast<char*>(header), BinaryMeshHeaderSize) != BinaryMeshHeaderSize
+            || std::memcmp(header, BinaryMeshMagic, sizeof(BinaryMeshMagic)) != 0) {
+        qCCritical(logImport) << "Invalid binary mesh file:" << url.toString();
+        return false;
+    }
+
+    const quint32 version = qFromLittleEndian<quint32>(header + 4);
+    const quint32 numVertices = qFromLittleEndian<quint32>(header + 8);
+    const quint32 numTriangles = qFromLittleEndian<quint32>(header + 12);
+    if(version != BinaryMeshVersion) {
+        qCCritical(logImport) << "Unsupported binary mesh file version" << version << "in file:" << url.toString();
+        return false;
+    }
+
+    const qint64 vertexDataSize = qint64(numVertices) * BinaryMeshVertexSize;
+    const qint64 triangleDataSize = qint64(numTriangles) * BinaryMeshTriangleSize;
+    if(vertexDataSize > BinaryMeshMaxArraySize || triangleDataSize > BinaryMeshMaxArraySize) {
+        qCCritical(logImport) << "Binary mesh file is too large:" << url.toString();
+        return false;
+    }
+    if(numVertices == 0 || numTriangles == 0
+            || meshFile.size() != BinaryMeshHeaderSize + vertexDataSize + triangleDataSize) {
+        qCCritical(logImport) << "Invalid binary mesh file:" << url.toString();
+        return false;
+    }
+
+    data.vertices.resize(int(numVertices));
+    data.faces.resize(int(numTriangles));
+    if(meshFile.read(reinterpret_cast<char*>(data.vertices.data()), vertexDataSize) != vertexDataSize
+            || meshFile.read(reinterpret_cast<char*>(data.faces.data()), triangleDataSize) != triangleDataSize) {
+        qCCritical(logImport) << "Failed to read binary mesh file:" << url.toString();
+        return false;
+    }
+    record.readTime = timer.nsecsElapsed() * 1e-6;
+
+    // Vertex data is read directly into its final layout, so decoding amounts to byte swapping and validation.
+    timer.restart();
+    auto recordDecodeTime = qScopeGuard([&record, &timer]() { record.decodeTime = timer.nsecsElapsed() * 1e-6; });
+    convertFromLittleEndian(data.vertices.data(), data.vertices.size());
+    convertFromLittleEndian(data.faces.data(), data.faces.size());
+
+    for(const QTriangle &triangle : data.faces) {
+        if(triangle.vertices[0] >= numVertices || triangle.vertices[1] >= numVertices || triangle.vertices[2] >= numVertices) {
+            qCCritical(logImport) << "Invalid vertex index in binary mesh file:" << url.toString();
+            return false;
+        }
+    }
+    return true;
+}
+
+} // Raytrace
+} // Qt3DRaytrace
@@ -0,0 +1,34 @@
+/*
+ * Copyright (C) 2018-2019 Michał Siejak
+ * This file is part of Quartz - a raytracing aspect for Qt3D.
+ * See LICENSE file for licensing information.
+ */
+
+#pragma once
+
+#include <qt3draytrace_global_p.h>
+#include <io/meshimporter_p.h>
+
+#include <Qt3DRaytrace/qassetimportstatistics.h>
+
+namespace Qt3DRaytrace {
+namespace Raytrace {
+
+// Imports meshes stored in Quartz binary mesh format (.qmesh), as written by scene2qml.
+// All values are little-endian:
+//   char[4] magic ("QMSH"), uint32 version, uint32 numVertices, uint32 numTriangles,
+//   numVertices x float[11] (position, normal, tangent, texcoord),
+//   numTriangles x uint32[3] (vertex indices).
+class BinaryMeshImporter final : public MeshImporter
+{
+public:
+    static bool canImport(const QUrl &url);
+
+    bool import(const QUrl &url, QGeometryData &data) override;
+
+private:
+    bool importMesh(const QUrl &url, QGeometryData &data, QAssetImportRecord &record);
+};
+
+} // Raytrace
+} // Qt3DRaytrace
@@ -0,0 +1,163 @@
+/*
+ * Copyright (C) 2018-2019 Michał Siejak
+ * This file is part of Quartz - a raytracing aspect for Qt3D.
+ * See LICENSE file for licensing information.
+ */
+
+#include <io/common_p.h>
+#include <io/binarysceneimporter_p.h>
+
+#include <QFile>
+#include <QDataStream>
+
+namespace Qt3DRaytrace {
+namespace Raytrace {
+
+static constexpr char    BinarySceneMagic[4] = { 'Q', 'S', 'C', 'N' };
+static constexpr quint32 BinarySceneVersion = 1;
+static constexpr quint32 BinarySceneLinearColorsFlag = 0x1;
+
+namespace {
+
+class SceneReader
+{
+public:
+    explicit SceneReader(const QByteArray &data)
+        : m_stream(data)
+    {
+        m_stream.setByteOrder(QDataStream::LittleEndian);
+        m_stream.setFloatingPointPrecision(QDataStream::SinglePrecision);
+    }
+
+    bool ok() const
+    {
+        return m_stream.status() == QDataStream::Ok;
+    }
+
+    template<typename T> T read()
+    {
+        T value = T();
+        m_stream >> value;
+        return value;
+    }
+
+    void read(float *values, int count)
+    {
+        for(int i=0; i<count; ++i) {
+            m_stream >> values[i];
+        }
+    }
+
+    QString readString()
+    {
+        const quint32 length = read<quint32>();
+        if(!ok() || length > quint32(m_stream.device()->bytesAvailable())) {
+            m_stream.setStatus(QDataStream::ReadCorruptData);
+            return QString();
+        }
+        QByteArray bytes(int(length), Qt::Uninitialized);
+        m_stream.readRawData(bytes.data(), int(length));
+        return QString::fromUtf8(bytes);
+    }
+
+    // Guards against allocating huge arrays for corrupted element counts.
+    int readCount(int minElementSize)
+    {
+        const quint32 count = read<quint32>();
+        if(!ok() || qint64(count) * minElementSize > m_stream.device()->bytesAvailable()) {
+            m_stream.setStatus(QDataStream::ReadCorruptData);
+            return 0;
+        }
+        return int(count);
+    }
+
+private:
+    QDataStream m_stream;
+};
+
+} // anonymous
+
+static inline bool isValidReference(qint32 index, int count)
+{
+    return index >= -1 && index < count;
+}
+
+bool BinarySceneImporter::import(const QUrl &url, SceneData &data)
+{
+    QFile sceneFile(getAssetPathFromUrl(url));
+    if(!sceneFile.open(QFile::ReadOnly)) {
+        qCCritical(logImport) << "Cannot open scene file:" << url.toString();
+        return false;
+    }
+
+    qCInfo(logImport) << "Loading scene:" << url.toString();
+
+    const QByteArray sceneBytes = sceneFile.readAll();
+    if(sceneBytes.size() < int(sizeof(BinarySceneMagic)) || !sceneBytes.startsWith(QByteArray(BinarySceneMagic, sizeof(BinarySceneMagic)))) {
+        qCCritical(logImport) << "Invalid binary scene file:" << url.toString();
+        return false;
+    }
+
+    SceneReader reader(sceneBytes.mid(sizeof(BinarySceneMagic)));
+    const quint32 version = reader.read<quint32>();
+    if(version != BinarySceneVersion) {
+        qCCritical(logImport) << "Unsupported binary scene file version" << version << "in file:" << url.toString();
+        return false;
+    }
+    data.linearColors = (reader.read<quint32>() & BinarySceneLinearColorsFlag) != 0;
+
+    data.textures.resize(reader.readCount(4));
+    for(SceneData::Texture &texture : data.textures) {
+        texture.source = reader.readString();
+    }
+
+    data.materials.resize(reader.readCount(52));
+    for(SceneData::Material &material : data.materials) {
+        material.name = reader.readString();
+        reader.read(material.albedo, 3);
+        material.roughness = reader.read<float>();
+        material.metalness = reader.read<float>();
+        reader.read(material.emission, 3);
+        material.emissionIntensity = reader.read<float>();
+        material.albedoTexture = reader.read<qint32>();
+        material.roughnessTexture = reader.read<qint32>();
+        material.metalnessTexture = reader.read<qint32>();
+        if(!isValidReference(material.albedoTexture, data.textures.size())
+                || !isValidReference(material.roughnessTexture, data.textures.size())
+                || !isValidReference(material.metalnessTexture, data.textures.size())) {
+            qCCritical(logImport) << "Invalid texture reference in binary scene file:" << url.toString();
+            return false;
+        }
+    }
+
+    data.meshes.resize(reader.readCount(8));
+    for(SceneData::Mesh &mesh : data.meshes) {
+        mesh.name = reader.readString();
+        mesh.source = reader.readString();
+    }
+
+    data.entities.resize(reader.readCount(80));
+    for(int i=0; i<data.entities.size(); ++i) {
+        SceneData::Entity &entity = data.entities[i];
+        entity.name = reader.readString();
+        entity.parent = reader.read<qint32>();
+        reader.read(entity.matrix, 16);
+        entity.mesh = reader.read<qint32>();
+        entity.material = reader.read<qint32>();
+        if(!isValidReference(entity.parent, i)
+                || !isValidReference(entity.mesh, data.meshes.size())
+                || !isValidReference(entity.material, data.materials.size())) {
+            qCCritical(logImport) << "Invalid entity in binary scene file:" << url.toString();
+            return false;
+        }
+    }
+
+    if(!reader.ok()) {
+        qCCritical(logImport) << "Failed to read binary scene file:" << url.toString();
+        return false;
+    }
+    return true;
+}
+
+} // Raytrace
+} // Qt3DRaytrace
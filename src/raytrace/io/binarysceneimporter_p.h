@@ -0,0 +1,75 @@
+/*
+ * Copyright (C) 2018-2019 Michał Siejak
+ * This file is part of Quartz - a raytracing aspect for Qt3D.
+ * See LICENSE file for licensing information.
+ */
+
+#pragma once
+
+#include <qt3draytrace_global_p.h>
+
+#include <QString>
+#include <QVector>
+#include <QUrl>
+
+namespace Qt3DRaytrace {
+namespace Raytrace {
+
+struct SceneData
+{
+    struct Texture
+    {
+        QString source;
+    };
+    struct Material
+    {
+        QString name;
+        float albedo[3];
+        float roughness;
+        float metalness;
+        float emission[3];
+        float emissionIntensity;
+        qint32 albedoTexture;
+        qint32 roughnessTexture;
+        qint32 metalnessTexture;
+    };
+    struct Mesh
+    {
+        QString name;
+        QString source;
+    };
+    struct Entity
+    {
+        QString name;
+        qint32 parent;
+        float matrix[16];
+        qint32 mesh;
+        qint32 material;
+    };
+
+    bool linearColors = false;
+    QVector<Texture> textures;
+    QVector<Material> materials;
+    QVector<Mesh> meshes;
+    QVector<Entity> entities;
+};
+
+// Imports scene hierarchies stored in Quartz binary scene format (.qscene), as written by scene2qml.
+// All values are little-endian, strings are stored as uint32 byte length followed by UTF-8 data:
+//   char[4] magic ("QSCN"), uint32 version, uint32 flags (bit 0: colors are linear),
+//   uint32 numTextures, numTextures x { string source },
+//   uint32 numMaterials, numMaterials x { string name, float[3] albedo, float roughness, float metalness,
+//                                         float[3] emission, float emissionIntensity,
+//                                         int32 albedoTexture, int32 roughnessTexture, int32 metalnessTexture },
+//   uint32 numMeshes, numMeshes x { string name, string source },
+//   uint32 numEntities, numEntities x { string name, int32 parent, float[16] matrix (row-major), int32 mesh, int32 material }.
+// Entities are stored in pre-order (parents before children); index of -1 denotes no reference.
+// Asset sources are relative to the location of the scene file.
+class BinarySceneImporter
+{
+public:
+    bool import(const QUrl &url, SceneData &data);
+};
+
+} // Raytrace
+} // Qt3DRaytrace
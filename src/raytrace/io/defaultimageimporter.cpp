@@ -6,8 +6,10 @@
 
 #include <io/common_p.h>
 #include <io/defaultimageimporter_p.h>
+#include <io/importstatistics_p.h>
 
 #include <QFile>
+#include <QElapsedTimer>
 
 // NOTE: Qt's own QImage lacks support for HDR formats, hence usage of stb_image.
 // TODO: Implement QImageReader for Radiance RGBE format, and possibly others.
@@ -23,6 +25,23 @@ DefaultImageImporter::DefaultImageImporter()
 
 bool DefaultImageImporter::import(const QUrl &url, QImageData &data)
 {
+    QAssetImportRecord record;
+    record.type = QAssetImportRecord::Type::Image;
+    record.source = url.toString();
+    record.importer = QStringLiteral("stb_image");
+
+    const bool result = importImage(url, data, record);
+    if(result) {
+        record.succeeded = true;
+        record.numTexels = quint64(data.width) * quint64(data.height);
+    }
+    ImportStatistics::instance()->addRecord(record);
+    return result;
+}
+
+bool DefaultImageImporter::importImage(const QUrl &url, QImageData &data, QAssetImportRecord &record)
+{
+    QElapsedTimer timer;
     QByteArray imageBytes;
     {
         QFile imageFile(getAssetPathFromUrl(url));
@@ -32,7 +51,10 @@ bool DefaultImageImporter::import(const QUrl &url, QImageData &data)
         }
 
         qCInfo(logImport) << "Loading texture image:" << url.toString();
+        timer.start();
         imageBytes = imageFile.readAll();
+        record.readTime = timer.nsecsElapsed() * 1e-6;
+        record.fileSize = imageBytes.size();
         if(imageBytes.size() == 0) {
             qCCritical(logImport) << "Failed to read image file:" << url.toString();
             return false;
@@ -49,13 +71,18 @@ bool DefaultImageImporter::import(const QUrl &url, QImageData &data)
     }
 
     if(stbi_is_hdr_from_memory(compressedData, compressedDataSize) == 1) {
+        timer.restart();
         float *image = stbi_loadf_from_memory(compressedData, compressedDataSize, &data.width, &data.height, &data.channels, 0);
+        record.decodeTime = timer.nsecsElapsed() * 1e-6;
         if(image) {
+            timer.restart();
             const int imageSize = data.width * data.height * data.channels * sizeof(float);
             data.format = QImageData::Format::RGB;
             data.type   = QImageData::ValueType::Float32;
             data.data   = QByteArray(reinterpret_cast<const char*>(image), imageSize);
             stbi_image_free(image);
+            record.conversionTime = timer.nsecsElapsed() * 1e-6;
+            record.peakTemporaryMemory = compressedDataSize + qint64(imageSize);
             return true;
         }
     }
@@ -67,13 +94,18 @@ bool DefaultImageImporter::import(const QUrl &url, QImageData &data)
         data.channels = imageChannels;
 
         int numActualChannels;
+        timer.restart();
         stbi_uc *image = stbi_load_from_memory(compressedData, compressedDataSize, &data.width, &data.height, &numActualChannels, imageChannels);
+        record.decodeTime = timer.nsecsElapsed() * 1e-6;
         if(image) {
+            timer.restart();
             const int imageSize = data.width * data.height * data.channels;
             data.format = QImageData::Format::RGBA;
             data.type   = QImageData::ValueType::UInt8;
             data.data   = QByteArray(reinterpret_cast<const char*>(image), imageSize);
             stbi_image_free(image);
+            record.conversionTime = timer.nsecsElapsed() * 1e-6;
+            record.peakTemporaryMemory = compressedDataSize + qint64(imageSize);
             return true;
         }
     }
@@ -9,6 +9,8 @@
 #include <qt3draytrace_global_p.h>
 #include <io/imageimporter_p.h>
 
+#include <Qt3DRaytrace/qassetimportstatistics.h>
+
 namespace Qt3DRaytrace {
 namespace Raytrace {
 
@@ -17,6 +19,9 @@ class DefaultImageImporter final : public ImageImporter
 public:
     DefaultImageImporter();
     bool import(const QUrl &url, QImageData &data) override;
+
+private:
+    bool importImage(const QUrl &url, QImageData &data, QAssetImportRecord &record);
 };
 
 } // Raytrace
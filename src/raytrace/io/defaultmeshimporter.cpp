@@ -6,6 +6,7 @@
 
 #include <io/common_p.h>
 #include <io/defaultmeshimporter_p.h>
+#include <io/importstatistics_p.h>
 
 #include <assimp/scene.h>
 #include <assimp/postprocess.h>
@@ -15,6 +16,7 @@
 
 #include <QFile>
 #include <QFileInfo>
+#include <QElapsedTimer>
 
 #include <QMutex>
 #include <QMutexLocker>
@@ -34,6 +36,38 @@ static constexpr unsigned int ImportFlags =
         aiProcess_FindInvalidData |
         aiProcess_ValidateDataStructure;
 
+// Post-processing steps enabled by ImportFlags, in the order in which Assimp executes them.
+// Applying them one by one is equivalent to a single ReadFile() call but allows each step to be timed.
+struct PostProcessStep
+{
+    unsigned int flag;
+    const char *name;
+};
+
+static constexpr PostProcessStep PostProcessSteps[] = {
+    { aiProcess_ValidateDataStructure, "ValidateDataStructure" },
+    { aiProcess_GenUVCoords, "GenUVCoords" },
+    { aiProcess_TransformUVCoords, "TransformUVCoords" },
+    { aiProcess_PreTransformVertices, "PreTransformVertices" },
+    { aiProcess_Triangulate, "Triangulate" },
+    { aiProcess_SortByPType, "SortByPType" },
+    { aiProcess_FindInvalidData, "FindInvalidData" },
+    { aiProcess_GenNormals, "GenNormals" },
+    { aiProcess_CalcTangentSpace, "CalcTangentSpace" },
+    { aiProcess_JoinIdenticalVertices, "JoinIdenticalVertices" },
+};
+
+static constexpr unsigned int postProcessStepFlags()
+{
+    unsigned int flags = 0;
+    for(const PostProcessStep &step : PostProcessSteps) {
+        flags |= step.flag;
+    }
+    return flags;
+}
+
+static_assert(postProcessStepFlags() == ImportFlags, "PostProcessSteps must list exactly the steps enabled by ImportFlags");
+
 static constexpr QVector3D TangentGenUp{0.0f, 1.0f, 0.0f};
 static constexpr QVector3D TangentGenRight{1.0f, 0.0f, 0.0f};
 static constexpr float     TangentGenLengthThreshold = 0.001f;
@@ -61,6 +95,26 @@ private:
 
 QMutex LogStream::LoggerInitMutex;
 
+static qint64 estimateSceneSize(const aiScene *scene)
+{
+    qint64 size = 0;
+    for(unsigned int i=0; i<scene->mNumMeshes; ++i) {
+        const aiMesh *mesh = scene->mMeshes[i];
+        qint64 vertexSize = sizeof(aiVector3D);
+        if(mesh->HasNormals()) {
+            vertexSize += sizeof(aiVector3D);
+        }
+        if(mesh->HasTangentsAndBitangents()) {
+            vertexSize += 2 * sizeof(aiVector3D);
+        }
+        vertexSize += qint64(mesh->GetNumUVChannels()) * sizeof(aiVector3D);
+        vertexSize += qint64(mesh->GetNumColorChannels()) * sizeof(aiColor4D);
+        size += qint64(mesh->mNumVertices) * vertexSize;
+        size += qint64(mesh->mNumFaces) * (sizeof(aiFace) + 3 * sizeof(unsigned int));
+    }
+    return size;
+}
+
 static bool importScene(const aiScene *scene, QGeometryData &data)
 {
     int totalNumVertices = 0;
@@ -131,29 +185,64 @@ bool DefaultMeshImporter::import(const QUrl &url, QGeometryData &data)
 {
     LogStream::initialize();
 
+    QAssetImportRecord record;
+    record.type = QAssetImportRecord::Type::Mesh;
+    record.source = url.toString();
+    record.importer = QStringLiteral("assimp");
+
+    QElapsedTimer timer;
     const aiScene *scene = nullptr;
     Assimp::Importer importer;
     {
         QFile sceneFile(getAssetPathFromUrl(url));
         if(!sceneFile.open(QFile::ReadOnly)) {
             qCCritical(logImport) << "Cannot open mesh file:" << url.toString();
+            ImportStatistics::instance()->addRecord(record);
             return false;
         }
 
         qCInfo(logImport) << "Loading mesh:" << url.toString();
 
+        timer.start();
         const QByteArray sceneData = sceneFile.readAll();
+        record.readTime = timer.nsecsElapsed() * 1e-6;
+        record.fileSize = sceneData.size();
+
+        timer.restart();
         const QByteArray sceneHint = QFileInfo(url.path()).completeSuffix().toUtf8();
-        scene = importer.ReadFileFromMemory(sceneData.data(), size_t(sceneData.size()), ImportFlags, sceneHint.data());
+        scene = importer.ReadFileFromMemory(sceneData.data(), size_t(sceneData.size()), 0, sceneHint.data());
+        record.decodeTime = timer.nsecsElapsed() * 1e-6;
+
+        for(const PostProcessStep &step : PostProcessSteps) {
+            if(!scene) {
+                break;
+            }
+            timer.restart();
+            scene = importer.ApplyPostProcessing(step.flag);
+            const double stepTime = timer.nsecsElapsed() * 1e-6;
+            record.decodeTime += stepTime;
+            record.steps.append({ QLatin1String(step.name), stepTime });
+        }
+        if(scene) {
+            record.peakTemporaryMemory = sceneData.size() + estimateSceneSize(scene);
+        }
     }
 
     bool result = false;
     if(scene && scene->HasMeshes()) {
+        timer.restart();
         result = importScene(scene, data);
+        record.conversionTime = timer.nsecsElapsed() * 1e-6;
+    }
+    if(result) {
+        record.succeeded = true;
+        record.numVertices = quint64(data.vertices.size());
+        record.numIndices = quint64(data.faces.size()) * 3;
     }
-    if(!result) {
+    else {
         qCCritical(logImport) << "Failed to import mesh from file:" << url.toString();
     }
+    ImportStatistics::instance()->addRecord(record);
     return result;
 }
 
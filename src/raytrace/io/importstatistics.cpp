@@ -0,0 +1,211 @@
+/*
+ * Copyright (C) 2018-2019 Michał Siejak
+ * This file is part of Quartz - a raytracing aspect for Qt3D.
+ * See LICENSE file for licensing information.
+ */
+
+#include <io/importstatistics_p.h>
+
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QMutexLocker>
+#include <QTextStream>
+
+#include <algorithm>
+
+namespace Qt3DRaytrace {
+namespace Raytrace {
+
+namespace Config {
+// Oldest records are discarded once this many imports have been recorded.
+static constexpr int MaxImportRecords = 16384;
+} // Config
+
+Q_GLOBAL_STATIC(ImportStatistics, g_importStatistics)
+
+static QString typeName(QAssetImportRecord::Type type)
+{
+    switch(type) {
+    case QAssetImportRecord::Type::Mesh:
+        return QStringLiteral("mesh");
+    case QAssetImportRecord::Type::Image:
+        return QStringLiteral("image");
+    }
+    return QString();
+}
+
+static const QAssetImportStep *dominantStep(const QAssetImportRecord &record)
+{
+    auto it = std::max_element(record.steps.begin(), record.steps.end(), [](const QAssetImportStep &a, const QAssetImportStep &b) {
+        return a.time < b.time;
+    });
+    return (it != record.steps.end()) ? &(*it) : nullptr;
+}
+
+static QString escapeCsv(const QString &value)
+{
+    if(value.contains(QLatin1Char(',')) || value.contains(QLatin1Char('"'))) {
+        QString escaped = value;
+        escaped.replace(QLatin1Char('"'), QLatin1String("\"\""));
+        return QLatin1Char('"') + escaped + QLatin1Char('"');
+    }
+    return value;
+}
+
+ImportStatistics *ImportStatistics::instance()
+{
+    return g_importStatistics();
+}
+
+void ImportStatistics::addRecord(const QAssetImportRecord &record)
+{
+    if(!isEnabled()) {
+        return;
+    }
+
+    QMutexLocker lock(&m_mutex);
+    if(m_records.size() < Config::MaxImportRecords) {
+        m_records.append(record);
+    }
+    else {
+        m_records[m_oldestRecord] = record;
+        m_oldestRecord = (m_oldestRecord + 1) % Config::MaxImportRecords;
+    }
+}
+
+int ImportStatistics::count() const
+{
+    QMutexLocker lock(&m_mutex);
+    return m_records.size();
+}
+
+QVector<QAssetImportRecord> ImportStatistics::records() const
+{
+    QMutexLocker lock(&m_mutex);
+    if(m_oldestRecord == 0) {
+        return m_records;
+    }
+
+    QVector<QAssetImportRecord> result;
+    result.reserve(m_records.size());
+    for(int i=m_oldestRecord; i<m_records.size(); ++i) {
+        result.append(m_records[i]);
+    }
+    for(int i=0; i<m_oldestRecord; ++i) {
+        result.append(m_records[i]);
+    }
+    return result;
+}
+
+QVector<QAssetImportRecord> ImportStatistics::slowestRecords(int count) const
+{
+    QMutexLocker lock(&m_mutex);
+
+    // Only the requested number of records is ordered & copied out of the log.
+    QVector<const QAssetImportRecord*> sortedRecords;
+    sortedRecords.reserve(m_records.size());
+    for(const QAssetImportRecord &record : m_records) {
+        sortedRecords.append(&record);
+    }
+    const int numSlowest = qBound(0, count, sortedRecords.size());
+    std::partial_sort(sortedRecords.begin(), sortedRecords.begin() + numSlowest, sortedRecords.end(), [](const QAssetImportRecord *a, const QAssetImportRecord *b) {
+        return a->totalTime() > b->totalTime();
+    });
+
+    QVector<QAssetImportRecord> result;
+    result.reserve(numSlowest);
+    for(int i=0; i<numSlowest; ++i) {
+        result.append(*sortedRecords[i]);
+    }
+    return result;
+}
+
+void ImportStatistics::clear()
+{
+    QMutexLocker lock(&m_mutex);
+    m_records.clear();
+    m_oldestRecord = 0;
+}
+
+bool ImportStatistics::dump(const QString &path) const
+{
+    const QVector<QAssetImportRecord> snapshot = records();
+    if(QFileInfo(path).suffix().compare(QStringLiteral("json"), Qt::CaseInsensitive) == 0) {
+        return writeJson(path, snapshot);
+    }
+    return writeCsv(path, snapshot);
+}
+
+bool ImportStatistics::writeCsv(const QString &path, const QVector<QAssetImportRecord> &records) const
+{
+    QFile file(path);
+    if(!file.open(QFile::WriteOnly | QFile::Truncate | QFile::Text)) {
+        return false;
+    }
+
+    QTextStream out(&file);
+    out.setCodec("UTF-8");
+    out << "type,source,importer,succeeded,file_size,read_ms,decode_ms,conversion_ms,total_ms,"
+           "vertices,indices,texels,peak_temp_bytes,slowest_step,slowest_step_ms\n";
+    for(const QAssetImportRecord &record : records) {
+        const QAssetImportStep *step = dominantStep(record);
+        out << typeName(record.type) << ','
+            << escapeCsv(record.source) << ','
+            << record.importer << ','
+            << (record.succeeded ? 1 : 0) << ','
+            << record.fileSize << ','
+            << record.readTime << ','
+            << record.decodeTime << ','
+            << record.conversionTime << ','
+            << record.totalTime() << ','
+            << record.numVertices << ','
+            << record.numIndices << ','
+            << record.numTexels << ','
+            << record.peakTemporaryMemory << ','
+            << (step ? step->name : QString()) << ','
+            << (step ? step->time : 0.0) << '\n';
+    }
+    out.flush();
+    return out.status() == QTextStream::Ok;
+}
+
+bool ImportStatistics::writeJson(const QString &path, const QVector<QAssetImportRecord> &records) const
+{
+    QJsonArray recordsArray;
+    for(const QAssetImportRecord &record : records) {
+        QJsonArray stepsArray;
+        for(const QAssetImportStep &step : record.steps) {
+            stepsArray.append(QJsonObject{ {"name", step.name}, {"ms", step.time} });
+        }
+
+        QJsonObject recordObject;
+        recordObject.insert("type", typeName(record.type));
+        recordObject.insert("source", record.source);
+        recordObject.insert("importer", record.importer);
+        recordObject.insert("succeeded", record.succeeded);
+        recordObject.insert("fileSize", double(record.fileSize));
+        recordObject.insert("readMs", record.readTime);
+        recordObject.insert("decodeMs", record.decodeTime);
+        recordObject.insert("conversionMs", record.conversionTime);
+        recordObject.insert("totalMs", record.totalTime());
+        recordObject.insert("steps", stepsArray);
+        recordObject.insert("vertices", double(record.numVertices));
+        recordObject.insert("indices", double(record.numIndices));
+        recordObject.insert("texels", double(record.numTexels));
+        recordObject.insert("peakTemporaryBytes", double(record.peakTemporaryMemory));
+        recordsArray.append(recordObject);
+    }
+
+    QFile file(path);
+    if(!file.open(QFile::WriteOnly | QFile::Truncate)) {
+        return false;
+    }
+    const QByteArray json = QJsonDocument(QJsonObject{ {"imports", recordsArray} }).toJson();
+    return file.write(json) == json.size();
+}
+
+} // Raytrace
+} // Qt3DRaytrace
@@ -0,0 +1,52 @@
+/*
+ * Copyright (C) 2018-2019 Michał Siejak
+ * This file is part of Quartz - a raytracing aspect for Qt3D.
+ * See LICENSE file for licensing information.
+ */
+
+#pragma once
+
+#include <qt3draytrace_global_p.h>
+
+#include <Qt3DRaytrace/qassetimportstatistics.h>
+
+#include <QMutex>
+#include <QVector>
+
+#include <atomic>
+
+namespace Qt3DRaytrace {
+namespace Raytrace {
+
+// Process-wide log of asset import metrics reported by mesh & image importers.
+class ImportStatistics
+{
+public:
+    static ImportStatistics *instance();
+
+    // Recording is enabled by default; while disabled, added records are dropped.
+    bool isEnabled() const { return m_enabled.load(std::memory_order_relaxed); }
+    void setEnabled(bool enabled) { m_enabled.store(enabled, std::memory_order_relaxed); }
+
+    void addRecord(const QAssetImportRecord &record);
+    int count() const;
+    QVector<QAssetImportRecord> records() const;
+    QVector<QAssetImportRecord> slowestRecords(int count) const;
+    void clear();
+
+    // Format is chosen by file extension: ".json" writes JSON, anything else writes CSV.
+    bool dump(const QString &path) const;
+
+private:
+    bool writeCsv(const QString &path, const QVector<QAssetImportRecord> &records) const;
+    bool writeJson(const QString &path, const QVector<QAssetImportRecord> &records) const;
+
+    // Ring buffer: once full, the oldest record is overwritten.
+    QVector<QAssetImportRecord> m_records;
+    int m_oldestRecord = 0;
+    std::atomic<bool> m_enabled{true};
+    mutable QMutex m_mutex;
+};
+
+} // Raytrace
+} // Qt3DRaytrace
@@ -7,6 +7,11 @@
 #include <jobs/loadgeometryjob_p.h>
 #include <backend/managers_p.h>
 #include <backend/geometryrenderer_p.h>
+#include <utility/tracing.h>
+#include <utility/startuptiming.h>
+
+#include <QScopeGuard>
+#include <QElapsedTimer>
 
 using namespace Qt3DCore;
 
@@ -22,8 +27,17 @@ LoadGeometryJob::LoadGeometryJob(NodeManagers *managers, const HGeometryRenderer
 
 void LoadGeometryJob::run()
 {
+    Utility::TraceScope trace("LoadGeometryJob");
+    Utility::StartupPhaseScope startupPhase(QStartupPhase::GeometryImport);
+    QElapsedTimer loadTimer;
+    loadTimer.start();
+    auto finishLoad = qScopeGuard([this, &loadTimer]() {
+        m_nodeManagers->geometryRendererManager.finishPendingLoad(loadTimer.nsecsElapsed() * 1e-6);
+    });
+
     GeometryRenderer *geometryRenderer = m_nodeManagers->geometryRendererManager.data(m_handle);
     if(geometryRenderer) {
+        trace.setId(geometryRenderer->peerId().id());
         geometryRenderer->loadGeometry();
     }
 }
@@ -7,6 +7,11 @@
 #include <jobs/loadtexturejob_p.h>
 #include <backend/managers_p.h>
 #include <backend/abstracttexture_p.h>
+#include <utility/tracing.h>
+#include <utility/startuptiming.h>
+
+#include <QScopeGuard>
+#include <QElapsedTimer>
 
 using namespace Qt3DCore;
 
@@ -22,8 +27,17 @@ LoadTextureJob::LoadTextureJob(NodeManagers *managers, const HAbstractTexture &h
 
 void LoadTextureJob::run()
 {
+    Utility::TraceScope trace("LoadTextureJob");
+    Utility::StartupPhaseScope startupPhase(QStartupPhase::TextureImport);
+    QElapsedTimer loadTimer;
+    loadTimer.start();
+    auto finishLoad = qScopeGuard([this, &loadTimer]() {
+        m_nodeManagers->textureManager.finishPendingLoad(loadTimer.nsecsElapsed() * 1e-6);
+    });
+
     AbstractTexture *texture = m_nodeManagers->textureManager.data(m_handle);
     if(texture) {
+        trace.setId(texture->peerId().id());
         texture->loadImage();
     }
 }
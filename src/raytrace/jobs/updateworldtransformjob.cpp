@@ -7,6 +7,7 @@
 #include <jobs/updateworldtransformjob_p.h>
 #include <backend/entity_p.h>
 #include <backend/transform_p.h>
+#include <utility/tracing.h>
 
 namespace Qt3DRaytrace {
 namespace Raytrace {
@@ -28,6 +29,7 @@ static void updateWorldTransform(Entity *entity, const Matrix4x4 &parentTransfor
 void UpdateWorldTransformJob::run()
 {
     Q_ASSERT(m_rootEntity);
+    Utility::TraceScope trace("UpdateWorldTransformJob");
 
     Matrix4x4 parentTransformMatrix;
     Entity *parent = m_rootEntity->parent();
@@ -27,10 +27,22 @@
 #include <jobs/loadgeometryjob_p.h>
 #include <jobs/loadtexturejob_p.h>
 
+#include <io/importstatistics_p.h>
+
+#include <replay/scenechangerecorder_p.h>
+
+#include <utility/lockstatistics.h>
+#include <utility/tracing.h>
+#include <utility/startuptiming.h>
+
 using namespace Qt3DCore;
 
 namespace Qt3DRaytrace {
 
+namespace Config {
+static constexpr int NumSlowestImportsReported = 10;
+} // Config
+
 Q_LOGGING_CATEGORY(logAspect, "raytrace.aspect")
 Q_LOGGING_CATEGORY(logImport, "raytrace.import")
 
@@ -44,6 +56,8 @@ void QRaytraceAspectPrivate::registerBackendTypes()
     qRegisterMetaType<Qt3DRaytrace::QImageData>();
     qRegisterMetaType<Qt3DRaytrace::QImageDataPtr>();
     qRegisterMetaType<Qt3DRaytrace::QRenderImage>();
+    qRegisterMetaType<Qt3DRaytrace::QRenderStatistics>();
+    qRegisterMetaType<Qt3DRaytrace::QAssetImportRecord>();
 
     qRegisterMetaType<Qt3DRaytrace::QCamera*>();
     qRegisterMetaType<Qt3DRaytrace::QGeometry*>();
@@ -97,6 +111,7 @@ QVector<QAspectJobPtr> QRaytraceAspectPrivate::createGeometryRendererJobs() cons
             geometryRendererJobs.append(job);
         }
     }
+    geometryRendererManager->addPendingLoads(geometryRendererJobs.size());
     return geometryRendererJobs;
 }
 
@@ -114,9 +129,21 @@ QVector<QAspectJobPtr> QRaytraceAspectPrivate::createTextureJobs() const
             textureJobs.append(job);
         }
     }
+    textureManager->addPendingLoads(textureJobs.size());
     return textureJobs;
 }
 
+QVector<QAspectJobPtr> QRaytraceAspectPrivate::createFrameJobs(qint64 time) const
+{
+    QVector<QAspectJobPtr> jobs;
+    jobs.append(createGeometryRendererJobs());
+    jobs.append(createTextureJobs());
+    if(m_renderer) {
+        jobs.append(m_renderer->jobsToExecute(time));
+    }
+    return jobs;
+}
+
 QRaytraceAspect::QRaytraceAspect(QObject *parent)
     : QRaytraceAspect(*new QRaytraceAspectPrivate, parent)
 {}
@@ -146,6 +173,57 @@ bool QRaytraceAspect::queryRenderStatistics(QRenderStatistics &statistics) const
     return false;
 }
 
+void QRaytraceAspect::setTracingEnabled(bool enabled)
+{
+    Utility::Tracing::setEnabled(enabled);
+}
+
+bool QRaytraceAspect::isTracingEnabled() const
+{
+    return Utility::Tracing::isEnabled();
+}
+
+bool QRaytraceAspect::dumpTrace(const QString &path) const
+{
+    return Utility::Tracing::dump(path);
+}
+
+bool QRaytraceAspect::queryStartupStatistics(QStartupStatistics &statistics)
+{
+    statistics = Utility::StartupTiming::statistics();
+    return statistics.complete;
+}
+
+void QRaytraceAspect::restartStartupTiming()
+{
+    Utility::StartupTiming::restart();
+}
+
+void QRaytraceAspect::beginStartupPhase(QStartupPhase phase)
+{
+    Utility::StartupTiming::beginPhase(phase);
+}
+
+void QRaytraceAspect::endStartupPhase(QStartupPhase phase)
+{
+    Utility::StartupTiming::endPhase(phase);
+}
+
+QVector<QAssetImportRecord> QRaytraceAspect::importRecords() const
+{
+    return Raytrace::ImportStatistics::instance()->records();
+}
+
+QVector<QAssetImportRecord> QRaytraceAspect::slowestImports(int count) const
+{
+    return Raytrace::ImportStatistics::instance()->slowestRecords(count);
+}
+
+bool QRaytraceAspect::dumpImportStatistics(const QString &path) const
+{
+    return Raytrace::ImportStatistics::instance()->dump(path);
+}
+
 void QRaytraceAspect::suspendJobs()
 {
     Q_D(QRaytraceAspect);
@@ -168,10 +246,13 @@ void QRaytraceAspect::grabImage(QRenderImage type)
 {
     Q_D(QRaytraceAspect);
     if(d->m_renderer) {
+        // Statistics are captured on the same thread that renders frames so they exactly match the grabbed image.
+        const QRenderStatistics statistics = d->m_renderer->statistics();
         QImageDataPtr image(new QImageData);
         *image = d->m_renderer->grabImage(type);
         if(!image->data.isEmpty()) {
             emit imageReady(type, image);
+            emit imageReadyWithStatistics(type, image, statistics);
         }
     }
 }
@@ -185,32 +266,77 @@ QRaytraceAspect::QRaytraceAspect(QRaytraceAspectPrivate &dd, QObject *parent)
 QVector<QAspectJobPtr> QRaytraceAspect::jobsToExecute(qint64 time)
 {
     Q_D(QRaytraceAspect);
-
-    QVector<QAspectJobPtr> jobs;
+    Utility::TraceScope trace("jobsToExecute");
 
     if(d->m_jobsSuspended) {
-        return jobs;
+        return {};
     }
 
-    jobs.append(d->createGeometryRendererJobs());
-    jobs.append(d->createTextureJobs());
-    if(d->m_renderer) {
-        jobs.append(d->m_renderer->jobsToExecute(time));
+    Raytrace::SceneChangeRecorder::recordFrame();
+    if(d->m_sceneChangeReplayer && !d->m_sceneChangeReplayer->advance()) {
+        qCInfo(logAspect).nospace() << "Scene change replay finished: " << d->m_sceneChangeReplayer->numEventsReplayed() << " events, "
+                                    << d->m_sceneChangeReplayer->numFramesReplayed() << " frames in "
+                                    << d->m_sceneChangeReplayer->elapsedTime() << " s";
+        d->m_sceneChangeReplayer.reset();
     }
 
-    return jobs;
+    return d->createFrameJobs(time);
 }
 
 void QRaytraceAspect::onRegistered()
 {
     Q_D(QRaytraceAspect);
 
+    // Setting QUARTZ_TRACE to a file path records job execution for the lifetime of the aspect.
+    if(qEnvironmentVariableIsSet("QUARTZ_TRACE")) {
+        d->m_traceOutputPath = qEnvironmentVariable("QUARTZ_TRACE");
+        Utility::Tracing::setEnabled(true);
+    }
+
+    // Setting QUARTZ_IMPORT_STATS to a file path writes per-asset import metrics (CSV, or JSON for *.json) on exit.
+    if(qEnvironmentVariableIsSet("QUARTZ_IMPORT_STATS")) {
+        d->m_importStatisticsOutputPath = qEnvironmentVariable("QUARTZ_IMPORT_STATS");
+    }
+
+    // Setting QUARTZ_LOCK_STATS=1 counts waits and hold times of the renderer's scene resource lock (reported in render statistics).
+    if(qEnvironmentVariableIntValue("QUARTZ_LOCK_STATS") != 0) {
+        Utility::LockStatistics::setEnabled(true);
+    }
+
+    // Setting QUARTZ_RECORD to a file path records all scene changes handled by backend nodes for later replay.
+    if(qEnvironmentVariableIsSet("QUARTZ_RECORD")) {
+        Raytrace::SceneChangeRecorder::start(qEnvironmentVariable("QUARTZ_RECORD"));
+    }
+
+    // Startup phases are timed from aspect registration until the first frame rendered with a complete scene.
+    // Timings are process-wide, so registering another aspect restarts them.
+    Utility::StartupTiming::restart();
+
     d->m_nodeManagers.reset(new Raytrace::NodeManagers);
 
     // TODO: Make renderer configurable.
     d->m_renderer.reset(new Vulkan::Renderer);
     d->m_renderer->setNodeManagers(d->m_nodeManagers.get());
 
+    // Setting QUARTZ_REPLAY to a recorded log feeds it back into backend nodes; QUARTZ_REPLAY_SPEED=max replays one recorded frame per frame.
+    if(qEnvironmentVariableIsSet("QUARTZ_REPLAY")) {
+        const auto speed = (qEnvironmentVariable("QUARTZ_REPLAY_SPEED") == QStringLiteral("max"))
+                ? Raytrace::SceneChangeReplayer::Speed::Maximum
+                : Raytrace::SceneChangeReplayer::Speed::Recorded;
+        d->m_sceneChangeReplayer.reset(new Raytrace::SceneChangeReplayer(d, d->m_renderer.get(), d->m_nodeManagers.get()));
+        if(!d->m_sceneChangeReplayer->open(qEnvironmentVariable("QUARTZ_REPLAY"), speed)) {
+            d->m_sceneChangeReplayer.reset();
+        }
+    }
+
+    // Setting QUARTZ_STATS_SOCKET to a local socket name (or path) serves statistics snapshots to monitoring tools.
+    if(qEnvironmentVariableIsSet("QUARTZ_STATS_SOCKET")) {
+        d->m_statisticsServer.reset(new Raytrace::StatisticsServer(d->m_renderer.get()));
+        if(!d->m_statisticsServer->listen(qEnvironmentVariable("QUARTZ_STATS_SOCKET"))) {
+            d->m_statisticsServer.reset();
+        }
+    }
+
     d->updateServiceProviders();
     d->registerBackendTypes();
 }
@@ -219,8 +345,37 @@ void QRaytraceAspect::onUnregistered()
 {
     Q_D(QRaytraceAspect);
 
+    Raytrace::SceneChangeRecorder::stop();
+
+    d->m_sceneChangeReplayer.reset();
+    d->m_statisticsServer.reset();
     d->m_renderer.reset();
     d->m_nodeManagers.reset();
+
+    if(!d->m_traceOutputPath.isEmpty()) {
+        if(Utility::Tracing::dump(d->m_traceOutputPath)) {
+            qCInfo(logAspect) << "Job execution trace written to:" << d->m_traceOutputPath;
+        }
+        else {
+            qCWarning(logAspect) << "Failed to write job execution trace:" << d->m_traceOutputPath;
+        }
+    }
+
+    if(!d->m_importStatisticsOutputPath.isEmpty()) {
+        const auto slowestImports = Raytrace::ImportStatistics::instance()->slowestRecords(Config::NumSlowestImportsReported);
+        for(const QAssetImportRecord &record : slowestImports) {
+            qCInfo(logImport).nospace() << "Slow import: " << record.source << " (" << record.importer << ") "
+                                        << record.totalTime() << " ms [read " << record.readTime
+                                        << " ms, decode " << record.decodeTime
+                                        << " ms, conversion " << record.conversionTime << " ms]";
+        }
+        if(Raytrace::ImportStatistics::instance()->dump(d->m_importStatisticsOutputPath)) {
+            qCInfo(logImport) << "Asset import statistics written to:" << d->m_importStatisticsOutputPath;
+        }
+        else {
+            qCWarning(logImport) << "Failed to write asset import statistics:" << d->m_importStatisticsOutputPath;
+        }
+    }
 }
 
 void QRaytraceAspect::onEngineStartup()
@@ -230,6 +385,8 @@ void QRaytraceAspect::onEngineStartup()
     Q_ASSERT(d->m_nodeManagers);
     Q_ASSERT(d->m_renderer);
 
+    Raytrace::SceneChangeRecorder::recordSceneRoot(rootEntityId());
+
     Raytrace::Entity *rootEntity = d->m_nodeManagers->entityManager.lookupResource(rootEntityId());
     if(rootEntity) {
         d->m_renderer->setSceneRoot(rootEntity);
@@ -14,6 +14,8 @@
 #include <qt3draytrace_global_p.h>
 
 #include <backend/managers_p.h>
+#include <statisticsserver_p.h>
+#include <replay/scenechangereplayer_p.h>
 
 namespace Qt3DRaytrace {
 
@@ -25,10 +27,15 @@ public:
 
     QVector<Qt3DCore::QAspectJobPtr> createGeometryRendererJobs() const;
     QVector<Qt3DCore::QAspectJobPtr> createTextureJobs() const;
+    QVector<Qt3DCore::QAspectJobPtr> createFrameJobs(qint64 time) const;
 
     QScopedPointer<Raytrace::AbstractRenderer> m_renderer;
     QScopedPointer<Raytrace::NodeManagers> m_nodeManagers;
+    QScopedPointer<Raytrace::StatisticsServer> m_statisticsServer;
+    QScopedPointer<Raytrace::SceneChangeReplayer> m_sceneChangeReplayer;
     bool m_jobsSuspended = false;
+    QString m_traceOutputPath;
+    QString m_importStatisticsOutputPath;
 
     Q_DECLARE_PUBLIC(QRaytraceAspect)
 };
@@ -235,6 +235,7 @@ Image Device::createImage(const ImageCreateInfo &createInfo, const AllocationCre
         return image;
     }
     image.hostAddress = allocInfo.pMappedData;
+    trackAllocation(allocInfo.size);
 
     if(createInfo.usage == (VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT)) {
         // Skip image view creation for staging images.
@@ -289,11 +290,17 @@ Image Device::createStagingImage(uint32_t width, uint32_t height, VkFormat forma
     createInfo.tiling = VK_IMAGE_TILING_LINEAR;
     createInfo.usage = VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
     createInfo.initialLayout = ResourceBarrier::getImageLayoutFromState(initialState);
-    return createImage(createInfo, VMA_MEMORY_USAGE_CPU_ONLY);
+
+    Image image = createImage(createInfo, VMA_MEMORY_USAGE_CPU_ONLY);
+    if(image.allocation) {
+        m_stagingBytes.fetchAndAddRelaxed(allocationSize(image.allocation));
+    }
+    return image;
 }
 
 void Device::destroyImage(Image &image)
 {
+    untrackAllocation(image.allocation);
     vkDestroyImageView(m_device, image.view, nullptr);
     vmaDestroyImage(m_allocator, image.handle, image.allocation);
     image = {};
@@ -322,6 +329,7 @@ Buffer Device::createBuffer(const BufferCreateInfo &createInfo, const Allocation
         return Buffer();
     }
     buffer.hostAddress = allocInfo.pMappedData;
+    trackAllocation(allocInfo.size);
     return buffer;
 }
 
@@ -330,11 +338,17 @@ Buffer Device::createStagingBuffer(VkDeviceSize size)
     BufferCreateInfo createInfo;
     createInfo.size = size;
     createInfo.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
-    return createBuffer(createInfo, VMA_MEMORY_USAGE_CPU_ONLY);
+
+    Buffer buffer = createBuffer(createInfo, VMA_MEMORY_USAGE_CPU_ONLY);
+    if(buffer.allocation) {
+        m_stagingBytes.fetchAndAddRelaxed(allocationSize(buffer.allocation));
+    }
+    return buffer;
 }
 
 void Device::destroyBuffer(Buffer &buffer)
 {
+    untrackAllocation(buffer.allocation);
     vmaDestroyBuffer(m_allocator, buffer.handle, buffer.allocation);
     buffer = {};
 }
@@ -380,6 +394,7 @@ AccelerationStructure Device::createAccelerationStructure(const AccelerationStru
         destroyAccelerationStructure(as);
         return AccelerationStructure();
     }
+    trackAllocation(allocationInfo.size);
 
     VkBindAccelerationStructureMemoryInfoNV bindObjectMemoryInfo = { VK_STRUCTURE_TYPE_BIND_ACCELERATION_STRUCTURE_MEMORY_INFO_NV };
     bindObjectMemoryInfo.accelerationStructure = as;
@@ -423,6 +438,7 @@ Buffer Device::createAccelerationStructureScratchBuffer(const AccelerationStruct
 void Device::destroyAccelerationStructure(AccelerationStructure &as)
 {
     vkDestroyAccelerationStructureNV(m_device, as.handle, nullptr);
+    untrackAllocation(as.allocation);
     vmaFreeMemory(m_allocator, as.allocation);
     as = {};
 }
@@ -668,6 +684,27 @@ void Device::destroyGeometry(Geometry &geometry)
     geometry = {};
 }
 
+VkDeviceSize Device::allocationSize(const VmaAllocation &allocation) const
+{
+    VmaAllocationInfo allocationInfo;
+    vmaGetAllocationInfo(m_allocator, allocation, &allocationInfo);
+    return allocationInfo.size;
+}
+
+void Device::trackAllocation(VkDeviceSize size)
+{
+    m_numAllocations.fetchAndAddRelaxed(1);
+    m_allocatedBytes.fetchAndAddRelaxed(size);
+}
+
+void Device::untrackAllocation(const VmaAllocation &allocation)
+{
+    if(allocation) {
+        m_numAllocations.fetchAndSubRelaxed(1);
+        m_allocatedBytes.fetchAndSubRelaxed(allocationSize(allocation));
+    }
+}
+
 void *Device::mapMemory(const VmaAllocation &allocation) const
 {
     void *mappedAddress;
@@ -714,6 +751,15 @@ void Device::queryPhysicalDeviceProperties()
     vkGetPhysicalDeviceProperties2(m_physicalDevice, &properties);
 
     m_physicalDeviceProperties = properties.properties;
+
+    VkPhysicalDeviceMemoryProperties memoryProperties;
+    vkGetPhysicalDeviceMemoryProperties(m_physicalDevice, &memoryProperties);
+    for(uint32_t heapIndex=0; heapIndex<memoryProperties.memoryHeapCount; ++heapIndex) {
+        const VkMemoryHeap &heap = memoryProperties.memoryHeaps[heapIndex];
+        if(heap.flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT) {
+            m_deviceLocalMemoryCapacity += heap.size;
+        }
+    }
 }
 
 } // Vulkan
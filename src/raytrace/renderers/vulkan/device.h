@@ -15,6 +15,7 @@
 
 #include <QMutex>
 #include <QVector>
+#include <QAtomicInteger>
 
 class QWindow;
 
@@ -113,6 +114,12 @@ public:
     VmaAllocator allocator() const { return m_allocator; }
     uint32_t queueFamilyIndex() const { return m_queueFamilyIndex; }
 
+    VkDeviceSize allocationSize(const VmaAllocation &allocation) const;
+    uint32_t numAllocations() const { return m_numAllocations.load(); }
+    VkDeviceSize allocatedBytes() const { return m_allocatedBytes.load(); }
+    VkDeviceSize deviceLocalMemoryCapacity() const { return m_deviceLocalMemoryCapacity; }
+    VkDeviceSize takeStagingBytes() { return m_stagingBytes.fetchAndStoreRelaxed(0); }
+
     const VkPhysicalDeviceProperties &physicalDeviceProperties() const { return m_physicalDeviceProperties; }
     const VkPhysicalDeviceRayTracingPropertiesNV &rayTracingProperties() const { return m_rayTracingProperties; }
 
@@ -123,6 +130,9 @@ private:
     Device() = default;
     void queryPhysicalDeviceProperties();
 
+    void trackAllocation(VkDeviceSize size);
+    void untrackAllocation(const VmaAllocation &allocation);
+
     VkDevice m_device = VK_NULL_HANDLE;
     VkPhysicalDevice m_physicalDevice = VK_NULL_HANDLE;
     VmaAllocator m_allocator = VK_NULL_HANDLE;
@@ -133,6 +143,12 @@ private:
 
     VkPhysicalDeviceProperties m_physicalDeviceProperties;
     VkPhysicalDeviceRayTracingPropertiesNV m_rayTracingProperties;
+    VkDeviceSize m_deviceLocalMemoryCapacity = 0;
+
+    // Maintained on every allocation so that statistics never need to walk VMA internals.
+    QAtomicInteger<uint32_t> m_numAllocations;
+    QAtomicInteger<quint64> m_allocatedBytes;
+    QAtomicInteger<quint64> m_stagingBytes;
 };
 
 } // Vulkan
@@ -6,6 +6,8 @@
 
 #include <renderers/vulkan/jobs/buildgeometryjob.h>
 #include <renderers/vulkan/renderer.h>
+#include <utility/tracing.h>
+#include <utility/startuptiming.h>
 #include <renderers/vulkan/geometry.h>
 #include <renderers/vulkan/glsl.h>
 
@@ -14,6 +16,8 @@
 
 #include <cstring>
 #include <QMutex>
+#include <QScopeGuard>
+#include <QElapsedTimer>
 
 using namespace Qt3DCore;
 
@@ -50,10 +54,18 @@ BuildGeometryJob::BuildGeometryJob(Renderer *renderer, const Raytrace::HGeometry
 
 void BuildGeometryJob::run()
 {
+    Utility::TraceScope trace("BuildGeometryJob");
+    QElapsedTimer uploadTimer;
+    uploadTimer.start();
+    auto finishUpload = qScopeGuard([this, &uploadTimer]() {
+        m_renderer->sceneManager()->finishGeometryBuild(uploadTimer.nsecsElapsed() * 1e-6);
+    });
+
     Raytrace::Geometry *geometryNode = m_handle.data();
     if(!geometryNode) {
         return;
     }
+    trace.setId(geometryNode->peerId().id());
 
     auto *device = m_renderer->device();
     auto *commandBufferManager = m_renderer->commandBufferManager();
@@ -88,6 +100,8 @@ void BuildGeometryJob::run()
     VkAccelerationStructureInfoNV blasInfo = { VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_INFO_NV };
     VkGeometryNV blasGeometry = { VK_STRUCTURE_TYPE_GEOMETRY_NV };
     {
+        Utility::StartupPhaseScope startupPhase(QStartupPhase::AccelerationStructureBuild);
+
         VkGeometryTrianglesNV blasGeometryTriangles = { VK_STRUCTURE_TYPE_GEOMETRY_TRIANGLES_NV };
         blasGeometryTriangles.vertexData = geometry.attributes;
         blasGeometryTriangles.vertexCount = geometry.numVertices;
@@ -138,8 +152,11 @@ void BuildGeometryJob::run()
         return;
     }
 
-    copyAttributes(stagingAttributes.memory<Attributes>(), geometryNode->vertices().data(), geometry.numVertices);
-    copyIndices(stagingIndices.memory<uint32_t>(), geometryNode->faces().data(), geometry.numIndices);
+    {
+        Utility::StartupPhaseScope startupPhase(QStartupPhase::GeometryConversion);
+        copyAttributes(stagingAttributes.memory<Attributes>(), geometryNode->vertices().data(), geometry.numVertices);
+        copyIndices(stagingIndices.memory<uint32_t>(), geometryNode->faces().data(), geometry.numIndices);
+    }
 
     TransientCommandBuffer commandBuffer = commandBufferManager->acquireCommandBuffer();
     {
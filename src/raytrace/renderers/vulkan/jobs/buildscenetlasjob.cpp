@@ -6,6 +6,8 @@
 
 #include <renderers/vulkan/jobs/buildscenetlasjob.h>
 #include <renderers/vulkan/renderer.h>
+#include <renderers/vulkan/scenerecords.h>
+#include <utility/tracing.h>
 
 #include <backend/managers_p.h>
 #include <backend/entity_p.h>
@@ -27,6 +29,7 @@ BuildSceneTopLevelAccelerationStructureJob::BuildSceneTopLevelAccelerationStruct
 
 void BuildSceneTopLevelAccelerationStructureJob::run()
 {
+    Utility::TraceScope trace("BuildSceneTopLevelAccelerationStructureJob");
     auto *device = m_renderer->device();
     auto *commandBufferManager = m_renderer->commandBufferManager();
     auto *sceneManager = m_renderer->sceneManager();
@@ -34,7 +37,7 @@ void BuildSceneTopLevelAccelerationStructureJob::run()
     Buffer instanceBuffer;
     uint32_t numInstances;
     {
-        const QVector<GeometryInstance> instances = gatherGeometryInstances();
+        const QVector<GeometryInstance> instances = gatherGeometryInstances<GeometryInstance, Geometry>(*sceneManager);
         numInstances = uint32_t(instances.size());
         if(numInstances == 0) {
             return;
@@ -94,33 +97,5 @@ void BuildSceneTopLevelAccelerationStructureJob::run()
     sceneManager->updateSceneTLAS(tlas, numInstances);
 }
 
-QVector<GeometryInstance> BuildSceneTopLevelAccelerationStructureJob::gatherGeometryInstances() const
-{
-    QVector<GeometryInstance> instances;
-
-    auto *sceneManager = m_renderer->sceneManager();
-    Q_ASSERT(sceneManager);
-
-    const auto &renderables = sceneManager->renderables();
-    for(int instanceIndex = 0; instanceIndex < renderables.size(); ++instanceIndex) {
-        const auto &renderable = renderables[instanceIndex];
-        const Raytrace::GeometryRenderer *geometryRenderer = renderable->geometryRendererComponent();
-        Q_ASSERT(geometryRenderer);
-
-        Geometry geometry;
-        uint32_t geometryIndex = sceneManager->lookupGeometry(geometryRenderer->geometryId(), geometry);
-        if(geometryIndex != ~0u) {
-            const QMatrix4x4 worldTransformRowMajor = renderable->worldTransformMatrix.transposed().toQMatrix4x4();
-            GeometryInstance geometryInstance = {};
-            std::memcpy(geometryInstance.transform, worldTransformRowMajor.constData(), sizeof(geometryInstance.transform));
-            geometryInstance.mask = 0xFF;
-            geometryInstance.blasHandle = geometry.blasHandle;
-            geometryInstance.instanceCustomIndex = geometryIndex;
-            instances.append(geometryInstance);
-        }
-    }
-    return instances;
-}
-
 } // Vulkan
 } // Qt3DRaytrace
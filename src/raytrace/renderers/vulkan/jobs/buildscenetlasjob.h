@@ -23,8 +23,6 @@ public:
     void run() override;
 
 private:
-    QVector<GeometryInstance> gatherGeometryInstances() const;
-
     Renderer *m_renderer;
 };
 
@@ -6,6 +6,7 @@
 
 #include <renderers/vulkan/jobs/destroyexpiredresourcesjob.h>
 #include <renderers/vulkan/renderer.h>
+#include <utility/tracing.h>
 
 using namespace Qt3DCore;
 
@@ -20,6 +21,7 @@ DestroyExpiredResourcesJob::DestroyExpiredResourcesJob(Renderer *renderer)
 
 void DestroyExpiredResourcesJob::run()
 {
+    Utility::TraceScope trace("DestroyExpiredResourcesJob");
     auto *commandBufferManager = m_renderer->commandBufferManager();
     if(commandBufferManager) {
         commandBufferManager->destroyExpiredResources();
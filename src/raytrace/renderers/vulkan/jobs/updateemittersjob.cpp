@@ -6,6 +6,8 @@
 
 #include <renderers/vulkan/jobs/updateemittersjob.h>
 #include <renderers/vulkan/renderer.h>
+#include <renderers/vulkan/scenerecords.h>
+#include <utility/tracing.h>
 
 #include <backend/managers_p.h>
 #include <backend/rendersettings_p.h>
@@ -33,61 +35,20 @@ void UpdateEmittersJob::setTextureManager(Raytrace::TextureManager *textureManag
 
 void UpdateEmittersJob::run()
 {
+    Utility::TraceScope trace("UpdateEmittersJob");
     auto *device = m_renderer->device();
     auto *commandBufferManager = m_renderer->commandBufferManager();
     auto *sceneManager = m_renderer->sceneManager();
 
-    auto lookupTextureImageIndex = [this, sceneManager](QNodeId textureId) -> uint32_t {
-        if(const auto *texture = m_textureManager->lookupResource(textureId)) {
-            return sceneManager->lookupTextureIndex(texture->imageId());
+    uint32_t skyTextureIndex = ~0u;
+    const Raytrace::RenderSettings *settings = m_renderer->settings();
+    if(settings) {
+        if(const auto *skyTexture = m_textureManager->lookupResource(settings->skyTextureId())) {
+            skyTextureIndex = sceneManager->lookupTextureIndex(skyTexture->imageId());
         }
-        return ~0u;
-    };
-
-    // TODO: Update only dirty emissive entities.
-    // Currently there's no meaningful semantic determining which entities
-    // are dirty in the context of becoming emitters.
-
-    QVector<Emitter> emitters;
-    {
-        Emitter skyEmitter = {};
-        skyEmitter.instanceIndex = ~0u;
-        if(const Raytrace::RenderSettings *settings = m_renderer->settings()) {
-            settings->skyRadiance().writeToBuffer(skyEmitter.radiance.data);
-            skyEmitter.intensity = settings->skyIntensity();
-            skyEmitter.textureIndex = lookupTextureImageIndex(settings->skyTextureId());
-            skyEmitter.direction = QVector3D(settings->skyTextureOffset(), 0.0f);
-        }
-        emitters.append(skyEmitter);
     }
 
-    for(const auto &entity : sceneManager->emissives()) {
-        const QMatrix4x4 entityTransform = entity->worldTransformMatrix.toQMatrix4x4();
-        if(!entity->distantLightComponentId().isNull()) {
-            const Raytrace::DistantLight *light = entity->distantLightComponent();
-            Q_ASSERT(light);
-
-            const QVector3D worldDirection = entityTransform.mapVector(light->direction()).normalized();
-
-            Emitter emitter = {};
-            emitter.instanceIndex = ~0u;
-            emitter.direction = worldDirection;
-            light->radiance().writeToBuffer(emitter.radiance.data);
-            emitters.append(emitter);
-        }
-        if(entity->isRenderable()) {
-            const Raytrace::Material *material = entity->materialComponent();
-            const Raytrace::GeometryRenderer *geometryRenderer = entity->geometryRendererComponent();
-            Q_ASSERT(material && geometryRenderer);
-
-            Emitter emitter = {};
-            emitter.instanceIndex = sceneManager->lookupRenderableIndex(entity->peerId());
-            emitter.geometryIndex = sceneManager->lookupGeometryIndex(geometryRenderer->geometryId());
-            material->emission().writeToBuffer(emitter.radiance.data);
-            emitters.append(emitter);
-        }
-    }
-    Q_ASSERT(emitters.size() >= 1);
+    QVector<Emitter> emitters = gatherEmitters(*sceneManager, settings, skyTextureIndex);
 
     const VkDeviceSize emitterBufferSize = sizeof(Emitter) * uint32_t(emitters.size());
 
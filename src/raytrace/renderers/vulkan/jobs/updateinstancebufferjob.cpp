@@ -6,6 +6,8 @@
 
 #include <renderers/vulkan/jobs/updateinstancebufferjob.h>
 #include <renderers/vulkan/renderer.h>
+#include <renderers/vulkan/scenerecords.h>
+#include <utility/tracing.h>
 
 #include <backend/managers_p.h>
 
@@ -22,6 +24,7 @@ UpdateInstanceBufferJob::UpdateInstanceBufferJob(Renderer *renderer)
 
 void UpdateInstanceBufferJob::run()
 {
+    Utility::TraceScope trace("UpdateInstanceBufferJob");
     auto *device = m_renderer->device();
     auto *commandBufferManager = m_renderer->commandBufferManager();
     auto *sceneManager = m_renderer->sceneManager();
@@ -48,23 +51,7 @@ void UpdateInstanceBufferJob::run()
         return;
     }
 
-    EntityInstance *instanceData = stagingBuffer.memory<EntityInstance>();
-    for(uint32_t instanceIndex=0; instanceIndex < instanceCount; ++instanceIndex) {
-        const Raytrace::Entity *renderable = renderables[int(instanceIndex)].data();
-        const Raytrace::GeometryRenderer *geometryRenderer = renderable->geometryRendererComponent();
-        Q_ASSERT(geometryRenderer);
-
-        EntityInstance &instance = instanceData[instanceIndex];
-        instance.materialIndex = sceneManager->lookupMaterialIndex(renderable->materialComponentId());
-
-        Geometry renderableGeometry;
-        instance.geometryIndex = sceneManager->lookupGeometry(geometryRenderer->geometryId(), renderableGeometry);
-        instance.geometryNumFaces = renderableGeometry.numIndices / 3;
-
-        const QMatrix4x4 entityTransform = renderable->worldTransformMatrix.toQMatrix4x4();
-        instance.transform = entityTransform;
-        instance.basisTransform = entityTransform.normalMatrix();
-    }
+    writeEntityInstances<Geometry>(*sceneManager, stagingBuffer.memory<EntityInstance>());
 
     TransientCommandBuffer commandBuffer = commandBufferManager->acquireCommandBuffer();
     {
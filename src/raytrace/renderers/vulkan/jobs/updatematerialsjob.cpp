@@ -6,6 +6,7 @@
 
 #include <renderers/vulkan/jobs/updatematerialsjob.h>
 #include <renderers/vulkan/renderer.h>
+#include <utility/tracing.h>
 
 #include <backend/managers_p.h>
 
@@ -31,6 +32,7 @@ void UpdateMaterialsJob::setDirtyMaterialHandles(QVector<Raytrace::HMaterial> &m
 
 void UpdateMaterialsJob::run()
 {
+    Utility::TraceScope trace("UpdateMaterialsJob");
     auto *device = m_renderer->device();
     auto *commandBufferManager = m_renderer->commandBufferManager();
     auto *sceneManager = m_renderer->sceneManager();
@@ -6,6 +6,7 @@
 
 #include <renderers/vulkan/jobs/updaterenderparametersjob.h>
 #include <renderers/vulkan/renderer.h>
+#include <utility/tracing.h>
 
 using namespace Qt3DCore;
 
@@ -20,6 +21,7 @@ UpdateRenderParametersJob::UpdateRenderParametersJob(Renderer *renderer)
 
 void UpdateRenderParametersJob::run()
 {
+    Utility::TraceScope trace("UpdateRenderParametersJob");
     auto *cameraManager = m_renderer->cameraManager();
     if(cameraManager) {
         cameraManager->updateParameters();
@@ -6,11 +6,15 @@
 
 #include <renderers/vulkan/jobs/uploadtexturejob.h>
 #include <renderers/vulkan/renderer.h>
+#include <utility/tracing.h>
+#include <utility/startuptiming.h>
 
 #include <backend/managers_p.h>
 #include <backend/textureimage_p.h>
 
 #include <cstring>
+#include <QScopeGuard>
+#include <QElapsedTimer>
 
 namespace Qt3DRaytrace {
 namespace Vulkan {
@@ -104,10 +108,19 @@ UploadTextureJob::UploadTextureJob(Renderer *renderer, const Raytrace::HTextureI
 
 void UploadTextureJob::run()
 {
+    Utility::TraceScope trace("UploadTextureJob");
+    Utility::StartupPhaseScope startupPhase(QStartupPhase::TextureUpload);
+    QElapsedTimer uploadTimer;
+    uploadTimer.start();
+    auto finishUpload = qScopeGuard([this, &uploadTimer]() {
+        m_renderer->sceneManager()->finishTextureUpload(uploadTimer.nsecsElapsed() * 1e-6);
+    });
+
     Raytrace::TextureImage *textureImageNode = m_handle.data();
     if(!textureImageNode) {
         return;
     }
+    trace.setId(textureImageNode->peerId().id());
 
     const auto &imageData = textureImageNode->data();
     const uint32_t imageWidth = uint32_t(imageData.width);
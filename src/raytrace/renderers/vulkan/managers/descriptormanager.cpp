@@ -185,6 +185,24 @@ uint32_t DescriptorManager::descriptorPoolCapacity(ResourceClass rclass) const
     return (it != m_pools.end()) ? it->capacity : 0;
 }
 
+uint32_t DescriptorManager::numAllocatedDescriptors() const
+{
+    uint32_t numAllocated = 0;
+    for(const auto &pool : m_pools) {
+        numAllocated += qMin(pool.allocated.load(), pool.capacity);
+    }
+    return numAllocated;
+}
+
+uint32_t DescriptorManager::totalDescriptorCapacity() const
+{
+    uint32_t capacity = 0;
+    for(const auto &pool : m_pools) {
+        capacity += pool.capacity;
+    }
+    return capacity;
+}
+
 VkDescriptorBindingFlagsEXT DescriptorManager::descriptorBindingFlags(ResourceClass rclass) const
 {
     Q_UNUSED(rclass);
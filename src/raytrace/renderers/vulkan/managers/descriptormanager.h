@@ -35,6 +35,8 @@ public:
 
     VkDescriptorSet descriptorSet(ResourceClass rclass) const;
     uint32_t descriptorPoolCapacity(ResourceClass rclass) const;
+    uint32_t numAllocatedDescriptors() const;
+    uint32_t totalDescriptorCapacity() const;
     VkDescriptorBindingFlagsEXT descriptorBindingFlags(ResourceClass rclass) const;
 
     Q_DISABLE_COPY(DescriptorManager)
@@ -0,0 +1,31 @@
+/*
+ * Copyright (C) 2018-2019 Michał Siejak
+ * This file is part of Quartz - a raytracing aspect for Qt3D.
+ * See LICENSE file for licensing information.
+ */
+
+#include <renderers/vulkan/managers/sceneentities.h>
+
+#include <backend/managers_p.h>
+
+namespace Qt3DRaytrace {
+namespace Vulkan {
+
+void SceneEntities::gather(Raytrace::EntityManager *entityManager)
+{
+    Q_ASSERT(entityManager);
+
+    m_renderables.clear();
+    m_emissives.clear();
+    for(const auto &entity : entityManager->activeHandles()) {
+        if(entity->isRenderable()) {
+            m_renderables.addResource(entity->peerId(), entity->handle());
+        }
+        if(entity->isEmissive()) {
+            m_emissives.addResource(entity->peerId(), entity->handle());
+        }
+    }
+}
+
+} // Vulkan
+} // Qt3DRaytrace
@@ -0,0 +1,51 @@
+/*
+ * Copyright (C) 2018-2019 Michał Siejak
+ * This file is part of Quartz - a raytracing aspect for Qt3D.
+ * See LICENSE file for licensing information.
+ */
+
+#pragma once
+
+#include <renderers/vulkan/managers/sceneresourceset.h>
+
+#include <backend/handles_p.h>
+
+namespace Qt3DRaytrace {
+
+namespace Raytrace {
+class EntityManager;
+} // Raytrace
+
+namespace Vulkan {
+
+// Renderable & emissive entities of the scene. Does not depend on a device, hence also used by host-only renderers.
+class SceneEntities
+{
+public:
+    void gather(Raytrace::EntityManager *entityManager);
+
+    uint32_t lookupRenderableIndex(Qt3DCore::QNodeId entityNodeId) const
+    {
+        return m_renderables.lookupIndex(entityNodeId);
+    }
+    uint32_t lookupEmissiveIndex(Qt3DCore::QNodeId entityNodeId) const
+    {
+        return m_emissives.lookupIndex(entityNodeId);
+    }
+
+    const QVector<Raytrace::HEntity> &renderables() const
+    {
+        return m_renderables.resources();
+    }
+    const QVector<Raytrace::HEntity> &emissives() const
+    {
+        return m_emissives.resources();
+    }
+
+private:
+    SceneResourceSet<Raytrace::HEntity> m_renderables;
+    SceneResourceSet<Raytrace::HEntity> m_emissives;
+};
+
+} // Vulkan
+} // Qt3DRaytrace
@@ -29,8 +29,18 @@ void SceneManager::addOrUpdateGeometry(Qt3DCore::QNodeId geometryNodeId, const G
 {
     DescriptorManager *descriptorManager = m_renderer->descriptorManager();
     Q_ASSERT(descriptorManager);
+    Device *device = m_renderer->device();
+    Q_ASSERT(device);
 
-    QWriteLocker lock(&m_rwlock);
+    Utility::InstrumentedWriteLocker lock(&m_rwlock);
+
+    Geometry previousGeometry;
+    if(m_geometry.lookupResource(geometryNodeId, previousGeometry) != ~0u) {
+        m_geometryBytes.fetchAndSubRelaxed(device->allocationSize(previousGeometry.attributes.allocation) + device->allocationSize(previousGeometry.indices.allocation));
+        m_accelerationStructureBytes.fetchAndSubRelaxed(device->allocationSize(previousGeometry.blas.allocation));
+    }
+    m_geometryBytes.fetchAndAddRelaxed(device->allocationSize(geometry.attributes.allocation) + device->allocationSize(geometry.indices.allocation));
+    m_accelerationStructureBytes.fetchAndAddRelaxed(device->allocationSize(geometry.blas.allocation));
 
     DescriptorHandle geometryAttributesDescriptor = descriptorManager->allocateDescriptor(ResourceClass::AttributeBuffer);
     DescriptorHandle geometryIndicesDescriptor = descriptorManager->allocateDescriptor(ResourceClass::IndexBuffer);
@@ -42,7 +52,7 @@ void SceneManager::addOrUpdateGeometry(Qt3DCore::QNodeId geometryNodeId, const G
 
 void SceneManager::addOrUpdateMaterial(Qt3DCore::QNodeId materialNodeId, const Material &material)
 {
-    QWriteLocker lock(&m_rwlock);
+    Utility::InstrumentedWriteLocker lock(&m_rwlock);
     m_materials.addOrUpdateResource(materialNodeId, material);
 }
 
@@ -50,8 +60,16 @@ void SceneManager::addOrUpdateTexture(Qt3DCore::QNodeId textureImageNodeId, cons
 {
     DescriptorManager *descriptorManager = m_renderer->descriptorManager();
     Q_ASSERT(descriptorManager);
+    Device *device = m_renderer->device();
+    Q_ASSERT(device);
+
+    Utility::InstrumentedWriteLocker lock(&m_rwlock);
 
-    QWriteLocker lock(&m_rwlock);
+    Image previousTextureImage;
+    if(m_textures.lookupResource(textureImageNodeId, previousTextureImage) != ~0u) {
+        m_textureBytes.fetchAndSubRelaxed(device->allocationSize(previousTextureImage.allocation));
+    }
+    m_textureBytes.fetchAndAddRelaxed(device->allocationSize(textureImage.allocation));
 
     DescriptorHandle textureImageDescriptor = descriptorManager->allocateDescriptor(ResourceClass::TextureImage);
     descriptorManager->updateImageDescriptor(textureImageDescriptor, DescriptorImageInfo(textureImage.view, ImageState::ShaderRead));
@@ -59,82 +77,83 @@ void SceneManager::addOrUpdateTexture(Qt3DCore::QNodeId textureImageNodeId, cons
     m_textures.addOrUpdateResource(textureImageNodeId, textureImage);
 }
 
+void SceneManager::finishGeometryBuild(double buildTime)
+{
+    m_numPendingUploads.fetchAndSubRelaxed(1);
+    m_geometryBuildTimes.add(buildTime);
+}
+
+void SceneManager::finishTextureUpload(double uploadTime)
+{
+    m_numPendingUploads.fetchAndSubRelaxed(1);
+    m_textureUploadTimes.add(uploadTime);
+}
+
 void SceneManager::updateEmitters(QVector<Emitter> &emitters)
 {
-    QWriteLocker lock(&m_rwlock);
+    Utility::InstrumentedWriteLocker lock(&m_rwlock);
     m_emitters = std::move(emitters);
 }
 
 void SceneManager::updateSceneTLAS(const AccelerationStructure &tlas, uint32_t instanceCount)
 {
-    QWriteLocker lock(&m_rwlock);
+    Utility::InstrumentedWriteLocker lock(&m_rwlock);
     m_tlas.update(tlas, m_renderer->numConcurrentFrames());
     m_tlasInstanceCount = instanceCount;
 }
 
 void SceneManager::updateMaterialBuffer(const Buffer &buffer)
 {
-    QWriteLocker lock(&m_rwlock);
+    Utility::InstrumentedWriteLocker lock(&m_rwlock);
     m_materialBuffer.update(buffer, m_renderer->numConcurrentFrames());
 }
 
 void SceneManager::updateEmitterBuffer(const Buffer &buffer)
 {
-    QWriteLocker lock(&m_rwlock);
+    Utility::InstrumentedWriteLocker lock(&m_rwlock);
     m_emitterBuffer.update(buffer, m_renderer->numConcurrentFrames());
 }
 
 void SceneManager::updateInstanceBuffer(const Buffer &buffer)
 {
-    QWriteLocker lock(&m_rwlock);
+    Utility::InstrumentedWriteLocker lock(&m_rwlock);
     m_instanceBuffer.update(buffer, m_renderer->numConcurrentFrames());
 }
 
 uint32_t SceneManager::lookupGeometry(Qt3DCore::QNodeId geometryNodeId, Geometry &geometry) const
 {
-    QReadLocker lock(&m_rwlock);
+    Utility::InstrumentedReadLocker lock(&m_rwlock);
     return m_geometry.lookupResource(geometryNodeId, geometry);
 }
 
 uint32_t SceneManager::lookupGeometryIndex(Qt3DCore::QNodeId geometryNodeId) const
 {
-    QReadLocker lock(&m_rwlock);
+    Utility::InstrumentedReadLocker lock(&m_rwlock);
     return m_geometry.lookupIndex(geometryNodeId);
 }
 
 uint32_t SceneManager::lookupMaterial(Qt3DCore::QNodeId materialNodeId, Material &material) const
 {
-    QReadLocker lock(&m_rwlock);
+    Utility::InstrumentedReadLocker lock(&m_rwlock);
     return m_materials.lookupResource(materialNodeId, material);
 }
 
 uint32_t SceneManager::lookupMaterialIndex(Qt3DCore::QNodeId materialNodeId) const
 {
-    QReadLocker lock(&m_rwlock);
+    Utility::InstrumentedReadLocker lock(&m_rwlock);
     return m_materials.lookupIndex(materialNodeId);
 }
 
 uint32_t SceneManager::lookupTextureIndex(Qt3DCore::QNodeId textureImageNodeId) const
 {
-    QReadLocker lock(&m_rwlock);
+    Utility::InstrumentedReadLocker lock(&m_rwlock);
     return m_textures.lookupIndex(textureImageNodeId);
 }
 
 void SceneManager::gatherEntities(Raytrace::EntityManager *entityManager)
 {
-    Q_ASSERT(entityManager);
-
     // NO LOCK: Access from render/aspect thread only.
-    m_renderables.clear();
-    m_emissives.clear();
-    for(const auto &entity : entityManager->activeHandles()) {
-        if(entity->isRenderable()) {
-            m_renderables.addResource(entity->peerId(), entity->handle());
-        }
-        if(entity->isEmissive()) {
-            m_emissives.addResource(entity->peerId(), entity->handle());
-        }
-    }
+    m_entities.gather(entityManager);
 }
 
 void SceneManager::updateRetiredResources()
@@ -189,6 +208,10 @@ void SceneManager::destroyResources()
         device->destroyImage(texture);
     }
     m_materials.clear();
+
+    m_geometryBytes.store(0);
+    m_accelerationStructureBytes.store(0);
+    m_textureBytes.store(0);
 }
 
 void SceneManager::destroyExpiredResources()
@@ -196,7 +219,7 @@ void SceneManager::destroyExpiredResources()
     Device *device = m_renderer->device();
     Q_ASSERT(device);
 
-    QWriteLocker lock(&m_rwlock);
+    Utility::InstrumentedWriteLocker lock(&m_rwlock);
     QVarLengthArray<AccelerationStructure> expiredTLAS = m_tlas.takeExpired();
     QVarLengthArray<Buffer> expiredInstanceBuffers = m_instanceBuffer.takeExpired();
     QVarLengthArray<Buffer> expiredMaterialBuffers = m_materialBuffer.takeExpired();
@@ -229,18 +252,18 @@ bool SceneManager::isReadyToRender() const
 const QVector<Raytrace::HEntity> &SceneManager::renderables() const
 {
     // NO LOCK: Access from render/aspect thread only.
-    return m_renderables.resources();
+    return m_entities.renderables();
 }
 
 const QVector<Raytrace::HEntity> &SceneManager::emissives() const
 {
     // NO LOCK: Access from render/aspect thread only.
-    return m_emissives.resources();
+    return m_entities.emissives();
 }
 
 AccelerationStructure SceneManager::sceneTLAS(uint32_t *instanceCount) const
 {
-    QReadLocker lock(&m_rwlock);
+    Utility::InstrumentedReadLocker lock(&m_rwlock);
     if(instanceCount) {
         *instanceCount = m_tlasInstanceCount;
     }
@@ -267,19 +290,19 @@ Buffer SceneManager::emitterBuffer() const
 
 uint32_t SceneManager::lookupRenderableIndex(Qt3DCore::QNodeId entityNodeId) const
 {
-    QReadLocker lock(&m_rwlock);
-    return m_renderables.lookupIndex(entityNodeId);
+    Utility::InstrumentedReadLocker lock(&m_rwlock);
+    return m_entities.lookupRenderableIndex(entityNodeId);
 }
 
 uint32_t SceneManager::lookupEmissiveIndex(Qt3DCore::QNodeId entityNodeId) const
 {
-    QReadLocker lock(&m_rwlock);
-    return m_emissives.lookupIndex(entityNodeId);
+    Utility::InstrumentedReadLocker lock(&m_rwlock);
+    return m_entities.lookupEmissiveIndex(entityNodeId);
 }
 
 QVector<Material> SceneManager::materials() const
 {
-    QReadLocker lock(&m_rwlock);
+    Utility::InstrumentedReadLocker lock(&m_rwlock);
     auto result = m_materials.resources();
     result.detach();
     return result;
@@ -287,7 +310,7 @@ QVector<Material> SceneManager::materials() const
 
 QVector<Geometry> SceneManager::geometry() const
 {
-    QReadLocker lock(&m_rwlock);
+    Utility::InstrumentedReadLocker lock(&m_rwlock);
     auto result = m_geometry.resources();
     result.detach();
     return result;
@@ -295,7 +318,7 @@ QVector<Geometry> SceneManager::geometry() const
 
 QVector<Emitter> SceneManager::emitters() const
 {
-    QReadLocker lock(&m_rwlock);
+    Utility::InstrumentedReadLocker lock(&m_rwlock);
     auto result = m_emitters;
     result.detach();
     return result;
@@ -303,25 +326,25 @@ QVector<Emitter> SceneManager::emitters() const
 
 uint32_t SceneManager::numMaterials() const
 {
-    QReadLocker lock(&m_rwlock);
+    Utility::InstrumentedReadLocker lock(&m_rwlock);
     return uint32_t(m_materials.resources().size());
 }
 
 uint32_t SceneManager::numGeometry() const
 {
-    QReadLocker lock(&m_rwlock);
+    Utility::InstrumentedReadLocker lock(&m_rwlock);
     return uint32_t(m_geometry.resources().size());
 }
 
 uint32_t SceneManager::numTextures() const
 {
-    QReadLocker lock(&m_rwlock);
+    Utility::InstrumentedReadLocker lock(&m_rwlock);
     return uint32_t(m_textures.resources().size());
 }
 
 uint32_t SceneManager::numEmitters() const
 {
-    QReadLocker lock(&m_rwlock);
+    Utility::InstrumentedReadLocker lock(&m_rwlock);
     return uint32_t(m_emitters.size());
 }
 
@@ -11,10 +11,13 @@
 #include <renderers/vulkan/geometry.h>
 #include <renderers/vulkan/glsl.h>
 #include <renderers/vulkan/managers/sceneresourceset.h>
+#include <renderers/vulkan/managers/sceneentities.h>
 
 #include <backend/handles_p.h>
+#include <utility/latencyhistogram.h>
+#include <utility/lockstatistics.h>
 
-#include <QReadWriteLock>
+#include <QAtomicInteger>
 
 namespace Qt3DRaytrace {
 
@@ -76,9 +79,23 @@ public:
     uint32_t numTextures() const;
     uint32_t numEmitters() const;
 
+    VkDeviceSize geometryBytes() const { return m_geometryBytes.load(); }
+    VkDeviceSize accelerationStructureBytes() const { return m_accelerationStructureBytes.load(); }
+    VkDeviceSize textureBytes() const { return m_textureBytes.load(); }
+
+    void addPendingUploads(uint32_t count) { m_numPendingUploads.fetchAndAddRelaxed(count); }
+    void finishGeometryBuild(double buildTime);
+    void finishTextureUpload(double uploadTime);
+    uint32_t numPendingUploads() const { return m_numPendingUploads.load(); }
+
+    const Utility::LatencyHistogram &geometryBuildTimes() const { return m_geometryBuildTimes; }
+    const Utility::LatencyHistogram &textureUploadTimes() const { return m_textureUploadTimes; }
+
+    // Only collected while Utility::LockStatistics is enabled.
+    const Utility::LockStatistics &lockStatistics() const { return m_rwlock.statistics(); }
+
 private:
-    SceneResourceSet<Raytrace::HEntity> m_renderables;
-    SceneResourceSet<Raytrace::HEntity> m_emissives;
+    SceneEntities m_entities;
 
     SceneResourceSet<Geometry> m_geometry;
     SceneResourceSet<Material> m_materials;
@@ -92,9 +109,16 @@ private:
     ManagedResource<Buffer> m_materialBuffer;
     ManagedResource<Buffer> m_emitterBuffer;
 
+    QAtomicInteger<quint64> m_geometryBytes;
+    QAtomicInteger<quint64> m_accelerationStructureBytes;
+    QAtomicInteger<quint64> m_textureBytes;
+    QAtomicInteger<uint32_t> m_numPendingUploads;
+    Utility::LatencyHistogram m_geometryBuildTimes;
+    Utility::LatencyHistogram m_textureUploadTimes;
+
     Renderer *m_renderer;
 
-    mutable QReadWriteLock m_rwlock;
+    mutable Utility::InstrumentedReadWriteLock m_rwlock;
 };
 
 } // Vulkan
@@ -24,6 +24,9 @@
 #include <backend/managers_p.h>
 #include <backend/rendersettings_p.h>
 
+#include <utility/tracing.h>
+#include <utility/startuptiming.h>
+
 #include <QVulkanInstance>
 #include <QWindow>
 #include <QThread>
@@ -49,6 +52,35 @@ constexpr uint32_t GlobalMaxRecursionDepth = 16;
 
 Q_LOGGING_CATEGORY(logVulkan, "raytrace.vulkan")
 
+static QLatencyStatistics latencyStatistics(const Utility::LatencyHistogram &histogram)
+{
+    QLatencyStatistics stats;
+    stats.p50 = histogram.percentile(0.50);
+    stats.p95 = histogram.percentile(0.95);
+    stats.p99 = histogram.percentile(0.99);
+    stats.max = histogram.maximum();
+    stats.numSamples = histogram.count();
+    return stats;
+}
+
+static QLockStatistics lockStatistics(const Utility::LockStatistics &lock)
+{
+    using Access = Utility::LockStatistics::Access;
+
+    QLockStatistics stats;
+    stats.numReadLocks = lock.numAcquisitions(Access::Read);
+    stats.numWriteLocks = lock.numAcquisitions(Access::Write);
+    stats.numContendedReadLocks = lock.numContended(Access::Read);
+    stats.numContendedWriteLocks = lock.numContended(Access::Write);
+    stats.totalReadWaitTime = lock.totalWaitTime(Access::Read);
+    stats.totalWriteWaitTime = lock.totalWaitTime(Access::Write);
+    stats.totalReadHoldTime = lock.totalHoldTime(Access::Read);
+    stats.totalWriteHoldTime = lock.totalHoldTime(Access::Write);
+    stats.readWaitTimes = latencyStatistics(lock.waitTimes(Access::Read));
+    stats.writeWaitTimes = latencyStatistics(lock.waitTimes(Access::Write));
+    return stats;
+}
+
 Renderer::Renderer(QObject *parent)
     : QObject(parent)
     , m_renderFrameTimer(new QTimer(this))
@@ -60,12 +92,21 @@ Renderer::Renderer(QObject *parent)
     , m_updateInstanceBufferJob(new UpdateInstanceBufferJob(this))
     , m_updateEmittersJob(new UpdateEmittersJob(this))
 {
+    SceneJobGraph::JobFactory sceneJobFactory;
+    sceneJobFactory.createGeometryJobs = [this]() { return createGeometryJobs(); };
+    sceneJobFactory.createTextureJobs = [this]() { return createTextureJobs(); };
+    sceneJobFactory.createMaterialJobs = [this](bool forceAllDirty) { return createMaterialJobs(forceAllDirty); };
+    sceneJobFactory.createSceneTLASJob = [this]() { return BuildSceneTopLevelAccelerationStructureJobPtr::create(this); };
+    m_sceneJobGraph.reset(new SceneJobGraph(sceneJobFactory, m_updateWorldTransformJob, m_updateInstanceBufferJob, m_updateEmittersJob));
+
     initializeResources();
     QObject::connect(m_renderFrameTimer, &QTimer::timeout, this, &Renderer::renderFrame);
 }
 
 bool Renderer::initialize()
 {
+    Utility::StartupPhaseScope startupPhase(QStartupPhase::RendererInitialization);
+
     static const QByteArrayList RequiredDeviceExtensions {
         VK_KHR_SWAPCHAIN_EXTENSION_NAME,
         VK_NV_RAY_TRACING_EXTENSION_NAME,
@@ -167,6 +208,7 @@ QVector<Qt3DCore::QAspectJobPtr> Renderer::createGeometryJobs()
         }
     }
 
+    m_sceneManager->addPendingUploads(uint32_t(buildGeometryJobs.size()));
     geometryJobs.append(buildGeometryJobs);
     return geometryJobs;
 }
@@ -188,6 +230,7 @@ QVector<Qt3DCore::QAspectJobPtr> Renderer::createTextureJobs()
         }
     }
 
+    m_sceneManager->addPendingUploads(uint32_t(uploadTextureJobs.size()));
     textureJobs.append(uploadTextureJobs);
     return textureJobs;
 }
@@ -399,6 +442,7 @@ void Renderer::beginRenderIteration()
         m_renderParams.numSecondarySamples = m_settings->secondarySamples();
         m_renderParams.minDepth = m_settings->minDepth();
         m_renderParams.maxDepth = m_settings->maxDepth();
+        m_renderParams.randomSeed = m_settings->randomSeed();
         m_renderParams.directRadianceClamp = m_settings->directRadianceClamp();
         m_renderParams.indirectRadianceClamp = m_settings->indirectRadianceClamp();
     }
@@ -610,6 +654,7 @@ bool Renderer::submitFrameCommands()
 void Renderer::renderFrame()
 {
     Q_ASSERT(m_device);
+    Utility::TraceScope trace("renderFrame", m_frameNumber);
 
     QReadLocker lock(&m_windowSurfaceLock);
     if(!m_window) {
@@ -731,7 +776,17 @@ void Renderer::renderFrame()
     // TODO: Don't wait on previous frame query availability (though in practice it doesn't seem to reduce performance).
     double previousDeviceTime = -1.0;
     m_device->queryTimeElapsed(m_defaultQueryPool, previousFrameQueryIndex, previousDeviceTime, VK_QUERY_RESULT_WAIT_BIT);
-    updateFrameTimings(frameTimer.nsecsElapsed() * 1e-6, previousDeviceTime);
+    updateFrameTimings(frameTimer.nsecsElapsed() * 1e-6, previousDeviceTime, m_device->takeStagingBytes());
+
+    if(Utility::StartupTiming::isActive()) {
+        const bool sceneComplete = m_sceneManager->isReadyToRender()
+                && m_sceneManager->numPendingUploads() == 0
+                && m_nodeManagers->geometryRendererManager.numPendingLoads() == 0
+                && m_nodeManagers->textureManager.numPendingLoads() == 0;
+        if(Utility::StartupTiming::markFrameRendered(sceneComplete)) {
+            qCInfo(logVulkan).noquote() << "Startup:" << Utility::StartupTiming::summary();
+        }
+    }
 }
 
 VkPhysicalDevice Renderer::choosePhysicalDevice(const QByteArrayList &requiredExtensions, uint32_t &queueFamilyIndex) const
@@ -862,13 +917,16 @@ RenderPass Renderer::createDisplayRenderPass(VkFormat swapchainFormat) const
     return renderPass;
 }
 
-void Renderer::updateFrameTimings(double cpuFrameTime, double gpuFrameTime)
+void Renderer::updateFrameTimings(double cpuFrameTime, double gpuFrameTime, VkDeviceSize stagingBytes)
 {
     QWriteLocker lock(&m_frameTimingsLock);
     m_hostTimeAverage.add(cpuFrameTime);
+    m_hostTimeHistogram.add(cpuFrameTime);
     if(gpuFrameTime > 0.0) {
         m_deviceTimeAverage.add(gpuFrameTime);
+        m_deviceTimeHistogram.add(gpuFrameTime);
     }
+    m_lastFrameStagingBytes = stagingBytes;
 }
 
 QImageData Renderer::grabImage(const Image *image, ImageState imageState, uint32_t width, uint32_t height, VkFormat format)
@@ -995,13 +1053,50 @@ Raytrace::RenderSettings *Renderer::settings() const
 
 QRenderStatistics Renderer::statistics() const
 {
-    QReadLocker lock(&m_frameTimingsLock);
+    QRenderStatistics stats = {};
 
-    QRenderStatistics stats;
+    QReadLocker lock(&m_frameTimingsLock);
     stats.cpuFrameTime = m_hostTimeAverage.average();
     stats.gpuFrameTime = m_deviceTimeAverage.average();
     stats.totalRenderTime = m_frameElapsedTimer.elapsed() * 1e-3;
     stats.numFramesRendered = m_frameNumber;
+    stats.resources.stagingBytesLastFrame = m_lastFrameStagingBytes;
+    lock.unlock();
+
+    // Histograms and resource counters below are maintained incrementally by their owners and are safe to read concurrently.
+    stats.cpuFrameTimes = latencyStatistics(m_hostTimeHistogram);
+    stats.gpuFrameTimes = latencyStatistics(m_deviceTimeHistogram);
+
+    QRenderResourceStatistics &resources = stats.resources;
+    if(m_sceneManager) {
+        stats.geometryBuildTimes = latencyStatistics(m_sceneManager->geometryBuildTimes());
+        stats.textureUploadTimes = latencyStatistics(m_sceneManager->textureUploadTimes());
+        stats.sceneLock = lockStatistics(m_sceneManager->lockStatistics());
+
+        resources.numGeometries = m_sceneManager->numGeometry();
+        resources.numBottomLevelAccelerationStructures = resources.numGeometries;
+        resources.numTextures = m_sceneManager->numTextures();
+        resources.geometryBytes = m_sceneManager->geometryBytes();
+        resources.accelerationStructureBytes = m_sceneManager->accelerationStructureBytes();
+        resources.textureBytes = m_sceneManager->textureBytes();
+        resources.numPendingUploads = m_sceneManager->numPendingUploads();
+    }
+    if(m_descriptorManager) {
+        resources.numDescriptors = m_descriptorManager->numAllocatedDescriptors();
+        resources.descriptorCapacity = m_descriptorManager->totalDescriptorCapacity();
+    }
+    if(m_device) {
+        resources.numDeviceAllocations = m_device->numAllocations();
+        resources.deviceAllocatedBytes = m_device->allocatedBytes();
+        resources.deviceLocalMemoryCapacity = m_device->deviceLocalMemoryCapacity();
+    }
+    if(m_nodeManagers) {
+        stats.geometryLoadTimes = latencyStatistics(m_nodeManagers->geometryRendererManager.loadTimes());
+        stats.textureLoadTimes = latencyStatistics(m_nodeManagers->textureManager.loadTimes());
+
+        resources.hostPayloadBytes = quint64(m_nodeManagers->geometryManager.payloadBytes() + m_nodeManagers->textureImageManager.payloadBytes());
+        resources.numPendingLoads = unsigned(m_nodeManagers->geometryRendererManager.numPendingLoads() + m_nodeManagers->textureManager.numPendingLoads());
+    }
     return stats;
 }
 
@@ -1048,76 +1143,21 @@ QVector<Qt3DCore::QAspectJobPtr> Renderer::jobsToExecute(qint64 time)
     QVector<Qt3DCore::QAspectJobPtr> jobs;
 
     bool shouldUpdateRenderParameters = false;
-    bool shouldUpdateInstanceBuffer = false;
-    bool shouldUpdateEmitters = false;
-    bool shouldUpdateTLAS = false;
-    bool sceneEntitiesDirty = false;
 
     m_updateRenderParametersJob->removeDependency(m_updateWorldTransformJob);
 
-    m_updateInstanceBufferJob->removeDependency(m_updateWorldTransformJob);
-    m_updateInstanceBufferJob->removeDependency(Qt3DCore::QAspectJobPtr());
-
-    m_updateEmittersJob->removeDependency(m_updateWorldTransformJob);
-    m_updateEmittersJob->removeDependency(Qt3DCore::QAspectJobPtr());
-
     jobs.append(m_destroyExpiredResourcesJob);
 
     if(m_dirtySet != DirtyFlag::NoneDirty) {
         resetRenderProgress();
     }
 
-    if(m_dirtySet & DirtyFlag::EntityDirty || m_dirtySet & DirtyFlag::GeometryDirty) {
-        shouldUpdateInstanceBuffer = true;
-        shouldUpdateEmitters = true;
-        shouldUpdateTLAS = true;
-        sceneEntitiesDirty = true;
-    }
-    if(m_dirtySet & DirtyFlag::LightDirty) {
-        shouldUpdateEmitters = true;
-        sceneEntitiesDirty = true;
-    }
-
     if(m_dirtySet & DirtyFlag::TransformDirty) {
-        jobs.append(m_updateWorldTransformJob);
         m_updateRenderParametersJob->addDependency(m_updateWorldTransformJob);
-        m_updateInstanceBufferJob->addDependency(m_updateWorldTransformJob);
-        m_updateEmittersJob->addDependency(m_updateWorldTransformJob);
-        shouldUpdateTLAS = true;
         shouldUpdateRenderParameters = true;
-        shouldUpdateInstanceBuffer = true;
-        shouldUpdateEmitters = true;
     }
 
-    QVector<Qt3DCore::QAspectJobPtr> geometryJobs;
-    if(m_dirtySet & DirtyFlag::GeometryDirty) {
-        geometryJobs = createGeometryJobs();
-        jobs.append(geometryJobs);
-        shouldUpdateTLAS = true;
-        shouldUpdateInstanceBuffer = true;
-        shouldUpdateEmitters = true;
-    }
-
-    QVector<Qt3DCore::QAspectJobPtr> textureJobs;
-    if(m_dirtySet & DirtyFlag::TextureDirty) {
-        textureJobs = createTextureJobs();
-        jobs.append(textureJobs);
-        shouldUpdateEmitters = true;
-    }
-
-    QVector<Qt3DCore::QAspectJobPtr> materialJobs;
-    if(m_dirtySet & DirtyFlag::MaterialDirty || m_dirtySet & DirtyFlag::TextureDirty) {
-        bool forceUpdateAllMaterials = (m_dirtySet & DirtyFlag::TextureDirty);
-        materialJobs = createMaterialJobs(forceUpdateAllMaterials);
-        jobs.append(materialJobs);
-        for(const auto &materialJob : materialJobs) {
-            for(const auto &textureJob : textureJobs) {
-                materialJob->addDependency(textureJob);
-            }
-        }
-        shouldUpdateInstanceBuffer = true;
-        shouldUpdateEmitters = true;
-    }
+    const SceneJobGraph::Frame sceneFrame = m_sceneJobGraph->beginFrame(m_dirtySet, jobs);
 
     if(m_dirtySet & DirtyFlag::CameraDirty) {
         updateActiveCamera();
@@ -1130,43 +1170,14 @@ QVector<Qt3DCore::QAspectJobPtr> Renderer::jobsToExecute(qint64 time)
         jobs.append(m_updateRenderParametersJob);
     }
 
-    if(sceneEntitiesDirty) {
+    if(sceneFrame.sceneEntitiesDirty) {
         m_sceneManager->gatherEntities(&m_nodeManagers->entityManager);
     }
     if(m_sceneManager->renderables().size() == 0) {
         return jobs;
     }
 
-    if(shouldUpdateTLAS) {
-        Qt3DCore::QAspectJobPtr buildSceneTLASJob = BuildSceneTopLevelAccelerationStructureJobPtr::create(this);
-        buildSceneTLASJob->addDependency(m_updateWorldTransformJob);
-        for(const auto &job : geometryJobs) {
-            buildSceneTLASJob->addDependency(job);
-        }
-        jobs.append(buildSceneTLASJob);
-    }
-    if(shouldUpdateInstanceBuffer) {
-        for(const auto &job : geometryJobs) {
-            m_updateInstanceBufferJob->addDependency(job);
-        }
-        for(const auto &job : materialJobs) {
-            m_updateInstanceBufferJob->addDependency(job);
-        }
-        jobs.append(m_updateInstanceBufferJob);
-    }
-    if(shouldUpdateEmitters) {
-        for(const auto &job : geometryJobs) {
-            m_updateEmittersJob->addDependency(job);
-        }
-        for(const auto &job : materialJobs) {
-            m_updateEmittersJob->addDependency(job);
-        }
-        for(const auto &job : textureJobs) {
-            m_updateEmittersJob->addDependency(job);
-        }
-        jobs.append(m_updateEmittersJob);
-    }
-
+    m_sceneJobGraph->endFrame(sceneFrame, jobs);
     return jobs;
 }
 
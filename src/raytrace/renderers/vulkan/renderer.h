@@ -12,6 +12,7 @@
 #include <renderers/vulkan/initializers.h>
 #include <renderers/vulkan/device.h>
 #include <renderers/vulkan/commandbuffer.h>
+#include <renderers/vulkan/scenejobgraph.h>
 #include <renderers/vulkan/services/frameadvanceservice.h>
 #include <renderers/vulkan/managers/commandbuffermanager.h>
 #include <renderers/vulkan/managers/descriptormanager.h>
@@ -25,6 +26,7 @@
 #include <renderers/vulkan/jobs/updateemittersjob.h>
 
 #include <utility/movingaverage.h>
+#include <utility/latencyhistogram.h>
 
 #include <Qt3DCore/QNodeId>
 
@@ -113,7 +115,7 @@ private:
     VkPhysicalDevice choosePhysicalDevice(const QByteArrayList &requiredExtensions, uint32_t &queueFamilyIndex) const;
     RenderPass createDisplayRenderPass(VkFormat swapchainFormat) const;
 
-    void updateFrameTimings(double cpuFrameTime, double gpuFrameTime);
+    void updateFrameTimings(double cpuFrameTime, double gpuFrameTime, VkDeviceSize stagingBytes);
     QImageData grabImage(const Image *image, ImageState imageState, uint32_t width, uint32_t height, VkFormat format);
 
     QVulkanInstance *m_instance = nullptr;
@@ -184,12 +186,16 @@ private:
     UpdateRenderParametersJobPtr m_updateRenderParametersJob;
     UpdateInstanceBufferJobPtr m_updateInstanceBufferJob;
     UpdateEmittersJobPtr m_updateEmittersJob;
+    QSharedPointer<SceneJobGraph> m_sceneJobGraph;
 
     Raytrace::Entity *m_sceneRoot = nullptr;
     DirtySet m_dirtySet = DirtyFlag::AllDirty;
 
     Utility::MovingAverage<double> m_deviceTimeAverage;
     Utility::MovingAverage<double> m_hostTimeAverage;
+    Utility::LatencyHistogram m_deviceTimeHistogram;
+    Utility::LatencyHistogram m_hostTimeHistogram;
+    VkDeviceSize m_lastFrameStagingBytes = 0;
 
     const Image *m_lastRenderBuffer = nullptr;
     const Image *m_lastSwapchainImage = nullptr;
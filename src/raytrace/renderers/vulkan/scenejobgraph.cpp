@@ -0,0 +1,121 @@
+/*
+ * Copyright (C) 2018-2019 Michał Siejak
+ * This file is part of Quartz - a raytracing aspect for Qt3D.
+ * See LICENSE file for licensing information.
+ */
+
+#include <renderers/vulkan/scenejobgraph.h>
+
+using namespace Qt3DCore;
+
+namespace Qt3DRaytrace {
+namespace Vulkan {
+
+SceneJobGraph::SceneJobGraph(const JobFactory &factory,
+                             const Raytrace::UpdateWorldTransformJobPtr &updateWorldTransformJob,
+                             const QAspectJobPtr &updateInstanceBufferJob,
+                             const QAspectJobPtr &updateEmittersJob)
+    : m_factory(factory)
+    , m_updateWorldTransformJob(updateWorldTransformJob)
+    , m_updateInstanceBufferJob(updateInstanceBufferJob)
+    , m_updateEmittersJob(updateEmittersJob)
+{
+    Q_ASSERT(m_factory.createGeometryJobs && m_factory.createTextureJobs && m_factory.createMaterialJobs && m_factory.createSceneTLASJob);
+    Q_ASSERT(m_updateWorldTransformJob && m_updateInstanceBufferJob && m_updateEmittersJob);
+}
+
+SceneJobGraph::Frame SceneJobGraph::beginFrame(DirtySet dirtySet, QVector<QAspectJobPtr> &jobs)
+{
+    Frame frame;
+
+    m_updateInstanceBufferJob->removeDependency(m_updateWorldTransformJob);
+    m_updateInstanceBufferJob->removeDependency(QAspectJobPtr());
+
+    m_updateEmittersJob->removeDependency(m_updateWorldTransformJob);
+    m_updateEmittersJob->removeDependency(QAspectJobPtr());
+
+    if(dirtySet & DirtyFlag::EntityDirty || dirtySet & DirtyFlag::GeometryDirty) {
+        frame.shouldUpdateInstanceBuffer = true;
+        frame.shouldUpdateEmitters = true;
+        frame.shouldUpdateTLAS = true;
+        frame.sceneEntitiesDirty = true;
+    }
+    if(dirtySet & DirtyFlag::LightDirty) {
+        frame.shouldUpdateEmitters = true;
+        frame.sceneEntitiesDirty = true;
+    }
+
+    if(dirtySet & DirtyFlag::TransformDirty) {
+        jobs.append(m_updateWorldTransformJob);
+        m_updateInstanceBufferJob->addDependency(m_updateWorldTransformJob);
+        m_updateEmittersJob->addDependency(m_updateWorldTransformJob);
+        frame.shouldUpdateTLAS = true;
+        frame.shouldUpdateInstanceBuffer = true;
+        frame.shouldUpdateEmitters = true;
+    }
+
+    if(dirtySet & DirtyFlag::GeometryDirty) {
+        frame.geometryJobs = m_factory.createGeometryJobs();
+        jobs.append(frame.geometryJobs);
+        frame.shouldUpdateTLAS = true;
+        frame.shouldUpdateInstanceBuffer = true;
+        frame.shouldUpdateEmitters = true;
+    }
+
+    if(dirtySet & DirtyFlag::TextureDirty) {
+        frame.textureJobs = m_factory.createTextureJobs();
+        jobs.append(frame.textureJobs);
+        frame.shouldUpdateEmitters = true;
+    }
+
+    if(dirtySet & DirtyFlag::MaterialDirty || dirtySet & DirtyFlag::TextureDirty) {
+        bool forceUpdateAllMaterials = (dirtySet & DirtyFlag::TextureDirty);
+        frame.materialJobs = m_factory.createMaterialJobs(forceUpdateAllMaterials);
+        jobs.append(frame.materialJobs);
+        for(const auto &materialJob : frame.materialJobs) {
+            for(const auto &textureJob : frame.textureJobs) {
+                materialJob->addDependency(textureJob);
+            }
+        }
+        frame.shouldUpdateInstanceBuffer = true;
+        frame.shouldUpdateEmitters = true;
+    }
+
+    return frame;
+}
+
+void SceneJobGraph::endFrame(const Frame &frame, QVector<QAspectJobPtr> &jobs)
+{
+    if(frame.shouldUpdateTLAS) {
+        QAspectJobPtr buildSceneTLASJob = m_factory.createSceneTLASJob();
+        buildSceneTLASJob->addDependency(m_updateWorldTransformJob);
+        for(const auto &job : frame.geometryJobs) {
+            buildSceneTLASJob->addDependency(job);
+        }
+        jobs.append(buildSceneTLASJob);
+    }
+    if(frame.shouldUpdateInstanceBuffer) {
+        for(const auto &job : frame.geometryJobs) {
+            m_updateInstanceBufferJob->addDependency(job);
+        }
+        for(const auto &job : frame.materialJobs) {
+            m_updateInstanceBufferJob->addDependency(job);
+        }
+        jobs.append(m_updateInstanceBufferJob);
+    }
+    if(frame.shouldUpdateEmitters) {
+        for(const auto &job : frame.geometryJobs) {
+            m_updateEmittersJob->addDependency(job);
+        }
+        for(const auto &job : frame.materialJobs) {
+            m_updateEmittersJob->addDependency(job);
+        }
+        for(const auto &job : frame.textureJobs) {
+            m_updateEmittersJob->addDependency(job);
+        }
+        jobs.append(m_updateEmittersJob);
+    }
+}
+
+} // Vulkan
+} // Qt3DRaytrace
@@ -0,0 +1,68 @@
+/*
+ * Copyright (C) 2018-2019 Michał Siejak
+ * This file is part of Quartz - a raytracing aspect for Qt3D.
+ * See LICENSE file for licensing information.
+ */
+
+#pragma once
+
+#include <backend/abstractrenderer_p.h>
+#include <jobs/updateworldtransformjob_p.h>
+
+#include <Qt3DCore/QAspectJob>
+#include <QVector>
+
+#include <functional>
+
+namespace Qt3DRaytrace {
+namespace Vulkan {
+
+// Device independent part of the per-frame job graph: decides which scene data needs updating for a set of dirty flags
+// and makes TLAS, instance buffer & emitter updates depend on the jobs they read from. Jobs doing the actual work
+// are supplied by the renderer.
+class SceneJobGraph
+{
+public:
+    using DirtySet = Raytrace::AbstractRenderer::DirtySet;
+    using DirtyFlag = Raytrace::AbstractRenderer::DirtyFlag;
+
+    struct JobFactory
+    {
+        std::function<QVector<Qt3DCore::QAspectJobPtr>()> createGeometryJobs;
+        std::function<QVector<Qt3DCore::QAspectJobPtr>()> createTextureJobs;
+        std::function<QVector<Qt3DCore::QAspectJobPtr>(bool forceAllDirty)> createMaterialJobs;
+        std::function<Qt3DCore::QAspectJobPtr()> createSceneTLASJob;
+    };
+
+    struct Frame
+    {
+        QVector<Qt3DCore::QAspectJobPtr> geometryJobs;
+        QVector<Qt3DCore::QAspectJobPtr> textureJobs;
+        QVector<Qt3DCore::QAspectJobPtr> materialJobs;
+        bool shouldUpdateInstanceBuffer = false;
+        bool shouldUpdateEmitters = false;
+        bool shouldUpdateTLAS = false;
+        bool sceneEntitiesDirty = false;
+    };
+
+    SceneJobGraph(const JobFactory &factory,
+                  const Raytrace::UpdateWorldTransformJobPtr &updateWorldTransformJob,
+                  const Qt3DCore::QAspectJobPtr &updateInstanceBufferJob,
+                  const Qt3DCore::QAspectJobPtr &updateEmittersJob);
+
+    // Appends world transform, geometry, texture & material jobs. If the returned frame has sceneEntitiesDirty set,
+    // renderable & emissive entities need to be gathered again before calling endFrame().
+    Frame beginFrame(DirtySet dirtySet, QVector<Qt3DCore::QAspectJobPtr> &jobs);
+
+    // Appends TLAS, instance buffer & emitter jobs; only valid if the scene has any renderable entities.
+    void endFrame(const Frame &frame, QVector<Qt3DCore::QAspectJobPtr> &jobs);
+
+private:
+    JobFactory m_factory;
+    Raytrace::UpdateWorldTransformJobPtr m_updateWorldTransformJob;
+    Qt3DCore::QAspectJobPtr m_updateInstanceBufferJob;
+    Qt3DCore::QAspectJobPtr m_updateEmittersJob;
+};
+
+} // Vulkan
+} // Qt3DRaytrace
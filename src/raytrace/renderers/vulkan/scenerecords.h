@@ -0,0 +1,122 @@
+/*
+ * Copyright (C) 2018-2019 Michał Siejak
+ * This file is part of Quartz - a raytracing aspect for Qt3D.
+ * See LICENSE file for licensing information.
+ */
+
+#pragma once
+
+#include <renderers/vulkan/glsl.h>
+
+#include <backend/managers_p.h>
+#include <backend/rendersettings_p.h>
+
+#include <QVector>
+#include <cstring>
+
+namespace Qt3DRaytrace {
+namespace Vulkan {
+
+// Per-instance, emitter & TLAS instance records of the scene, filled in host memory. SceneT provides the entity &
+// resource lookups of SceneManager, GeometryT is its geometry record; neither needs a device to be present.
+
+template<typename GeometryT, typename SceneT>
+void writeEntityInstances(const SceneT &scene, EntityInstance *instances)
+{
+    const auto &renderables = scene.renderables();
+    for(int instanceIndex=0; instanceIndex < renderables.size(); ++instanceIndex) {
+        const Raytrace::Entity *renderable = renderables[instanceIndex].data();
+        const Raytrace::GeometryRenderer *geometryRenderer = renderable->geometryRendererComponent();
+        Q_ASSERT(geometryRenderer);
+
+        EntityInstance &instance = instances[instanceIndex];
+        instance.materialIndex = scene.lookupMaterialIndex(renderable->materialComponentId());
+
+        GeometryT renderableGeometry;
+        instance.geometryIndex = scene.lookupGeometry(geometryRenderer->geometryId(), renderableGeometry);
+        instance.geometryNumFaces = renderableGeometry.numIndices / 3;
+
+        const QMatrix4x4 entityTransform = renderable->worldTransformMatrix.toQMatrix4x4();
+        instance.transform = entityTransform;
+        instance.basisTransform = entityTransform.normalMatrix();
+    }
+}
+
+template<typename SceneT>
+QVector<Emitter> gatherEmitters(const SceneT &scene, const Raytrace::RenderSettings *settings, uint32_t skyTextureIndex)
+{
+    // TODO: Update only dirty emissive entities.
+    // Currently there's no meaningful semantic determining which entities
+    // are dirty in the context of becoming emitters.
+
+    QVector<Emitter> emitters;
+    {
+        Emitter skyEmitter = {};
+        skyEmitter.instanceIndex = ~0u;
+        if(settings) {
+            settings->skyRadiance().writeToBuffer(skyEmitter.radiance.data);
+            skyEmitter.intensity = settings->skyIntensity();
+            skyEmitter.textureIndex = skyTextureIndex;
+            skyEmitter.direction = QVector3D(settings->skyTextureOffset(), 0.0f);
+        }
+        emitters.append(skyEmitter);
+    }
+
+    for(const auto &entity : scene.emissives()) {
+        const QMatrix4x4 entityTransform = entity->worldTransformMatrix.toQMatrix4x4();
+        if(!entity->distantLightComponentId().isNull()) {
+            const Raytrace::DistantLight *light = entity->distantLightComponent();
+            Q_ASSERT(light);
+
+            const QVector3D worldDirection = entityTransform.mapVector(light->direction()).normalized();
+
+            Emitter emitter = {};
+            emitter.instanceIndex = ~0u;
+            emitter.direction = worldDirection;
+            light->radiance().writeToBuffer(emitter.radiance.data);
+            emitters.append(emitter);
+        }
+        if(entity->isRenderable()) {
+            const Raytrace::Material *material = entity->materialComponent();
+            const Raytrace::GeometryRenderer *geometryRenderer = entity->geometryRendererComponent();
+            Q_ASSERT(material && geometryRenderer);
+
+            Emitter emitter = {};
+            emitter.instanceIndex = scene.lookupRenderableIndex(entity->peerId());
+            emitter.geometryIndex = scene.lookupGeometryIndex(geometryRenderer->geometryId());
+            material->emission().writeToBuffer(emitter.radiance.data);
+            emitters.append(emitter);
+        }
+    }
+    Q_ASSERT(emitters.size() >= 1);
+    return emitters;
+}
+
+template<typename GeometryInstanceT, typename GeometryT, typename SceneT>
+QVector<GeometryInstanceT> gatherGeometryInstances(const SceneT &scene)
+{
+    QVector<GeometryInstanceT> instances;
+
+    const auto &renderables = scene.renderables();
+    for(int instanceIndex = 0; instanceIndex < renderables.size(); ++instanceIndex) {
+        const auto &renderable = renderables[instanceIndex];
+        const Raytrace::GeometryRenderer *geometryRenderer = renderable->geometryRendererComponent();
+        Q_ASSERT(geometryRenderer);
+
+        GeometryT geometry;
+        uint32_t geometryIndex = scene.lookupGeometry(geometryRenderer->geometryId(), geometry);
+        if(geometryIndex != ~0u) {
+            const QMatrix4x4 worldTransformRowMajor = renderable->worldTransformMatrix.transposed().toQMatrix4x4();
+            GeometryInstanceT geometryInstance = {};
+            std::memcpy(geometryInstance.transform, worldTransformRowMajor.constData(), sizeof(geometryInstance.transform));
+            geometryInstance.mask = 0xFF;
+            geometryInstance.blasHandle = geometry.blasHandle;
+            geometryInstance.instanceCustomIndex = geometryIndex;
+            instances.append(geometryInstance);
+        }
+    }
+    return instances;
+}
+
+} // Vulkan
+} // Qt3DRaytrace
@@ -62,6 +62,8 @@ struct RenderParameters
     uint numSecondarySamples;
     float directRadianceClamp;
     float indirectRadianceClamp;
+    uint randomSeed;
+    float _padding[3];
     vec4 cameraPositionAspect;
     vec4 cameraUpVectorTanHalfFOV;
     vec4 cameraRightVectorLensR;
@@ -40,10 +40,10 @@ uint rngHash(uint seed)
     return seed;
 }
 
-RNG rngInit(uvec2 id, uint frameIndex)
+RNG rngInit(uvec2 id, uint frameIndex, uint seed)
 {
     uint s0 = (id.x << 16) | id.y;
-    uint s1 = frameIndex;
+    uint s1 = frameIndex + seed * 0x9e3779b9;
 
     RNG rng;
     rng.s.x = rngHash(s0);
@@ -60,7 +60,7 @@ void main()
 
     vec3 prevColor = imageLoad(prevRenderBuffer, ivec2(gl_LaunchIDNV)).rgb;
 
-    pPathTrace.rng   = rngInit(gl_LaunchIDNV.xy, params.frameNumber);
+    pPathTrace.rng   = rngInit(gl_LaunchIDNV.xy, params.frameNumber, params.randomSeed);
     pPathTrace.depth = 0;
     pPathTrace.T     = vec3(1.0);
 
@@ -0,0 +1,424 @@
+/*
+ * Copyright (C) 2018-2019 Michał Siejak
+ * This file is part of Quartz - a raytracing aspect for Qt3D.
+ * See LICENSE file for licensing information.
+ */
+
+#include <replay/scenechangelog_p.h>
+
+#include <frontend/qabstracttexture_p.h>
+#include <frontend/qcameralens_p.h>
+#include <frontend/qdistantlight_p.h>
+#include <frontend/qgeometryrenderer_p.h>
+#include <frontend/qmaterial_p.h>
+#include <frontend/qrendersettings_p.h>
+
+#include <Qt3DRaytrace/qgeometry.h>
+#include <Qt3DRaytrace/qgeometrydata.h>
+#include <Qt3DRaytrace/qtextureimage.h>
+#include <Qt3DRaytrace/qimagedata.h>
+
+#include <Qt3DCore/QEntity>
+#include <Qt3DCore/QTransform>
+#include <Qt3DCore/private/qentity_p.h>
+#include <Qt3DCore/private/qnode_p.h>
+#include <Qt3DCore/private/qtransform_p.h>
+
+#include <QColor>
+#include <QVector2D>
+#include <QVector3D>
+#include <QQuaternion>
+
+#include <climits>
+
+using namespace Qt3DCore;
+
+namespace Qt3DRaytrace {
+namespace Raytrace {
+namespace SceneChangeLog {
+
+enum class ValueType : quint8
+{
+    Invalid = 0,
+    Variant,
+    NodeId,
+    GeometryData,
+    ImageData,
+    Unsupported,
+};
+
+static constexpr int NumNodeTypes = int(NodeType::Other) + 1;
+
+static const QMetaObject *const *nodeMetaObjects()
+{
+    static const QMetaObject *const metaObjects[NumNodeTypes] = {
+        &QEntity::staticMetaObject,
+        &Qt3DCore::QTransform::staticMetaObject,
+        &QCameraLens::staticMetaObject,
+        &QDistantLight::staticMetaObject,
+        &QGeometry::staticMetaObject,
+        &QGeometryRenderer::staticMetaObject,
+        &QAbstractTexture::staticMetaObject,
+        &QTextureImage::staticMetaObject,
+        &QMaterial::staticMetaObject,
+        &QRenderSettings::staticMetaObject,
+        &QComponent::staticMetaObject,
+    };
+    return metaObjects;
+}
+
+static void writeId(QDataStream &stream, QNodeId id)
+{
+    stream << id.id();
+}
+
+static QNodeId readId(QDataStream &stream, const IdResolver &resolveId)
+{
+    quint64 id;
+    stream >> id;
+    return resolveId(id);
+}
+
+template<typename T>
+static void writeArray(QDataStream &stream, const QVector<T> &array)
+{
+    stream << quint32(array.size());
+    stream.writeRawData(reinterpret_cast<const char*>(array.constData()), int(array.size() * int(sizeof(T))));
+}
+
+template<typename T>
+static void readArray(QDataStream &stream, QVector<T> &array)
+{
+    quint32 size;
+    stream >> size;
+    if(stream.status() != QDataStream::Ok || size > quint32(INT_MAX / int(sizeof(T)))) {
+        stream.setStatus(QDataStream::ReadCorruptData);
+        return;
+    }
+
+    const int numBytes = int(size) * int(sizeof(T));
+    array.resize(int(size));
+    if(stream.readRawData(reinterpret_cast<char*>(array.data()), numBytes) != numBytes) {
+        stream.setStatus(QDataStream::ReadPastEnd);
+    }
+}
+
+static void writeGeometryData(QDataStream &stream, const QGeometryData &data)
+{
+    writeArray(stream, data.vertices);
+    writeArray(stream, data.faces);
+}
+
+static QGeometryData readGeometryData(QDataStream &stream)
+{
+    QGeometryData data;
+    readArray(stream, data.vertices);
+    readArray(stream, data.faces);
+    return data;
+}
+
+static void writeImageData(QDataStream &stream, const QImageData &data)
+{
+    stream << qint32(data.width) << qint32(data.height) << qint32(data.channels)
+           << quint8(data.type) << quint8(data.format) << data.data;
+}
+
+static QImageData readImageData(QDataStream &stream)
+{
+    QImageData data;
+    qint32 width, height, channels;
+    quint8 type, format;
+    stream >> width >> height >> channels >> type >> format >> data.data;
+    data.width = width;
+    data.height = height;
+    data.channels = channels;
+    data.type = QImageData::ValueType(type);
+    data.format = QImageData::Format(format);
+    return data;
+}
+
+template<typename T>
+static QNodeCreatedChangeBasePtr createdChange(const QNode *node, const T &data)
+{
+    auto change = QNodeCreatedChangePtr<T>::create(node);
+    change->data = data;
+    return change;
+}
+
+template<typename T>
+static const T &createdData(const QNodeCreatedChangeBasePtr &change)
+{
+    return qSharedPointerCast<QNodeCreatedChange<T>>(change)->data;
+}
+
+NodeType nodeType(const QMetaObject *metaObject)
+{
+    if(metaObject) {
+        const QMetaObject *const *metaObjects = nodeMetaObjects();
+        for(int index=0; index<int(NodeType::Other); ++index) {
+            if(metaObject->inherits(metaObjects[index])) {
+                return NodeType(index);
+            }
+        }
+    }
+    return NodeType::Other;
+}
+
+const QMetaObject *nodeMetaObject(NodeType type)
+{
+    const int index = qBound(0, int(type), int(NodeType::Other));
+    return nodeMetaObjects()[index];
+}
+
+std::unique_ptr<QNode> createProxyNode(NodeType type, QNodeId id)
+{
+    std::unique_ptr<QNode> node;
+    switch(type) {
+    case NodeType::Entity:
+        node.reset(new QEntity);
+        break;
+    case NodeType::Transform:
+        node.reset(new Qt3DCore::QTransform);
+        break;
+    case NodeType::CameraLens:
+        node.reset(new QCameraLens);
+        break;
+    case NodeType::DistantLight:
+        node.reset(new QDistantLight);
+        break;
+    case NodeType::Geometry:
+        node.reset(new QGeometry);
+        break;
+    case NodeType::GeometryRenderer:
+        node.reset(new QGeometryRenderer);
+        break;
+    case NodeType::Texture:
+        node.reset(new QAbstractTexture);
+        break;
+    case NodeType::TextureImage:
+        node.reset(new QTextureImage);
+        break;
+    case NodeType::Material:
+        node.reset(new QMaterial);
+        break;
+    case NodeType::RenderSettings:
+        node.reset(new QRenderSettings);
+        break;
+    default:
+        node.reset(new QComponent);
+        break;
+    }
+
+    // Proxy nodes never become part of a scene, so it is safe to give them the IDs of replayed nodes.
+    QNodePrivate::get(node.get())->m_id = id;
+    return node;
+}
+
+void writeCreationData(QDataStream &stream, NodeType type, const QNodeCreatedChangeBasePtr &change)
+{
+    switch(type) {
+    case NodeType::Entity: {
+        const auto &data = createdData<QEntityData>(change);
+        writeId(stream, data.parentEntityId);
+        stream << quint32(data.componentIdsAndTypes.size());
+        for(const QNodeIdTypePair &idAndType : data.componentIdsAndTypes) {
+            writeId(stream, idAndType.id);
+            stream << quint8(nodeType(idAndType.type));
+        }
+        break;
+    }
+    case NodeType::Transform: {
+        const auto &data = createdData<QTransformData>(change);
+        stream << data.rotation << data.scale << data.translation;
+        break;
+    }
+    case NodeType::CameraLens: {
+        const auto &data = createdData<QCameraLensData>(change);
+        stream << data.aspectRatio << data.fieldOfView << data.diameter << data.focalDistance
+               << data.gamma << data.exposure << data.tonemapFactor;
+        break;
+    }
+    case NodeType::DistantLight: {
+        const auto &data = createdData<QLightData>(change);
+        stream << data.color << data.intensity << data.direction;
+        break;
+    }
+    case NodeType::Geometry:
+        writeGeometryData(stream, createdData<QGeometryData>(change));
+        break;
+    case NodeType::GeometryRenderer:
+        // Geometry factories cannot be serialized; geometry they produce is recorded as separate nodes.
+        writeId(stream, createdData<QGeometryRendererData>(change).geometryId);
+        break;
+    case NodeType::Texture:
+        // Same as above for texture image factories.
+        writeId(stream, createdData<QTextureData>(change).imageId);
+        break;
+    case NodeType::TextureImage:
+        writeImageData(stream, createdData<QImageData>(change));
+        break;
+    case NodeType::Material: {
+        const auto &data = createdData<QMaterialData>(change);
+        stream << data.albedo << data.roughness << data.metalness << data.emission << data.emissionIntensity;
+        writeId(stream, data.albedoTextureId);
+        writeId(stream, data.roughnessTextureId);
+        writeId(stream, data.metalnessTextureId);
+        break;
+    }
+    case NodeType::RenderSettings: {
+        const auto &data = createdData<QRenderSettingsData>(change);
+        writeId(stream, data.cameraId);
+        stream << qint32(data.primarySamples) << qint32(data.secondarySamples)
+               << qint32(data.minDepth) << qint32(data.maxDepth) << qint32(data.randomSeed)
+               << data.directRadianceClamp << data.indirectRadianceClamp
+               << data.skyColor << data.skyIntensity;
+        writeId(stream, data.skyTextureId);
+        stream << data.skyTextureOffset;
+        break;
+    }
+    case NodeType::Other:
+        break;
+    }
+}
+
+QNodeCreatedChangeBasePtr readCreationChange(QDataStream &stream, NodeType type, const QNode *node, const IdResolver &resolveId)
+{
+    switch(type) {
+    case NodeType::Entity: {
+        QEntityData data;
+        data.parentEntityId = readId(stream, resolveId);
+        quint32 numComponents;
+        stream >> numComponents;
+        for(quint32 index=0; index<numComponents && stream.status() == QDataStream::Ok; ++index) {
+            const QNodeId componentId = readId(stream, resolveId);
+            quint8 componentType;
+            stream >> componentType;
+            data.componentIdsAndTypes.append(QNodeIdTypePair{componentId, nodeMetaObject(NodeType(componentType))});
+        }
+        return createdChange(node, data);
+    }
+    case NodeType::Transform: {
+        QTransformData data;
+        stream >> data.rotation >> data.scale >> data.translation;
+        return createdChange(node, data);
+    }
+    case NodeType::CameraLens: {
+        QCameraLensData data;
+        stream >> data.aspectRatio >> data.fieldOfView >> data.diameter >> data.focalDistance
+               >> data.gamma >> data.exposure >> data.tonemapFactor;
+        return createdChange(node, data);
+    }
+    case NodeType::DistantLight: {
+        QLightData data;
+        stream >> data.color >> data.intensity >> data.direction;
+        return createdChange(node, data);
+    }
+    case NodeType::Geometry:
+        return createdChange(node, readGeometryData(stream));
+    case NodeType::GeometryRenderer: {
+        QGeometryRendererData data;
+        data.geometryId = readId(stream, resolveId);
+        return createdChange(node, data);
+    }
+    case NodeType::Texture: {
+        QTextureData data;
+        data.imageId = readId(stream, resolveId);
+        return createdChange(node, data);
+    }
+    case NodeType::TextureImage:
+        return createdChange(node, readImageData(stream));
+    case NodeType::Material: {
+        QMaterialData data;
+        stream >> data.albedo >> data.roughness >> data.metalness >> data.emission >> data.emissionIntensity;
+        data.albedoTextureId = readId(stream, resolveId);
+        data.roughnessTextureId = readId(stream, resolveId);
+        data.metalnessTextureId = readId(stream, resolveId);
+        return createdChange(node, data);
+    }
+    case NodeType::RenderSettings: {
+        QRenderSettingsData data;
+        qint32 primarySamples, secondarySamples, minDepth, maxDepth, randomSeed;
+        data.cameraId = readId(stream, resolveId);
+        stream >> primarySamples >> secondarySamples >> minDepth >> maxDepth >> randomSeed
+               >> data.directRadianceClamp >> data.indirectRadianceClamp
+               >> data.skyColor >> data.skyIntensity;
+        data.skyTextureId = readId(stream, resolveId);
+        stream >> data.skyTextureOffset;
+        data.primarySamples = primarySamples;
+        data.secondarySamples = secondarySamples;
+        data.minDepth = minDepth;
+        data.maxDepth = maxDepth;
+        data.randomSeed = randomSeed;
+        return createdChange(node, data);
+    }
+    case NodeType::Other:
+        break;
+    }
+    return QNodeCreatedChangeBasePtr::create(node);
+}
+
+void writeValue(QDataStream &stream, const QVariant &value)
+{
+    const int userType = value.userType();
+    if(!value.isValid()) {
+        stream << quint8(ValueType::Invalid);
+    }
+    else if(userType == qMetaTypeId<QNodeId>()) {
+        stream << quint8(ValueType::NodeId);
+        writeId(stream, value.value<QNodeId>());
+    }
+    else if(userType == qMetaTypeId<QGeometryData>()) {
+        stream << quint8(ValueType::GeometryData);
+        writeGeometryData(stream, value.value<QGeometryData>());
+    }
+    else if(userType == qMetaTypeId<QImageData>()) {
+        stream << quint8(ValueType::ImageData);
+        writeImageData(stream, value.value<QImageData>());
+    }
+    else if(userType < QMetaType::User) {
+        stream << quint8(ValueType::Variant) << value;
+    }
+    else {
+        // Includes geometry & texture image factories which are replaced by null values on replay.
+        stream << quint8(ValueType::Unsupported) << QByteArray(value.typeName());
+    }
+}
+
+QVariant readValue(QDataStream &stream, const IdResolver &resolveId)
+{
+    quint8 valueType;
+    stream >> valueType;
+
+    switch(ValueType(valueType)) {
+    case ValueType::Invalid:
+        break;
+    case ValueType::Variant: {
+        QVariant value;
+        stream >> value;
+        return value;
+    }
+    case ValueType::NodeId:
+        return QVariant::fromValue(readId(stream, resolveId));
+    case ValueType::GeometryData:
+        return QVariant::fromValue(readGeometryData(stream));
+    case ValueType::ImageData:
+        return QVariant::fromValue(readImageData(stream));
+    case ValueType::Unsupported: {
+        QByteArray typeName;
+        stream >> typeName;
+        const int typeId = QMetaType::type(typeName.constData());
+        if(typeId != QMetaType::UnknownType) {
+            return QVariant(typeId, nullptr);
+        }
+        break;
+    }
+    default:
+        stream.setStatus(QDataStream::ReadCorruptData);
+        break;
+    }
+    return QVariant();
+}
+
+} // SceneChangeLog
+} // Raytrace
+} // Qt3DRaytrace
@@ -0,0 +1,85 @@
+/*
+ * Copyright (C) 2018-2019 Michał Siejak
+ * This file is part of Quartz - a raytracing aspect for Qt3D.
+ * See LICENSE file for licensing information.
+ */
+
+#pragma once
+
+#include <qt3draytrace_global_p.h>
+
+#include <Qt3DCore/QNodeId>
+#include <Qt3DCore/QNodeCreatedChange>
+
+#include <QDataStream>
+#include <QVariant>
+
+#include <functional>
+#include <memory>
+
+namespace Qt3DCore {
+class QNode;
+} // Qt3DCore
+
+namespace Qt3DRaytrace {
+namespace Raytrace {
+
+// Binary log of scene changes delivered to backend nodes.
+//
+// File layout: header (magic, version) followed by a sequence of events. Every event starts with
+// its type (quint8) and the time elapsed since the previous event in microseconds (quint32),
+// followed by an event specific payload. Node IDs are stored as recorded and remapped on replay.
+// Vertex and image payloads are stored in host byte order.
+namespace SceneChangeLog {
+
+static constexpr quint32 Magic = 0x4c43535a; // "ZSCL"
+static constexpr quint32 Version = 1;
+static constexpr QDataStream::Version StreamVersion = QDataStream::Qt_5_12;
+
+enum class EventType : quint8
+{
+    Frame = 0,
+    SceneRoot,
+    NodeCreated,
+    NodeDestroyed,
+    PropertyUpdated,
+    ComponentAdded,
+    ComponentRemoved,
+    NodeAdded,
+    NodeRemoved,
+};
+
+// Frontend node types handled by the raytrace aspect. Other types are replayed as plain components.
+enum class NodeType : quint8
+{
+    Entity = 0,
+    Transform,
+    CameraLens,
+    DistantLight,
+    Geometry,
+    GeometryRenderer,
+    Texture,
+    TextureImage,
+    Material,
+    RenderSettings,
+    Other,
+};
+
+NodeType nodeType(const QMetaObject *metaObject);
+const QMetaObject *nodeMetaObject(NodeType type);
+
+// Creates a detached frontend node of given type to construct replayed change objects from.
+std::unique_ptr<Qt3DCore::QNode> createProxyNode(NodeType type, Qt3DCore::QNodeId id);
+
+void writeCreationData(QDataStream &stream, NodeType type, const Qt3DCore::QNodeCreatedChangeBasePtr &change);
+void writeValue(QDataStream &stream, const QVariant &value);
+
+using IdResolver = std::function<Qt3DCore::QNodeId(quint64)>;
+
+Qt3DCore::QNodeCreatedChangeBasePtr readCreationChange(QDataStream &stream, NodeType type, const Qt3DCore::QNode *node, const IdResolver &resolveId);
+QVariant readValue(QDataStream &stream, const IdResolver &resolveId);
+
+} // SceneChangeLog
+
+} // Raytrace
+} // Qt3DRaytrace
@@ -0,0 +1,214 @@
+/*
+ * Copyright (C) 2018-2019 Michał Siejak
+ * This file is part of Quartz - a raytracing aspect for Qt3D.
+ * See LICENSE file for licensing information.
+ */
+
+#include <replay/scenechangerecorder_p.h>
+#include <replay/scenechangelog_p.h>
+
+#include <Qt3DCore/QPropertyUpdatedChange>
+#include <Qt3DCore/QComponentAddedChange>
+#include <Qt3DCore/QComponentRemovedChange>
+#include <Qt3DCore/QPropertyNodeAddedChange>
+#include <Qt3DCore/QPropertyNodeRemovedChange>
+
+#include <QElapsedTimer>
+#include <QFile>
+#include <QMutex>
+#include <QMutexLocker>
+
+#include <limits>
+
+using namespace Qt3DCore;
+
+namespace Qt3DRaytrace {
+namespace Raytrace {
+
+using SceneChangeLog::EventType;
+using SceneChangeLog::NodeType;
+
+namespace {
+
+struct Recording
+{
+    QMutex mutex;
+    QFile file;
+    QDataStream stream;
+    QElapsedTimer clock;
+    qint64 lastEventTime = 0;
+    quint64 numEvents = 0;
+
+    void beginEvent(EventType type)
+    {
+        const qint64 eventTime = clock.nsecsElapsed() / 1000;
+        const quint32 delta = quint32(qBound<qint64>(0, eventTime - lastEventTime, std::numeric_limits<quint32>::max()));
+        lastEventTime += delta;
+        ++numEvents;
+        stream << quint8(type) << delta;
+    }
+};
+
+Recording &recording()
+{
+    static Recording *instance = new Recording;
+    return *instance;
+}
+
+} // anonymous
+
+std::atomic<bool> SceneChangeRecorder::s_recording{false};
+
+bool SceneChangeRecorder::start(const QString &path)
+{
+    Recording &r = recording();
+    QMutexLocker lock(&r.mutex);
+
+    if(r.file.isOpen()) {
+        qCWarning(logAspect) << "Scene change recording is already in progress:" << r.file.fileName();
+        return false;
+    }
+
+    r.file.setFileName(path);
+    if(!r.file.open(QFile::WriteOnly | QFile::Truncate)) {
+        qCWarning(logAspect) << "Cannot open scene change log for writing:" << path;
+        return false;
+    }
+
+    r.stream.setDevice(&r.file);
+    r.stream.setVersion(SceneChangeLog::StreamVersion);
+    r.stream.setFloatingPointPrecision(QDataStream::SinglePrecision);
+    r.stream << SceneChangeLog::Magic << SceneChangeLog::Version;
+
+    r.numEvents = 0;
+    r.lastEventTime = 0;
+    r.clock.start();
+
+    s_recording.store(true, std::memory_order_release);
+    qCInfo(logAspect) << "Recording scene changes to:" << path;
+    return true;
+}
+
+void SceneChangeRecorder::stop()
+{
+    Recording &r = recording();
+    QMutexLocker lock(&r.mutex);
+
+    s_recording.store(false, std::memory_order_release);
+    if(r.file.isOpen()) {
+        r.stream.setDevice(nullptr);
+        r.file.close();
+        qCInfo(logAspect) << "Recorded" << r.numEvents << "scene change events to:" << r.file.fileName();
+    }
+}
+
+void SceneChangeRecorder::recordFrame()
+{
+    if(!isRecording()) {
+        return;
+    }
+
+    Recording &r = recording();
+    QMutexLocker lock(&r.mutex);
+    r.beginEvent(EventType::Frame);
+}
+
+void SceneChangeRecorder::recordSceneRoot(QNodeId id)
+{
+    if(!isRecording()) {
+        return;
+    }
+
+    Recording &r = recording();
+    QMutexLocker lock(&r.mutex);
+    r.beginEvent(EventType::SceneRoot);
+    r.stream << id.id();
+}
+
+void SceneChangeRecorder::recordNodeCreated(const QNodeCreatedChangeBasePtr &change)
+{
+    if(!isRecording()) {
+        return;
+    }
+
+    const NodeType type = SceneChangeLog::nodeType(change->metaObject());
+
+    Recording &r = recording();
+    QMutexLocker lock(&r.mutex);
+    r.beginEvent(EventType::NodeCreated);
+    r.stream << change->subjectId().id() << quint8(type) << change->isNodeEnabled();
+    SceneChangeLog::writeCreationData(r.stream, type, change);
+}
+
+void SceneChangeRecorder::recordNodeDestroyed(QNodeId id)
+{
+    if(!isRecording()) {
+        return;
+    }
+
+    Recording &r = recording();
+    QMutexLocker lock(&r.mutex);
+    r.beginEvent(EventType::NodeDestroyed);
+    r.stream << id.id();
+}
+
+void SceneChangeRecorder::recordSceneChange(const QSceneChangePtr &change)
+{
+    if(!isRecording()) {
+        return;
+    }
+
+    Recording &r = recording();
+    QMutexLocker lock(&r.mutex);
+
+    // Component notifications are recorded only as delivered to entities; components ignore their own.
+    switch(change->type()) {
+    case PropertyUpdated: {
+        const auto typedChange = qSharedPointerCast<QPropertyUpdatedChange>(change);
+        r.beginEvent(EventType::PropertyUpdated);
+        r.stream << typedChange->subjectId().id() << QByteArray(typedChange->propertyName());
+        SceneChangeLog::writeValue(r.stream, typedChange->value());
+        break;
+    }
+    case ComponentAdded: {
+        const auto typedChange = qSharedPointerCast<QComponentAddedChange>(change);
+        if(typedChange->subjectId() != typedChange->entityId()) {
+            break;
+        }
+        r.beginEvent(EventType::ComponentAdded);
+        r.stream << typedChange->entityId().id() << typedChange->componentId().id()
+                 << quint8(SceneChangeLog::nodeType(typedChange->componentMetaObject()));
+        break;
+    }
+    case ComponentRemoved: {
+        const auto typedChange = qSharedPointerCast<QComponentRemovedChange>(change);
+        if(typedChange->subjectId() != typedChange->entityId()) {
+            break;
+        }
+        r.beginEvent(EventType::ComponentRemoved);
+        r.stream << typedChange->entityId().id() << typedChange->componentId().id()
+                 << quint8(SceneChangeLog::nodeType(typedChange->componentMetaObject()));
+        break;
+    }
+    case PropertyValueAdded: {
+        const auto typedChange = qSharedPointerCast<QPropertyNodeAddedChange>(change);
+        r.beginEvent(EventType::NodeAdded);
+        r.stream << typedChange->subjectId().id() << QByteArray(typedChange->propertyName())
+                 << typedChange->addedNodeId().id() << quint8(SceneChangeLog::nodeType(typedChange->metaObject()));
+        break;
+    }
+    case PropertyValueRemoved: {
+        const auto typedChange = qSharedPointerCast<QPropertyNodeRemovedChange>(change);
+        r.beginEvent(EventType::NodeRemoved);
+        r.stream << typedChange->subjectId().id() << QByteArray(typedChange->propertyName())
+                 << typedChange->removedNodeId().id() << quint8(SceneChangeLog::nodeType(typedChange->metaObject()));
+        break;
+    }
+    default:
+        // Remaining change types (commands, callbacks) are not handled by raytrace backend nodes.
+        break;
+    }
+}
+
+} // Raytrace
+} // Qt3DRaytrace
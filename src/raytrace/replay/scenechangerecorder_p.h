@@ -0,0 +1,43 @@
+/*
+ * Copyright (C) 2018-2019 Michał Siejak
+ * This file is part of Quartz - a raytracing aspect for Qt3D.
+ * See LICENSE file for licensing information.
+ */
+
+#pragma once
+
+#include <qt3draytrace_global_p.h>
+
+#include <Qt3DCore/QNodeId>
+#include <Qt3DCore/QNodeCreatedChange>
+#include <Qt3DCore/QSceneChange>
+
+#include <atomic>
+
+namespace Qt3DRaytrace {
+namespace Raytrace {
+
+// Writes scene changes handled by backend nodes into a binary log (see SceneChangeLog) for later replay.
+class SceneChangeRecorder
+{
+public:
+    static bool isRecording()
+    {
+        return s_recording.load(std::memory_order_relaxed);
+    }
+
+    static bool start(const QString &path);
+    static void stop();
+
+    static void recordFrame();
+    static void recordSceneRoot(Qt3DCore::QNodeId id);
+    static void recordNodeCreated(const Qt3DCore::QNodeCreatedChangeBasePtr &change);
+    static void recordNodeDestroyed(Qt3DCore::QNodeId id);
+    static void recordSceneChange(const Qt3DCore::QSceneChangePtr &change);
+
+private:
+    static std::atomic<bool> s_recording;
+};
+
+} // Raytrace
+} // Qt3DRaytrace
@@ -0,0 +1,277 @@
+/*
+ * Copyright (C) 2018-2019 Michał Siejak
+ * This file is part of Quartz - a raytracing aspect for Qt3D.
+ * See LICENSE file for licensing information.
+ */
+
+#include <replay/scenechangereplayer_p.h>
+#include <backend/abstractrenderer_p.h>
+#include <backend/managers_p.h>
+
+#include <Qt3DCore/QEntity>
+#include <Qt3DCore/QComponent>
+#include <Qt3DCore/QPropertyUpdatedChange>
+#include <Qt3DCore/QComponentAddedChange>
+#include <Qt3DCore/QComponentRemovedChange>
+#include <Qt3DCore/QPropertyNodeAddedChange>
+#include <Qt3DCore/QPropertyNodeRemovedChange>
+#include <Qt3DCore/QNodeDestroyedChange>
+#include <Qt3DCore/private/qabstractaspect_p.h>
+#include <Qt3DCore/private/qbackendnode_p.h>
+
+using namespace Qt3DCore;
+
+namespace Qt3DRaytrace {
+namespace Raytrace {
+
+using SceneChangeLog::EventType;
+using SceneChangeLog::NodeType;
+
+static NodeType readNodeType(QDataStream &stream)
+{
+    quint8 type;
+    stream >> type;
+    return NodeType(qMin(type, quint8(NodeType::Other)));
+}
+
+SceneChangeReplayer::SceneChangeReplayer(QAbstractAspectPrivate *aspect, AbstractRenderer *renderer, NodeManagers *managers)
+    : m_aspect(aspect)
+    , m_renderer(renderer)
+    , m_nodeManagers(managers)
+{
+    Q_ASSERT(m_aspect);
+    Q_ASSERT(m_renderer);
+    Q_ASSERT(m_nodeManagers);
+}
+
+bool SceneChangeReplayer::open(const QString &path, Speed speed)
+{
+    m_file.setFileName(path);
+    if(!m_file.open(QFile::ReadOnly)) {
+        qCWarning(logAspect) << "Cannot open scene change log:" << path;
+        return false;
+    }
+
+    m_stream.setDevice(&m_file);
+    m_stream.setVersion(SceneChangeLog::StreamVersion);
+    m_stream.setFloatingPointPrecision(QDataStream::SinglePrecision);
+
+    quint32 magic, version;
+    m_stream >> magic >> version;
+    if(magic != SceneChangeLog::Magic || version != SceneChangeLog::Version) {
+        qCWarning(logAspect) << "Invalid or unsupported scene change log:" << path;
+        return false;
+    }
+
+    m_speed = speed;
+    m_clock.start();
+    readNextEvent();
+
+    qCInfo(logAspect) << "Replaying scene changes from:" << path << (speed == Speed::Maximum ? "(maximum speed)" : "(recorded speed)");
+    return true;
+}
+
+bool SceneChangeReplayer::advance()
+{
+    const quint64 currentTime = quint64(m_clock.nsecsElapsed() / 1000);
+    while(m_hasPendingEvent) {
+        if(m_speed == Speed::Recorded && m_pendingEventTime > currentTime) {
+            return true;
+        }
+
+        const EventType type = m_pendingEventType;
+        applyEvent(type);
+        if(m_stream.status() != QDataStream::Ok) {
+            qCWarning(logAspect) << "Scene change log is truncated or corrupt:" << m_file.fileName();
+            m_hasPendingEvent = false;
+            break;
+        }
+
+        ++m_numEventsReplayed;
+        readNextEvent();
+
+        if(type == EventType::Frame) {
+            ++m_numFramesReplayed;
+            if(m_speed == Speed::Maximum) {
+                return m_hasPendingEvent;
+            }
+        }
+    }
+    return false;
+}
+
+bool SceneChangeReplayer::readNextEvent()
+{
+    m_hasPendingEvent = false;
+    if(m_stream.atEnd()) {
+        return false;
+    }
+
+    quint8 type;
+    quint32 delta;
+    m_stream >> type >> delta;
+    if(m_stream.status() != QDataStream::Ok) {
+        return false;
+    }
+
+    m_pendingEventType = EventType(type);
+    m_pendingEventTime += delta;
+    m_hasPendingEvent = true;
+    return true;
+}
+
+void SceneChangeReplayer::applyEvent(EventType type)
+{
+    const SceneChangeLog::IdResolver resolver = [this](quint64 id) { return resolveId(id); };
+
+    switch(type) {
+    case EventType::Frame:
+        break;
+    case EventType::SceneRoot: {
+        quint64 rootId;
+        m_stream >> rootId;
+        if(Entity *rootEntity = m_nodeManagers->entityManager.lookupResource(resolveId(rootId))) {
+            m_renderer->setSceneRoot(rootEntity);
+        }
+        break;
+    }
+    case EventType::NodeCreated: {
+        quint64 recordedId;
+        bool enabled;
+        m_stream >> recordedId;
+        const NodeType nodeType = readNodeType(m_stream);
+        m_stream >> enabled;
+
+        const QNodeId id = resolveId(recordedId);
+        auto node = SceneChangeLog::createProxyNode(nodeType, id);
+        node->setEnabled(enabled);
+
+        const auto change = SceneChangeLog::readCreationChange(m_stream, nodeType, node.get(), resolver);
+        if(m_stream.status() == QDataStream::Ok) {
+            m_nodeTypes.insert(id, nodeType);
+            m_aspect->createBackendNode(change);
+        }
+        break;
+    }
+    case EventType::NodeDestroyed: {
+        quint64 recordedId;
+        m_stream >> recordedId;
+
+        const QNodeId id = resolveId(recordedId);
+        if(m_nodeTypes.contains(id)) {
+            auto node = SceneChangeLog::createProxyNode(m_nodeTypes.take(id), id);
+            const QVector<QNodeIdTypePair> subtree = { QNodeIdTypePair{id, node->metaObject()} };
+            m_aspect->clearBackendNode(QNodeDestroyedChangePtr::create(node.get(), subtree));
+        }
+        m_idMap.remove(recordedId);
+        break;
+    }
+    case EventType::PropertyUpdated: {
+        quint64 recordedId;
+        QByteArray propertyName;
+        m_stream >> recordedId >> propertyName;
+        const QVariant value = SceneChangeLog::readValue(m_stream, resolver);
+
+        const QNodeId id = resolveId(recordedId);
+        auto change = QPropertyUpdatedChangePtr::create(id);
+        change->setPropertyName(internPropertyName(propertyName));
+        change->setValue(value);
+        deliverChange(id, change);
+        break;
+    }
+    case EventType::ComponentAdded:
+    case EventType::ComponentRemoved: {
+        quint64 recordedEntityId, recordedComponentId;
+        m_stream >> recordedEntityId >> recordedComponentId;
+        const NodeType componentType = readNodeType(m_stream);
+
+        const QNodeId entityId = resolveId(recordedEntityId);
+        auto entityNode = SceneChangeLog::createProxyNode(NodeType::Entity, entityId);
+        auto componentNode = SceneChangeLog::createProxyNode(componentType, resolveId(recordedComponentId));
+
+        const QEntity *entity = static_cast<QEntity*>(entityNode.get());
+        const QComponent *component = qobject_cast<QComponent*>(componentNode.get());
+        if(component) {
+            if(type == EventType::ComponentAdded) {
+                deliverChange(entityId, QComponentAddedChangePtr::create(entity, component));
+            }
+            else {
+                deliverChange(entityId, QComponentRemovedChangePtr::create(entity, component));
+            }
+        }
+        break;
+    }
+    case EventType::NodeAdded:
+    case EventType::NodeRemoved: {
+        quint64 recordedSubjectId, recordedNodeId;
+        QByteArray propertyName;
+        m_stream >> recordedSubjectId >> propertyName >> recordedNodeId;
+        const NodeType nodeType = readNodeType(m_stream);
+
+        const QNodeId subjectId = resolveId(recordedSubjectId);
+        auto node = SceneChangeLog::createProxyNode(nodeType, resolveId(recordedNodeId));
+        if(type == EventType::NodeAdded) {
+            auto change = QPropertyNodeAddedChangePtr::create(subjectId, node.get());
+            change->setPropertyName(internPropertyName(propertyName));
+            deliverChange(subjectId, change);
+        }
+        else {
+            auto change = QPropertyNodeRemovedChangePtr::create(subjectId, node.get());
+            change->setPropertyName(internPropertyName(propertyName));
+            deliverChange(subjectId, change);
+        }
+        break;
+    }
+    default:
+        m_stream.setStatus(QDataStream::ReadCorruptData);
+        break;
+    }
+}
+
+void SceneChangeReplayer::deliverChange(QNodeId id, const QSceneChangePtr &change) const
+{
+    if(QBackendNode *node = backendNode(id)) {
+        QBackendNodePrivate::get(node)->sceneChangeEvent(change);
+    }
+}
+
+QNodeId SceneChangeReplayer::resolveId(quint64 recordedId)
+{
+    if(recordedId == 0) {
+        return QNodeId();
+    }
+
+    // Replayed nodes get fresh IDs so that they never collide with nodes of the live frontend scene.
+    auto it = m_idMap.find(recordedId);
+    if(it == m_idMap.end()) {
+        it = m_idMap.insert(recordedId, QNodeId::createId());
+    }
+    return it.value();
+}
+
+QBackendNode *SceneChangeReplayer::backendNode(QNodeId id) const
+{
+    const auto it = m_nodeTypes.find(id);
+    if(it == m_nodeTypes.end()) {
+        return nullptr;
+    }
+
+    const QMetaObject *metaObject = SceneChangeLog::nodeMetaObject(it.value());
+    while(metaObject) {
+        const QBackendNodeMapperPtr mapper = m_aspect->m_backendCreatorFunctors.value(metaObject);
+        if(mapper) {
+            return mapper->get(id);
+        }
+        metaObject = metaObject->superClass();
+    }
+    return nullptr;
+}
+
+const char *SceneChangeReplayer::internPropertyName(const QByteArray &name)
+{
+    // Scene changes reference property names by pointer, so one copy of each name is kept for the duration of the replay.
+    return m_propertyNames.insert(name)->constData();
+}
+
+} // Raytrace
+} // Qt3DRaytrace
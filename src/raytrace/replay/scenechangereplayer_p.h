@@ -0,0 +1,83 @@
+/*
+ * Copyright (C) 2018-2019 Michał Siejak
+ * This file is part of Quartz - a raytracing aspect for Qt3D.
+ * See LICENSE file for licensing information.
+ */
+
+#pragma once
+
+#include <qt3draytrace_global_p.h>
+#include <replay/scenechangelog_p.h>
+
+#include <Qt3DCore/QNodeId>
+#include <Qt3DCore/QSceneChange>
+
+#include <QElapsedTimer>
+#include <QFile>
+#include <QHash>
+#include <QSet>
+
+namespace Qt3DCore {
+class QAbstractAspectPrivate;
+class QBackendNode;
+} // Qt3DCore
+
+namespace Qt3DRaytrace {
+namespace Raytrace {
+
+class AbstractRenderer;
+struct NodeManagers;
+
+// Feeds a recorded scene change log back into backend nodes of an aspect.
+// Must be driven from the aspect thread, once per frame.
+class SceneChangeReplayer
+{
+public:
+    enum class Speed {
+        Recorded,   // Events are applied when their recorded time elapses.
+        Maximum,    // Events of one recorded frame are applied per frame, without waiting.
+    };
+
+    SceneChangeReplayer(Qt3DCore::QAbstractAspectPrivate *aspect, AbstractRenderer *renderer, NodeManagers *managers);
+
+    bool open(const QString &path, Speed speed);
+
+    // Applies events due in the current frame. Returns false once the log has been fully replayed.
+    bool advance();
+
+    quint64 numEventsReplayed() const { return m_numEventsReplayed; }
+    quint64 numFramesReplayed() const { return m_numFramesReplayed; }
+    double elapsedTime() const { return m_clock.nsecsElapsed() * 1e-9; }
+
+private:
+    bool readNextEvent();
+    void applyEvent(SceneChangeLog::EventType type);
+    void deliverChange(Qt3DCore::QNodeId id, const Qt3DCore::QSceneChangePtr &change) const;
+
+    Qt3DCore::QNodeId resolveId(quint64 recordedId);
+    Qt3DCore::QBackendNode *backendNode(Qt3DCore::QNodeId id) const;
+    const char *internPropertyName(const QByteArray &name);
+
+    Qt3DCore::QAbstractAspectPrivate *m_aspect;
+    AbstractRenderer *m_renderer;
+    NodeManagers *m_nodeManagers;
+
+    QFile m_file;
+    QDataStream m_stream;
+    Speed m_speed = Speed::Recorded;
+    QElapsedTimer m_clock;
+
+    bool m_hasPendingEvent = false;
+    SceneChangeLog::EventType m_pendingEventType = SceneChangeLog::EventType::Frame;
+    quint64 m_pendingEventTime = 0;
+
+    QHash<quint64, Qt3DCore::QNodeId> m_idMap;
+    QHash<Qt3DCore::QNodeId, SceneChangeLog::NodeType> m_nodeTypes;
+    QSet<QByteArray> m_propertyNames;
+
+    quint64 m_numEventsReplayed = 0;
+    quint64 m_numFramesReplayed = 0;
+};
+
+} // Raytrace
+} // Qt3DRaytrace
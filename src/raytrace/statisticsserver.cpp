@@ -0,0 +1,253 @@
+/*
+ * Copyright (C) 2018-2019 Michał Siejak
+ * This file is part of Quartz - a raytracing aspect for Qt3D.
+ * See LICENSE file for licensing information.
+ */
+
+#include <statisticsserver_p.h>
+#include <backend/abstractrenderer_p.h>
+
+#include <io/importstatistics_p.h>
+#include <utility/startuptiming.h>
+
+#include <QDateTime>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QLocalServer>
+#include <QLocalSocket>
+
+namespace Qt3DRaytrace {
+namespace Raytrace {
+
+namespace Config {
+static constexpr int MaxClients = 16;
+static constexpr int MaxRequestLength = 256;
+static constexpr int NumSlowestImports = 10;
+// How long to wait for a server already listening under the requested name to accept a probe connection.
+static constexpr int ListenProbeTimeout = 100;
+} // Config
+
+static QJsonObject latencyToJson(const QLatencyStatistics &latency)
+{
+    return QJsonObject{
+        {"p50", latency.p50},
+        {"p95", latency.p95},
+        {"p99", latency.p99},
+        {"max", latency.max},
+        {"samples", double(latency.numSamples)},
+    };
+}
+
+static QJsonObject lockToJson(const QLockStatistics &lock)
+{
+    return QJsonObject{
+        {"readLocks", double(lock.numReadLocks)},
+        {"writeLocks", double(lock.numWriteLocks)},
+        {"contendedReadLocks", double(lock.numContendedReadLocks)},
+        {"contendedWriteLocks", double(lock.numContendedWriteLocks)},
+        {"totalReadWaitTime", lock.totalReadWaitTime},
+        {"totalWriteWaitTime", lock.totalWriteWaitTime},
+        {"totalReadHoldTime", lock.totalReadHoldTime},
+        {"totalWriteHoldTime", lock.totalWriteHoldTime},
+        {"readWaitTimes", latencyToJson(lock.readWaitTimes)},
+        {"writeWaitTimes", latencyToJson(lock.writeWaitTimes)},
+    };
+}
+
+static QJsonObject resourcesToJson(const QRenderResourceStatistics &resources)
+{
+    return QJsonObject{
+        {"geometries", int(resources.numGeometries)},
+        {"accelerationStructures", int(resources.numBottomLevelAccelerationStructures)},
+        {"textures", int(resources.numTextures)},
+        {"descriptors", int(resources.numDescriptors)},
+        {"descriptorCapacity", int(resources.descriptorCapacity)},
+        {"geometryBytes", double(resources.geometryBytes)},
+        {"accelerationStructureBytes", double(resources.accelerationStructureBytes)},
+        {"textureBytes", double(resources.textureBytes)},
+        {"deviceAllocations", int(resources.numDeviceAllocations)},
+        {"deviceAllocatedBytes", double(resources.deviceAllocatedBytes)},
+        {"deviceLocalMemoryCapacity", double(resources.deviceLocalMemoryCapacity)},
+        {"stagingBytesLastFrame", double(resources.stagingBytesLastFrame)},
+        {"hostPayloadBytes", double(resources.hostPayloadBytes)},
+        {"pendingLoads", int(resources.numPendingLoads)},
+        {"pendingUploads", int(resources.numPendingUploads)},
+    };
+}
+
+static QJsonObject startupToJson(const QStartupStatistics &startup)
+{
+    QJsonObject phases;
+    for(int index=0; index<QStartupPhaseCount; ++index) {
+        const QStartupPhaseTiming &phase = startup.phases[index];
+        if(phase.count > 0) {
+            phases.insert(QLatin1String(Utility::StartupTiming::phaseName(QStartupPhase(index))), QJsonObject{
+                {"begin", phase.begin},
+                {"end", phase.end},
+                {"totalTime", phase.totalTime},
+                {"count", int(phase.count)},
+            });
+        }
+    }
+    return QJsonObject{
+        {"complete", startup.complete},
+        {"timeToFirstFrame", startup.timeToFirstFrame},
+        {"timeToCompleteFrame", startup.timeToCompleteFrame},
+        {"phases", phases},
+    };
+}
+
+static QJsonObject importsToJson()
+{
+    const ImportStatistics *importStatistics = ImportStatistics::instance();
+
+    QJsonArray slowest;
+    for(const QAssetImportRecord &record : importStatistics->slowestRecords(Config::NumSlowestImports)) {
+        slowest.append(QJsonObject{
+            {"source", record.source},
+            {"importer", record.importer},
+            {"succeeded", record.succeeded},
+            {"totalMs", record.totalTime()},
+        });
+    }
+    return QJsonObject{
+        {"count", importStatistics->count()},
+        {"slowest", slowest},
+    };
+}
+
+StatisticsServer::StatisticsServer(AbstractRenderer *renderer, QObject *parent)
+    : QObject(parent)
+    , m_renderer(renderer)
+    , m_server(new QLocalServer(this))
+{
+    Q_ASSERT(m_renderer);
+
+    // Statistics may reveal asset paths, so restrict access to the owning user.
+    m_server->setSocketOptions(QLocalServer::UserAccessOption);
+    m_server->setMaxPendingConnections(Config::MaxClients);
+    QObject::connect(m_server, &QLocalServer::newConnection, this, &StatisticsServer::acceptConnections);
+}
+
+StatisticsServer::~StatisticsServer()
+{
+    close();
+}
+
+bool StatisticsServer::listen(const QString &name)
+{
+    // Another process may be serving statistics under the same name; its socket must not be taken over.
+    QLocalSocket probe;
+    probe.connectToServer(name);
+    if(probe.waitForConnected(Config::ListenProbeTimeout)) {
+        probe.abort();
+        qCWarning(logAspect) << "Failed to start statistics server: another server is already listening on:" << name;
+        return false;
+    }
+
+    // Nothing is listening, so remove a stale socket file left behind by a process that did not shut down cleanly.
+    QLocalServer::removeServer(name);
+    if(!m_server->listen(name)) {
+        qCWarning(logAspect) << "Failed to start statistics server:" << m_server->errorString();
+        return false;
+    }
+    qCInfo(logAspect) << "Statistics server listening on:" << m_server->fullServerName();
+    return true;
+}
+
+void StatisticsServer::close()
+{
+    for(QLocalSocket *client : m_clients.keys()) {
+        client->disconnect(this);
+        client->abort();
+        client->deleteLater();
+    }
+    m_clients.clear();
+    m_server->close();
+}
+
+QString StatisticsServer::fullServerName() const
+{
+    return m_server->fullServerName();
+}
+
+QJsonObject StatisticsServer::snapshot() const
+{
+    const QRenderStatistics stats = m_renderer->statistics();
+    const QJsonObject frames{
+        {"cpuFrameTime", stats.cpuFrameTime},
+        {"gpuFrameTime", stats.gpuFrameTime},
+        {"totalRenderTime", stats.totalRenderTime},
+        {"framesRendered", int(stats.numFramesRendered)},
+        {"cpuFrameTimes", latencyToJson(stats.cpuFrameTimes)},
+        {"gpuFrameTimes", latencyToJson(stats.gpuFrameTimes)},
+    };
+    const QJsonObject jobs{
+        {"geometryLoad", latencyToJson(stats.geometryLoadTimes)},
+        {"textureLoad", latencyToJson(stats.textureLoadTimes)},
+        {"geometryBuild", latencyToJson(stats.geometryBuildTimes)},
+        {"textureUpload", latencyToJson(stats.textureUploadTimes)},
+    };
+
+    return QJsonObject{
+        {"timestamp", QDateTime::currentMSecsSinceEpoch() * 1e-3},
+        {"frames", frames},
+        {"jobs", jobs},
+        {"resources", resourcesToJson(stats.resources)},
+        {"locks", QJsonObject{{"scene", lockToJson(stats.sceneLock)}}},
+        {"startup", startupToJson(Utility::StartupTiming::statistics())},
+        {"imports", importsToJson()},
+    };
+}
+
+void StatisticsServer::acceptConnections()
+{
+    while(QLocalSocket *client = m_server->nextPendingConnection()) {
+        if(m_clients.size() >= Config::MaxClients) {
+            client->abort();
+            client->deleteLater();
+            continue;
+        }
+        m_clients.insert(client, QByteArray());
+        QObject::connect(client, &QLocalSocket::readyRead, this, &StatisticsServer::processRequests);
+        QObject::connect(client, &QLocalSocket::disconnected, this, &StatisticsServer::removeClient);
+    }
+}
+
+void StatisticsServer::processRequests()
+{
+    QLocalSocket *client = qobject_cast<QLocalSocket*>(sender());
+    auto it = m_clients.find(client);
+    if(it == m_clients.end()) {
+        return;
+    }
+
+    QByteArray &buffer = it.value();
+    buffer.append(client->readAll());
+
+    // Any request line, including an empty one, is answered with a full snapshot.
+    int lineEnd;
+    while((lineEnd = buffer.indexOf('\n')) >= 0) {
+        buffer.remove(0, lineEnd + 1);
+
+        QByteArray response = QJsonDocument(snapshot()).toJson(QJsonDocument::Compact);
+        response.append('\n');
+        client->write(response);
+    }
+
+    if(buffer.size() > Config::MaxRequestLength) {
+        qCWarning(logAspect) << "Statistics server: request too long, disconnecting client";
+        client->disconnectFromServer();
+    }
+}
+
+void StatisticsServer::removeClient()
+{
+    QLocalSocket *client = qobject_cast<QLocalSocket*>(sender());
+    if(m_clients.remove(client) > 0) {
+        client->deleteLater();
+    }
+}
+
+} // Raytrace
+} // Qt3DRaytrace
@@ -0,0 +1,51 @@
+/*
+ * Copyright (C) 2018-2019 Michał Siejak
+ * This file is part of Quartz - a raytracing aspect for Qt3D.
+ * See LICENSE file for licensing information.
+ */
+
+#pragma once
+
+#include <qt3draytrace_global_p.h>
+
+#include <QObject>
+#include <QJsonObject>
+#include <QHash>
+
+class QLocalServer;
+class QLocalSocket;
+
+namespace Qt3DRaytrace {
+namespace Raytrace {
+
+class AbstractRenderer;
+
+// Serves JSON snapshots of render statistics over a local (Unix domain) socket.
+// Each newline-terminated request line is answered with a single line of compact JSON.
+class StatisticsServer : public QObject
+{
+    Q_OBJECT
+public:
+    explicit StatisticsServer(AbstractRenderer *renderer, QObject *parent = nullptr);
+    ~StatisticsServer();
+
+    bool listen(const QString &name);
+    void close();
+
+    QString fullServerName() const;
+
+    QJsonObject snapshot() const;
+
+private slots:
+    void acceptConnections();
+    void processRequests();
+    void removeClient();
+
+private:
+    AbstractRenderer *m_renderer;
+    QLocalServer *m_server;
+    QHash<QLocalSocket*, QByteArray> m_clients;
+};
+
+} // Raytrace
+} // Qt3DRaytrace
@@ -0,0 +1,141 @@
+/*
+ * Copyright (C) 2018-2019 Michał Siejak
+ * This file is part of Quartz - a raytracing aspect for Qt3D.
+ * See LICENSE file for licensing information.
+ */
+
+#pragma once
+
+#include <QtGlobal>
+#include <QtCore/qalgorithms.h>
+
+#include <atomic>
+
+namespace Qt3DRaytrace {
+namespace Utility {
+
+namespace Config {
+
+// 16 linear sub-buckets per power of two bound relative error of reported percentiles to 6.25%.
+static constexpr int HistogramSubBucketBits = 4;
+// Largest representable duration is 2^36 units: ~19 hours at microsecond, ~69 seconds at nanosecond resolution.
+static constexpr int HistogramMaxExponent = 35;
+
+} // Config
+
+// Fixed-size log-linear (HDR histogram style) distribution of durations.
+// Recording is lock-free and never allocates so it can be used from concurrently running jobs.
+// Sub-microsecond durations (e.g. lock waits) need nanosecond resolution, otherwise they all fall into the first bucket.
+class LatencyHistogram
+{
+public:
+    enum class Resolution
+    {
+        Microseconds,
+        Nanoseconds,
+    };
+
+    explicit LatencyHistogram(Resolution resolution=Resolution::Microseconds)
+        : m_unitsPerMillisecond(resolution == Resolution::Nanoseconds ? 1e6 : 1e3)
+    {
+        reset();
+    }
+
+    void add(double milliseconds)
+    {
+        addValue(milliseconds > 0.0 ? qMin(quint64(milliseconds * m_unitsPerMillisecond), MaxValue) : 0);
+    }
+
+    // Requires nanosecond resolution; avoids rounding through milliseconds.
+    void addNanoseconds(qint64 nanoseconds)
+    {
+        Q_ASSERT(m_unitsPerMillisecond == 1e6);
+        addValue(nanoseconds > 0 ? qMin(quint64(nanoseconds), MaxValue) : 0);
+    }
+
+    void reset()
+    {
+        for(auto &bucket : m_buckets) {
+            bucket.store(0, std::memory_order_relaxed);
+        }
+        m_max.store(0, std::memory_order_relaxed);
+    }
+
+    quint64 count() const
+    {
+        quint64 total = 0;
+        for(const auto &bucket : m_buckets) {
+            total += bucket.load(std::memory_order_relaxed);
+        }
+        return total;
+    }
+
+    // Returns the value (in milliseconds) below which the given fraction of recorded durations lie.
+    double percentile(double fraction) const
+    {
+        const quint64 total = count();
+        if(total == 0) {
+            return 0.0;
+        }
+
+        const quint64 threshold = qMax(quint64(1), quint64(qBound(0.0, fraction, 1.0) * double(total) + 0.5));
+        const quint64 maxValue = m_max.load(std::memory_order_relaxed);
+
+        quint64 accumulated = 0;
+        for(int index=0; index<NumBuckets; ++index) {
+            accumulated += m_buckets[index].load(std::memory_order_relaxed);
+            if(accumulated >= threshold) {
+                return qMin(bucketUpperBound(index), maxValue) / m_unitsPerMillisecond;
+            }
+        }
+        return maxValue / m_unitsPerMillisecond;
+    }
+
+    double maximum() const
+    {
+        return m_max.load(std::memory_order_relaxed) / m_unitsPerMillisecond;
+    }
+
+    Q_DISABLE_COPY(LatencyHistogram)
+
+private:
+    static constexpr int SubBucketCount = 1 << Config::HistogramSubBucketBits;
+    static constexpr int NumBuckets = (Config::HistogramMaxExponent - Config::HistogramSubBucketBits + 2) * SubBucketCount;
+    static constexpr quint64 MaxValue = (quint64(1) << (Config::HistogramMaxExponent + 1)) - 1;
+
+    void addValue(quint64 value)
+    {
+        m_buckets[bucketIndex(value)].fetch_add(1, std::memory_order_relaxed);
+
+        quint64 currentMax = m_max.load(std::memory_order_relaxed);
+        while(value > currentMax && !m_max.compare_exchange_weak(currentMax, value, std::memory_order_relaxed)) {}
+    }
+
+    static int bucketIndex(quint64 value)
+    {
+        if(value < quint64(SubBucketCount)) {
+            return int(value);
+        }
+        const int exponent = 63 - qCountLeadingZeroBits(value);
+        const int shift = exponent - Config::HistogramSubBucketBits;
+        const int subBucket = int(value >> shift) - SubBucketCount;
+        return (shift + 1) * SubBucketCount + subBucket;
+    }
+
+    static quint64 bucketUpperBound(int index)
+    {
+        if(index < SubBucketCount) {
+            return quint64(index);
+        }
+        const int shift = index / SubBucketCount - 1;
+        const quint64 subBucket = quint64(index % SubBucketCount + SubBucketCount);
+        return ((subBucket + 1) << shift) - 1;
+    }
+
+    const double m_unitsPerMillisecond;
+    std::atomic<quint32> m_buckets[NumBuckets];
+    std::atomic<quint64> m_max;
+};
+
+} // Utility
+} // Qt3DRaytrace
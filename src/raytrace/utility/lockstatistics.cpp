@@ -0,0 +1,20 @@
+/*
+ * Copyright (C) 2018-2019 Michał Siejak
+ * This file is part of Quartz - a raytracing aspect for Qt3D.
+ * See LICENSE file for licensing information.
+ */
+
+#include <utility/lockstatistics.h>
+
+namespace Qt3DRaytrace {
+namespace Utility {
+
+std::atomic<bool> LockStatistics::s_enabled{false};
+
+void LockStatistics::setEnabled(bool enabled)
+{
+    s_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+} // Utility
+} // Qt3DRaytrace
@@ -0,0 +1,187 @@
+/*
+ * Copyright (C) 2018-2019 Michał Siejak
+ * This file is part of Quartz - a raytracing aspect for Qt3D.
+ * See LICENSE file for licensing information.
+ */
+
+#pragma once
+
+#include <utility/latencyhistogram.h>
+
+#include <QElapsedTimer>
+#include <QReadWriteLock>
+
+#include <atomic>
+
+namespace Qt3DRaytrace {
+namespace Utility {
+
+// Counts acquisitions, contended waits and hold times of a read-write lock, separately for readers and writers.
+// Collection is globally disabled by default; while disabled, lockers pay only for one relaxed atomic load.
+class LockStatistics
+{
+public:
+    enum Access
+    {
+        Read = 0,
+        Write = 1,
+    };
+
+    LockStatistics()
+    {
+        reset();
+    }
+
+    static bool isEnabled()
+    {
+        return s_enabled.load(std::memory_order_relaxed);
+    }
+    static void setEnabled(bool enabled);
+
+    // Wait time (in nanoseconds) is only recorded for acquisitions which could not take the lock immediately.
+    void addAcquisition(Access access, bool contended, qint64 waitTime)
+    {
+        Counters &counters = m_counters[access];
+        counters.numAcquisitions.fetch_add(1, std::memory_order_relaxed);
+        if(contended) {
+            counters.numContended.fetch_add(1, std::memory_order_relaxed);
+            counters.totalWaitTime.fetch_add(quint64(waitTime), std::memory_order_relaxed);
+            counters.waitTimes.addNanoseconds(waitTime);
+        }
+    }
+
+    void addHold(Access access, qint64 holdTime)
+    {
+        m_counters[access].totalHoldTime.fetch_add(quint64(holdTime), std::memory_order_relaxed);
+    }
+
+    void reset()
+    {
+        for(Counters &counters : m_counters) {
+            counters.numAcquisitions.store(0, std::memory_order_relaxed);
+            counters.numContended.store(0, std::memory_order_relaxed);
+            counters.totalWaitTime.store(0, std::memory_order_relaxed);
+            counters.totalHoldTime.store(0, std::memory_order_relaxed);
+            counters.waitTimes.reset();
+        }
+    }
+
+    quint64 numAcquisitions(Access access) const
+    {
+        return m_counters[access].numAcquisitions.load(std::memory_order_relaxed);
+    }
+    quint64 numContended(Access access) const
+    {
+        return m_counters[access].numContended.load(std::memory_order_relaxed);
+    }
+
+    // Totals are reported in milliseconds.
+    double totalWaitTime(Access access) const
+    {
+        return double(m_counters[access].totalWaitTime.load(std::memory_order_relaxed)) * 1e-6;
+    }
+    double totalHoldTime(Access access) const
+    {
+        return double(m_counters[access].totalHoldTime.load(std::memory_order_relaxed)) * 1e-6;
+    }
+
+    const LatencyHistogram &waitTimes(Access access) const
+    {
+        return m_counters[access].waitTimes;
+    }
+
+    Q_DISABLE_COPY(LockStatistics)
+
+private:
+    struct Counters
+    {
+        std::atomic<quint64> numAcquisitions;
+        std::atomic<quint64> numContended;
+        std::atomic<quint64> totalWaitTime;
+        std::atomic<quint64> totalHoldTime;
+        LatencyHistogram waitTimes{LatencyHistogram::Resolution::Nanoseconds};
+    };
+    Counters m_counters[2];
+
+    static std::atomic<bool> s_enabled;
+};
+
+// QReadWriteLock keeping statistics of its own use; locked through InstrumentedReadLocker & InstrumentedWriteLocker.
+class InstrumentedReadWriteLock
+{
+public:
+    const LockStatistics &statistics() const { return m_statistics; }
+
+private:
+    template<LockStatistics::Access> friend class InstrumentedLocker;
+
+    QReadWriteLock m_lock;
+    LockStatistics m_statistics;
+};
+
+template<LockStatistics::Access access>
+class InstrumentedLocker
+{
+public:
+    explicit InstrumentedLocker(InstrumentedReadWriteLock *lock)
+        : m_lock(&lock->m_lock)
+        , m_statistics(LockStatistics::isEnabled() ? &lock->m_statistics : nullptr)
+    {
+        if(!m_statistics) {
+            acquire();
+            return;
+        }
+
+        m_timer.start();
+        const bool contended = !tryAcquire();
+        if(contended) {
+            acquire();
+        }
+        m_acquireTime = m_timer.nsecsElapsed();
+        m_statistics->addAcquisition(access, contended, m_acquireTime);
+    }
+    ~InstrumentedLocker()
+    {
+        unlock();
+    }
+
+    void unlock()
+    {
+        if(!m_lock) {
+            return;
+        }
+        if(m_statistics) {
+            m_statistics->addHold(access, m_timer.nsecsElapsed() - m_acquireTime);
+        }
+        m_lock->unlock();
+        m_lock = nullptr;
+    }
+
+private:
+    Q_DISABLE_COPY(InstrumentedLocker)
+
+    void acquire()
+    {
+        if(access == LockStatistics::Read) {
+            m_lock->lockForRead();
+        }
+        else {
+            m_lock->lockForWrite();
+        }
+    }
+    bool tryAcquire()
+    {
+        return (access == LockStatistics::Read) ? m_lock->tryLockForRead() : m_lock->tryLockForWrite();
+    }
+
+    QReadWriteLock *m_lock;
+    LockStatistics *m_statistics;
+    QElapsedTimer m_timer;
+    qint64 m_acquireTime = 0;
+};
+
+using InstrumentedReadLocker = InstrumentedLocker<LockStatistics::Read>;
+using InstrumentedWriteLocker = InstrumentedLocker<LockStatistics::Write>;
+
+} // Utility
+} // Qt3DRaytrace
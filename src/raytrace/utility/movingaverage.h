@@ -6,55 +6,67 @@
 
 #pragma once
 
-#include <QQueue>
+#include <QVector>
 
 namespace Qt3DRaytrace {
 namespace Utility {
 
+// Sliding mean over a fixed-size window backed by a ring buffer allocated up front.
+// The running sum is recomputed from the window contents every time the ring wraps around
+// so that floating-point error does not accumulate over long sessions.
 template<typename T>
 class MovingAverage
 {
 public:
     explicit MovingAverage(int limit=100)
-        : m_limit(limit)
+        : m_values(limit, T(0))
     {
         Q_ASSERT(limit > 0);
-        m_values.reserve(limit);
     }
 
     T add(T value)
     {
-        if(m_values.size() == m_limit) {
-            m_average = m_average + (value / m_limit) - (m_values.dequeue() / m_limit);
-            m_values.enqueue(value);
+        if(m_count < m_values.size()) {
+            ++m_count;
         }
         else {
-            m_values.enqueue(value);
-            m_average += (value - m_average) / m_values.size();
+            m_sum -= m_values[m_next];
         }
-        return m_average;
+        m_values[m_next] = value;
+        m_sum += value;
+
+        if(++m_next == m_values.size()) {
+            m_next = 0;
+            m_sum = T(0);
+            for(int i=0; i<m_count; ++i) {
+                m_sum += m_values[i];
+            }
+        }
+        return average();
     }
 
     void reset()
     {
-        m_average = T(0);
-        m_values.clear();
+        m_sum = T(0);
+        m_count = 0;
+        m_next = 0;
     }
 
     T average() const
     {
-        return m_average;
+        return m_count > 0 ? m_sum / m_count : T(0);
     }
 
     operator T() const
     {
-        return m_average;
+        return average();
     }
 
 private:
-    T m_average = T(0);
-    QQueue<T> m_values;
-    int m_limit;
+    QVector<T> m_values;
+    T m_sum = T(0);
+    int m_count = 0;
+    int m_next = 0;
 };
 
 } // Utility
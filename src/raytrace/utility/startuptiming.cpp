@@ -0,0 +1,192 @@
+/*
+ * Copyright (C) 2018-2019 Michał Siejak
+ * This file is part of Quartz - a raytracing aspect for Qt3D.
+ * See LICENSE file for licensing information.
+ */
+
+#include <utility/startuptiming.h>
+
+#include <QStringList>
+
+#include <chrono>
+#include <limits>
+
+namespace Qt3DRaytrace {
+namespace Utility {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct PhaseTiming
+{
+    std::atomic<qint64> begin;
+    std::atomic<qint64> end;
+    std::atomic<qint64> total;
+    std::atomic<quint32> count;
+    std::atomic<qint64> openedAt;
+};
+
+PhaseTiming g_phases[QStartupPhaseCount];
+std::atomic<qint64> g_origin{0};
+std::atomic<qint64> g_firstFrame{-1};
+std::atomic<qint64> g_completeFrame{-1};
+std::atomic<int> g_numOpenPhases{0};
+
+qint64 clockNow()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now().time_since_epoch()).count();
+}
+
+double toSeconds(qint64 nsecs)
+{
+    return nsecs * 1e-9;
+}
+
+} // anonymous
+
+std::atomic<bool> StartupTiming::s_active{false};
+
+void StartupTiming::restart()
+{
+    s_active.store(false, std::memory_order_relaxed);
+    for(auto &phase : g_phases) {
+        phase.begin.store(std::numeric_limits<qint64>::max(), std::memory_order_relaxed);
+        phase.end.store(0, std::memory_order_relaxed);
+        phase.total.store(0, std::memory_order_relaxed);
+        phase.count.store(0, std::memory_order_relaxed);
+        phase.openedAt.store(-1, std::memory_order_relaxed);
+    }
+    g_firstFrame.store(-1, std::memory_order_relaxed);
+    g_completeFrame.store(-1, std::memory_order_relaxed);
+    g_numOpenPhases.store(0, std::memory_order_relaxed);
+    g_origin.store(clockNow(), std::memory_order_relaxed);
+    s_active.store(true, std::memory_order_release);
+}
+
+qint64 StartupTiming::timestamp()
+{
+    return clockNow() - g_origin.load(std::memory_order_relaxed);
+}
+
+void StartupTiming::record(QStartupPhase phase, qint64 beginTimestamp, qint64 endTimestamp)
+{
+    if(!isActive()) {
+        return;
+    }
+
+    PhaseTiming &timing = g_phases[int(phase)];
+    qint64 begin = timing.begin.load(std::memory_order_relaxed);
+    while(beginTimestamp < begin && !timing.begin.compare_exchange_weak(begin, beginTimestamp, std::memory_order_relaxed)) {}
+    qint64 end = timing.end.load(std::memory_order_relaxed);
+    while(endTimestamp > end && !timing.end.compare_exchange_weak(end, endTimestamp, std::memory_order_relaxed)) {}
+    timing.total.fetch_add(endTimestamp - beginTimestamp, std::memory_order_relaxed);
+    timing.count.fetch_add(1, std::memory_order_relaxed);
+}
+
+void StartupTiming::beginPhase(QStartupPhase phase)
+{
+    if(!isActive()) {
+        return;
+    }
+
+    qint64 notOpen = -1;
+    if(g_phases[int(phase)].openedAt.compare_exchange_strong(notOpen, timestamp(), std::memory_order_relaxed)) {
+        g_numOpenPhases.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void StartupTiming::endPhase(QStartupPhase phase)
+{
+    const qint64 begin = g_phases[int(phase)].openedAt.exchange(-1, std::memory_order_relaxed);
+    if(begin >= 0) {
+        record(phase, begin, timestamp());
+        g_numOpenPhases.fetch_sub(1, std::memory_order_relaxed);
+    }
+}
+
+bool StartupTiming::markFrameRendered(bool sceneComplete)
+{
+    if(!isActive()) {
+        return false;
+    }
+
+    const qint64 now = timestamp();
+    qint64 notRendered = -1;
+    g_firstFrame.compare_exchange_strong(notRendered, now, std::memory_order_relaxed);
+
+    if(sceneComplete && g_numOpenPhases.load(std::memory_order_relaxed) == 0) {
+        g_completeFrame.store(now, std::memory_order_relaxed);
+        bool wasActive = true;
+        return s_active.compare_exchange_strong(wasActive, false, std::memory_order_relaxed);
+    }
+    return false;
+}
+
+QStartupStatistics StartupTiming::statistics()
+{
+    QStartupStatistics stats = {};
+    for(int index=0; index<QStartupPhaseCount; ++index) {
+        const PhaseTiming &timing = g_phases[index];
+        const quint32 count = timing.count.load(std::memory_order_relaxed);
+        if(count > 0) {
+            stats.phases[index].begin = toSeconds(timing.begin.load(std::memory_order_relaxed));
+            stats.phases[index].end = toSeconds(timing.end.load(std::memory_order_relaxed));
+            stats.phases[index].totalTime = toSeconds(timing.total.load(std::memory_order_relaxed));
+            stats.phases[index].count = count;
+        }
+    }
+
+    const qint64 firstFrame = g_firstFrame.load(std::memory_order_relaxed);
+    const qint64 completeFrame = g_completeFrame.load(std::memory_order_relaxed);
+    stats.timeToFirstFrame = firstFrame >= 0 ? toSeconds(firstFrame) : 0.0;
+    stats.timeToCompleteFrame = completeFrame >= 0 ? toSeconds(completeFrame) : 0.0;
+    stats.complete = (completeFrame >= 0);
+    return stats;
+}
+
+const char *StartupTiming::phaseName(QStartupPhase phase)
+{
+    switch(phase) {
+    case QStartupPhase::SceneLoading:
+        return "scene loading";
+    case QStartupPhase::NodeCreation:
+        return "node creation";
+    case QStartupPhase::RendererInitialization:
+        return "renderer init";
+    case QStartupPhase::GeometryImport:
+        return "mesh import";
+    case QStartupPhase::TextureImport:
+        return "texture import";
+    case QStartupPhase::GeometryConversion:
+        return "geometry conversion";
+    case QStartupPhase::AccelerationStructureBuild:
+        return "BLAS build";
+    case QStartupPhase::TextureUpload:
+        return "texture upload";
+    }
+    return "unknown";
+}
+
+QString StartupTiming::summary()
+{
+    const QStartupStatistics stats = statistics();
+
+    QStringList parts;
+    parts.append(QStringLiteral("first frame %1 s, complete %2 s")
+                 .arg(stats.timeToFirstFrame, 0, 'f', 3)
+                 .arg(stats.timeToCompleteFrame, 0, 'f', 3));
+    for(int index=0; index<QStartupPhaseCount; ++index) {
+        const QStartupPhaseTiming &phase = stats.phases[index];
+        if(phase.count > 0) {
+            parts.append(QStringLiteral("%1 %2 s (%3x)")
+                         .arg(QLatin1String(phaseName(QStartupPhase(index))))
+                         .arg(phase.totalTime, 0, 'f', 3)
+                         .arg(phase.count));
+        }
+    }
+    return parts.join(QStringLiteral(" | "));
+}
+
+} // Utility
+} // Qt3DRaytrace
@@ -0,0 +1,72 @@
+/*
+ * Copyright (C) 2018-2019 Michał Siejak
+ * This file is part of Quartz - a raytracing aspect for Qt3D.
+ * See LICENSE file for licensing information.
+ */
+
+#pragma once
+
+#include <Qt3DRaytrace/qrenderstatistics.h>
+
+#include <QtGlobal>
+#include <QString>
+
+#include <atomic>
+
+namespace Qt3DRaytrace {
+namespace Utility {
+
+// Accumulates monotonic per-phase timings from the start of scene loading until the first frame
+// rendered with all scene assets loaded and uploaded. Recording stops once startup is complete.
+// Process-wide: phases are recorded from jobs & backend nodes of every aspect instance into the same timings.
+class StartupTiming
+{
+public:
+    static bool isActive()
+    {
+        return s_active.load(std::memory_order_relaxed);
+    }
+
+    static void restart();
+    static qint64 timestamp();
+    static void record(QStartupPhase phase, qint64 beginTimestamp, qint64 endTimestamp);
+
+    // Phases reported from outside the aspect (e.g. QML scene loading); startup cannot complete while any is open.
+    static void beginPhase(QStartupPhase phase);
+    static void endPhase(QStartupPhase phase);
+
+    // Returns true if this call completed startup.
+    static bool markFrameRendered(bool sceneComplete);
+
+    static QStartupStatistics statistics();
+    static QString summary();
+
+    // Human-readable phase name, used in the summary & statistics server snapshots.
+    static const char *phaseName(QStartupPhase phase);
+
+private:
+    static std::atomic<bool> s_active;
+};
+
+class StartupPhaseScope
+{
+public:
+    explicit StartupPhaseScope(QStartupPhase phase)
+        : m_phase(phase)
+        , m_begin(StartupTiming::isActive() ? StartupTiming::timestamp() : -1)
+    {}
+    ~StartupPhaseScope()
+    {
+        if(m_begin >= 0) {
+            StartupTiming::record(m_phase, m_begin, StartupTiming::timestamp());
+        }
+    }
+
+private:
+    Q_DISABLE_COPY(StartupPhaseScope)
+    QStartupPhase m_phase;
+    qint64 m_begin;
+};
+
+} // Utility
+} // Qt3DRaytrace
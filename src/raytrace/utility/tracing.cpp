@@ -0,0 +1,222 @@
+/*
+ * Copyright (C) 2018-2019 Michał Siejak
+ * This file is part of Quartz - a raytracing aspect for Qt3D.
+ * See LICENSE file for licensing information.
+ */
+
+#include <utility/tracing.h>
+
+#include <QCoreApplication>
+#include <QFile>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QThread>
+#include <QVector>
+
+#include <chrono>
+#include <memory>
+
+namespace Qt3DRaytrace {
+namespace Utility {
+
+namespace Config {
+// Number of events retained per thread; older events are overwritten.
+static constexpr quint32 EventsPerThread = 1 << 16;
+} // Config
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct Event
+{
+    const char *name;
+    quint64 id;
+    qint64 timestamp;
+    char phase;
+};
+
+// Ring buffer slot guarded by a sequence counter, so that dump() can detect (and skip) slots overwritten while being read.
+// Sequence is the ring position + 1 of the event stored in the slot, or 0 while the owning thread is writing it.
+struct EventSlot
+{
+    std::atomic<quint64> sequence{0};
+    std::atomic<const char*> name{nullptr};
+    std::atomic<quint64> id{0};
+    std::atomic<qint64> timestamp{0};
+    std::atomic<char> phase{0};
+};
+
+// Written only by the owning thread; the write position is published with release semantics for dump().
+struct ThreadBuffer
+{
+    explicit ThreadBuffer(int threadIndex, const QString &threadName)
+        : events(new EventSlot[Config::EventsPerThread])
+        , threadIndex(threadIndex)
+        , threadName(threadName)
+    {}
+
+    void append(const char *name, quint64 id, char phase)
+    {
+        const quint64 position = head.load(std::memory_order_relaxed);
+        const qint64 timestamp = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now().time_since_epoch()).count();
+
+        EventSlot &slot = events[position % Config::EventsPerThread];
+        slot.sequence.store(0, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        slot.name.store(name, std::memory_order_relaxed);
+        slot.id.store(id, std::memory_order_relaxed);
+        slot.timestamp.store(timestamp, std::memory_order_relaxed);
+        slot.phase.store(phase, std::memory_order_relaxed);
+        slot.sequence.store(position + 1, std::memory_order_release);
+
+        head.store(position + 1, std::memory_order_release);
+    }
+
+    // Returns false if the event at given position has already been (or is being) overwritten.
+    bool read(quint64 position, Event &event) const
+    {
+        const EventSlot &slot = events[position % Config::EventsPerThread];
+        if(slot.sequence.load(std::memory_order_acquire) != position + 1) {
+            return false;
+        }
+        event.name = slot.name.load(std::memory_order_relaxed);
+        event.id = slot.id.load(std::memory_order_relaxed);
+        event.timestamp = slot.timestamp.load(std::memory_order_relaxed);
+        event.phase = slot.phase.load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        return slot.sequence.load(std::memory_order_relaxed) == position + 1;
+    }
+
+    std::unique_ptr<EventSlot[]> events;
+    std::atomic<quint64> head{0};
+    int threadIndex;
+    QString threadName;
+};
+
+struct Registry
+{
+    QMutex mutex;
+    QVector<ThreadBuffer*> buffers;
+};
+
+// Thread buffers are never freed so that events recorded by threads which already exited can still be dumped.
+Registry &registry()
+{
+    static Registry *instance = new Registry;
+    return *instance;
+}
+
+thread_local ThreadBuffer *t_threadBuffer = nullptr;
+
+ThreadBuffer *threadBuffer()
+{
+    if(Q_UNLIKELY(!t_threadBuffer)) {
+        Registry &r = registry();
+        QMutexLocker lock(&r.mutex);
+
+        QString threadName = QThread::currentThread()->objectName();
+        if(threadName.isEmpty()) {
+            threadName = QString("Thread %1").arg(r.buffers.size());
+        }
+        t_threadBuffer = new ThreadBuffer(r.buffers.size(), threadName);
+        r.buffers.append(t_threadBuffer);
+    }
+    return t_threadBuffer;
+}
+
+QByteArray escapeJsonString(const QString &str)
+{
+    QByteArray result = str.toUtf8();
+    result.replace('\\', "\\\\");
+    result.replace('"', "\\\"");
+    return result;
+}
+
+} // anonymous
+
+std::atomic<bool> Tracing::s_enabled{false};
+
+void Tracing::setEnabled(bool enabled)
+{
+    s_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+void Tracing::beginEvent(const char *name)
+{
+    threadBuffer()->append(name, 0, 'B');
+}
+
+void Tracing::endEvent(const char *name, quint64 id)
+{
+    threadBuffer()->append(name, id, 'E');
+}
+
+bool Tracing::dump(const QString &path)
+{
+    QFile file(path);
+    if(!file.open(QFile::WriteOnly | QFile::Truncate)) {
+        return false;
+    }
+
+    const QByteArray pid = QByteArray::number(QCoreApplication::applicationPid());
+
+    QByteArray json;
+    json.append("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+
+    Registry &r = registry();
+    QMutexLocker lock(&r.mutex);
+
+    bool firstEvent = true;
+    auto beginJsonEvent = [&json, &firstEvent]() {
+        if(!firstEvent) {
+            json.append(",\n");
+        }
+        firstEvent = false;
+    };
+
+    for(const ThreadBuffer *buffer : r.buffers) {
+        const QByteArray tid = QByteArray::number(buffer->threadIndex);
+
+        beginJsonEvent();
+        json.append("{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":").append(pid).append(",\"tid\":").append(tid)
+            .append(",\"args\":{\"name\":\"").append(escapeJsonString(buffer->threadName)).append("\"}}");
+
+        // Events may be appended concurrently; only the range published before this point is dumped. Once the ring has
+        // wrapped, its oldest slots may be overwritten while being read; those are skipped together with end events
+        // whose begin events were lost.
+        const quint64 head = buffer->head.load(std::memory_order_acquire);
+        const quint64 tail = (head > Config::EventsPerThread) ? (head - Config::EventsPerThread) : 0;
+        int depth = 0;
+        for(quint64 position = tail; position < head; ++position) {
+            Event event;
+            if(!buffer->read(position, event)) {
+                continue;
+            }
+            if(event.phase == 'B') {
+                ++depth;
+            }
+            else if(depth > 0) {
+                --depth;
+            }
+            else {
+                continue;
+            }
+
+            beginJsonEvent();
+            json.append("{\"name\":\"").append(event.name).append("\",\"ph\":\"").append(event.phase)
+                .append("\",\"ts\":").append(QByteArray::number(double(event.timestamp) / 1000.0, 'f', 3))
+                .append(",\"pid\":").append(pid).append(",\"tid\":").append(tid);
+            if(event.id != 0) {
+                json.append(",\"args\":{\"id\":").append(QByteArray::number(event.id)).append('}');
+            }
+            json.append('}');
+        }
+    }
+    json.append("\n]}\n");
+
+    return file.write(json) == json.size();
+}
+
+} // Utility
+} // Qt3DRaytrace
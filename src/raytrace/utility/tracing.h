@@ -0,0 +1,69 @@
+/*
+ * Copyright (C) 2018-2019 Michał Siejak
+ * This file is part of Quartz - a raytracing aspect for Qt3D.
+ * See LICENSE file for licensing information.
+ */
+
+#pragma once
+
+#include <QtGlobal>
+#include <QString>
+
+#include <atomic>
+
+namespace Qt3DRaytrace {
+namespace Utility {
+
+// Records begin/end events of scoped regions (e.g. aspect jobs) into per-thread ring buffers,
+// which can be dumped in Chrome trace event JSON format (viewable in chrome://tracing or Perfetto UI).
+class Tracing
+{
+public:
+    static bool isEnabled()
+    {
+        return s_enabled.load(std::memory_order_relaxed);
+    }
+    static void setEnabled(bool enabled);
+
+    // Event names must be string literals (or otherwise outlive the tracing session).
+    static void beginEvent(const char *name);
+    static void endEvent(const char *name, quint64 id);
+
+    static bool dump(const QString &path);
+
+private:
+    static std::atomic<bool> s_enabled;
+};
+
+class TraceScope
+{
+public:
+    explicit TraceScope(const char *name, quint64 id=0)
+        : m_name(Tracing::isEnabled() ? name : nullptr)
+        , m_id(id)
+    {
+        if(m_name) {
+            Tracing::beginEvent(m_name);
+        }
+    }
+    ~TraceScope()
+    {
+        if(m_name) {
+            Tracing::endEvent(m_name, m_id);
+        }
+    }
+
+    // Id is reported with the end event, so it may be set once known inside the traced scope.
+    void setId(quint64 id)
+    {
+        m_id = id;
+    }
+
+private:
+    Q_DISABLE_COPY(TraceScope)
+    const char *m_name;
+    quint64 m_id;
+};
+
+} // Utility
+} // Qt3DRaytrace
@@ -0,0 +1,633 @@
+// Generated by scene2qml v1.0
+// Source file: hierarchy.gltf
+
+import QtQuick 2.0
+import Qt3D.Core 2.0
+import Qt3D.Raytrace 1.0
+
+Entity {
+    id: root
+    Mesh {
+        id: id_mesh0
+        objectName: "mesh0"
+        source: "file:meshes/mesh0.obj"
+    }
+    Mesh {
+        id: id_mesh1
+        objectName: "mesh1"
+        source: "file:meshes/mesh1.obj"
+    }
+    Mesh {
+        id: id_mesh2
+        objectName: "mesh2"
+        source: "file:meshes/mesh2.obj"
+    }
+    Material {
+        id: id_material0
+        objectName: "material0"
+        albedo: Qt3DRaytrace.lrgba(1,0,0)
+    }
+    Material {
+        id: id_material1
+        objectName: "material1"
+        albedo: Qt3DRaytrace.lrgba(1,0.333333,0)
+    }
+    Material {
+        id: id_material2
+        objectName: "material2"
+        albedo: Qt3DRaytrace.lrgba(1,0.666667,0)
+    }
+    Entity {
+        id: id_node0
+        objectName: "node0"
+        components: [id_mesh0, id_material0]
+        Entity {
+            id: id_node1
+            objectName: "node1"
+            Transform {
+                id: id_node1_transform
+                translation: Qt.vector3d(2,0.5,1)
+            }
+            components: [id_node1_transform, id_mesh1, id_material1]
+            Entity {
+                id: id_node2
+                objectName: "node2"
+                components: [id_mesh2, id_material2]
+                Entity {
+                    id: id_node3
+                    objectName: "node3"
+                    Transform {
+                        id: id_node3_transform
+                        translation: Qt.vector3d(4,1.5,0)
+                    }
+                    components: [id_node3_transform, id_mesh0, id_material0]
+                }
+                Entity {
+                    id: id_node4
+                    objectName: "node4"
+                    components: [id_mesh1, id_material1]
+                }
+                Entity {
+                    id: id_node5
+                    objectName: "node5"
+                    Transform {
+                        id: id_node5_transform
+                        translation: Qt.vector3d(6,0,2)
+                    }
+                    components: [id_node5_transform, id_mesh2, id_material2]
+                }
+                Entity {
+                    id: id_node6
+                    objectName: "node6"
+                    components: [id_mesh0, id_material0]
+                }
+            }
+            Entity {
+                id: id_node7
+                objectName: "node7"
+                Transform {
+                    id: id_node7_transform
+                    translation: Qt.vector3d(1,1,1)
+                }
+                components: [id_node7_transform, id_mesh1, id_material1]
+                Entity {
+                    id: id_node8
+                    objectName: "node8"
+                    components: [id_mesh2, id_material2]
+                }
+                Entity {
+                    id: id_node9
+                    objectName: "node9"
+                    Transform {
+                        id: id_node9_transform
+                        translation: Qt.vector3d(3,2,0)
+                    }
+                    components: [id_node9_transform, id_mesh0, id_material0]
+                }
+                Entity {
+                    id: id_node10
+                    objectName: "node10"
+                    components: [id_mesh1, id_material1]
+                }
+                Entity {
+                    id: id_node11
+                    objectName: "node11"
+                    Transform {
+                        id: id_node11_transform
+                        translation: Qt.vector3d(5,0.5,2)
+                    }
+                    components: [id_node11_transform, id_mesh2, id_material2]
+                }
+            }
+            Entity {
+                id: id_node12
+                objectName: "node12"
+                components: [id_mesh0, id_material0]
+                Entity {
+                    id: id_node13
+                    objectName: "node13"
+                    Transform {
+                        id: id_node13_transform
+                        translation: Qt.vector3d(7,1.5,1)
+                    }
+                    components: [id_node13_transform, id_mesh1, id_material1]
+                }
+                Entity {
+                    id: id_node14
+                    objectName: "node14"
+                    components: [id_mesh2, id_material2]
+                }
+                Entity {
+                    id: id_node15
+                    objectName: "node15"
+                    Transform {
+                        id: id_node15_transform
+                        translation: Qt.vector3d(2,0,0)
+                    }
+                    components: [id_node15_transform, id_mesh0, id_material0]
+                }
+                Entity {
+                    id: id_node16
+                    objectName: "node16"
+                    components: [id_mesh1, id_material1]
+                }
+            }
+            Entity {
+                id: id_node17
+                objectName: "node17"
+                Transform {
+                    id: id_node17_transform
+                    translation: Qt.vector3d(4,1,2)
+                }
+                components: [id_node17_transform, id_mesh2, id_material2]
+                Entity {
+                    id: id_node18
+                    objectName: "node18"
+                    components: [id_mesh0, id_material0]
+                }
+                Entity {
+                    id: id_node19
+                    objectName: "node19"
+                    Transform {
+                        id: id_node19_transform
+                        translation: Qt.vector3d(6,2,1)
+                    }
+                    components: [id_node19_transform, id_mesh1, id_material1]
+                }
+                Entity {
+                    id: id_node20
+                    objectName: "node20"
+                    components: [id_mesh2, id_material2]
+                }
+                Entity {
+                    id: id_node21
+                    objectName: "node21"
+                    Transform {
+                        id: id_node21_transform
+                        translation: Qt.vector3d(1,0.5,0)
+                    }
+                    components: [id_node21_transform, id_mesh0, id_material0]
+                }
+            }
+        }
+        Entity {
+            id: id_node22
+            objectName: "node22"
+            components: [id_mesh1, id_material1]
+            Entity {
+                id: id_node23
+                objectName: "node23"
+                Transform {
+                    id: id_node23_transform
+                    translation: Qt.vector3d(3,1.5,2)
+                }
+                components: [id_node23_transform, id_mesh2, id_material2]
+                Entity {
+                    id: id_node24
+                    objectName: "node24"
+                    components: [id_mesh0, id_material0]
+                }
+                Entity {
+                    id: id_node25
+                    objectName: "node25"
+                    Transform {
+                        id: id_node25_transform
+                        translation: Qt.vector3d(5,0,1)
+                    }
+                    components: [id_node25_transform, id_mesh1, id_material1]
+                }
+                Entity {
+                    id: id_node26
+                    objectName: "node26"
+                    components: [id_mesh2, id_material2]
+                }
+                Entity {
+                    id: id_node27
+                    objectName: "node27"
+                    Transform {
+                        id: id_node27_transform
+                        translation: Qt.vector3d(7,1,0)
+                    }
+                    components: [id_node27_transform, id_mesh0, id_material0]
+                }
+            }
+            Entity {
+                id: id_node28
+                objectName: "node28"
+                components: [id_mesh1, id_material1]
+                Entity {
+                    id: id_node29
+                    objectName: "node29"
+                    Transform {
+                        id: id_node29_transform
+                        translation: Qt.vector3d(2,2,2)
+                    }
+                    components: [id_node29_transform, id_mesh2, id_material2]
+                }
+                Entity {
+                    id: id_node30
+                    objectName: "node30"
+                    components: [id_mesh0, id_material0]
+                }
+                Entity {
+                    id: id_node31
+                    objectName: "node31"
+                    Transform {
+                        id: id_node31_transform
+                        translation: Qt.vector3d(4,0.5,1)
+                    }
+                    components: [id_node31_transform, id_mesh1, id_material1]
+                }
+                Entity {
+                    id: id_node32
+                    objectName: "node32"
+                    components: [id_mesh2, id_material2]
+                }
+            }
+            Entity {
+                id: id_node33
+                objectName: "node33"
+                Transform {
+                    id: id_node33_transform
+                    translation: Qt.vector3d(6,1.5,0)
+                }
+                components: [id_node33_transform, id_mesh0, id_material0]
+                Entity {
+                    id: id_node34
+                    objectName: "node34"
+                    components: [id_mesh1, id_material1]
+                }
+                Entity {
+                    id: id_node35
+                    objectName: "node35"
+                    Transform {
+                        id: id_node35_transform
+                        translation: Qt.vector3d(1,0,2)
+                    }
+                    components: [id_node35_transform, id_mesh2, id_material2]
+                }
+                Entity {
+                    id: id_node36
+                    objectName: "node36"
+                    components: [id_mesh0, id_material0]
+                }
+                Entity {
+                    id: id_node37
+                    objectName: "node37"
+                    Transform {
+                        id: id_node37_transform
+                        translation: Qt.vector3d(3,1,1)
+                    }
+                    components: [id_node37_transform, id_mesh1, id_material1]
+                }
+            }
+            Entity {
+                id: id_node38
+                objectName: "node38"
+                components: [id_mesh2, id_material2]
+                Entity {
+                    id: id_node39
+                    objectName: "node39"
+                    Transform {
+                        id: id_node39_transform
+                        translation: Qt.vector3d(5,2,0)
+                    }
+                    components: [id_node39_transform, id_mesh0, id_material0]
+                }
+                Entity {
+                    id: id_node40
+                    objectName: "node40"
+                    components: [id_mesh1, id_material1]
+                }
+                Entity {
+                    id: id_node41
+                    objectName: "node41"
+                    Transform {
+                        id: id_node41_transform
+                        translation: Qt.vector3d(7,0.5,2)
+                    }
+                    components: [id_node41_transform, id_mesh2, id_material2]
+                }
+                Entity {
+                    id: id_node42
+                    objectName: "node42"
+                    components: [id_mesh0, id_material0]
+                }
+            }
+        }
+        Entity {
+            id: id_node43
+            objectName: "node43"
+            Transform {
+                id: id_node43_transform
+                translation: Qt.vector3d(2,1.5,1)
+            }
+            components: [id_node43_transform, id_mesh1, id_material1]
+            Entity {
+                id: id_node44
+                objectName: "node44"
+                components: [id_mesh2, id_material2]
+                Entity {
+                    id: id_node45
+                    objectName: "node45"
+                    Transform {
+                        id: id_node45_transform
+                        translation: Qt.vector3d(4,0,0)
+                    }
+                    components: [id_node45_transform, id_mesh0, id_material0]
+                }
+                Entity {
+                    id: id_node46
+                    objectName: "node46"
+                    components: [id_mesh1, id_material1]
+                }
+                Entity {
+                    id: id_node47
+                    objectName: "node47"
+                    Transform {
+                        id: id_node47_transform
+                        translation: Qt.vector3d(6,1,2)
+                    }
+                    components: [id_node47_transform, id_mesh2, id_material2]
+                }
+                Entity {
+                    id: id_node48
+                    objectName: "node48"
+                    components: [id_mesh0, id_material0]
+                }
+            }
+            Entity {
+                id: id_node49
+                objectName: "node49"
+                Transform {
+                    id: id_node49_transform
+                    translation: Qt.vector3d(1,2,1)
+                }
+                components: [id_node49_transform, id_mesh1, id_material1]
+                Entity {
+                    id: id_node50
+                    objectName: "node50"
+                    components: [id_mesh2, id_material2]
+                }
+                Entity {
+                    id: id_node51
+                    objectName: "node51"
+                    Transform {
+                        id: id_node51_transform
+                        translation: Qt.vector3d(3,0.5,0)
+                    }
+                    components: [id_node51_transform, id_mesh0, id_material0]
+                }
+                Entity {
+                    id: id_node52
+                    objectName: "node52"
+                    components: [id_mesh1, id_material1]
+                }
+                Entity {
+                    id: id_node53
+                    objectName: "node53"
+                    Transform {
+                        id: id_node53_transform
+                        translation: Qt.vector3d(5,1.5,2)
+                    }
+                    components: [id_node53_transform, id_mesh2, id_material2]
+                }
+            }
+            Entity {
+                id: id_node54
+                objectName: "node54"
+                components: [id_mesh0, id_material0]
+                Entity {
+                    id: id_node55
+                    objectName: "node55"
+                    Transform {
+                        id: id_node55_transform
+                        translation: Qt.vector3d(7,0,1)
+                    }
+                    components: [id_node55_transform, id_mesh1, id_material1]
+                }
+                Entity {
+                    id: id_node56
+                    objectName: "node56"
+                    components: [id_mesh2, id_material2]
+                }
+                Entity {
+                    id: id_node57
+                    objectName: "node57"
+                    Transform {
+                        id: id_node57_transform
+                        translation: Qt.vector3d(2,1,0)
+                    }
+                    components: [id_node57_transform, id_mesh0, id_material0]
+                }
+                Entity {
+                    id: id_node58
+                    objectName: "node58"
+                    components: [id_mesh1, id_material1]
+                }
+            }
+            Entity {
+                id: id_node59
+                objectName: "node59"
+                Transform {
+                    id: id_node59_transform
+                    translation: Qt.vector3d(4,2,2)
+                }
+                components: [id_node59_transform, id_mesh2, id_material2]
+                Entity {
+                    id: id_node60
+                    objectName: "node60"
+                    components: [id_mesh0, id_material0]
+                }
+                Entity {
+                    id: id_node61
+                    objectName: "node61"
+                    Transform {
+                        id: id_node61_transform
+                        translation: Qt.vector3d(6,0.5,1)
+                    }
+                    components: [id_node61_transform, id_mesh1, id_material1]
+                }
+                Entity {
+                    id: id_node62
+                    objectName: "node62"
+                    components: [id_mesh2, id_material2]
+                }
+                Entity {
+                    id: id_node63
+                    objectName: "node63"
+                    Transform {
+                        id: id_node63_transform
+                        translation: Qt.vector3d(1,1.5,0)
+                    }
+                    components: [id_node63_transform, id_mesh0, id_material0]
+                }
+            }
+        }
+        Entity {
+            id: id_node64
+            objectName: "node64"
+            components: [id_mesh1, id_material1]
+            Entity {
+                id: id_node65
+                objectName: "node65"
+                Transform {
+                    id: id_node65_transform
+                    translation: Qt.vector3d(3,0,2)
+                }
+                components: [id_node65_transform, id_mesh2, id_material2]
+                Entity {
+                    id: id_node66
+                    objectName: "node66"
+                    components: [id_mesh0, id_material0]
+                }
+                Entity {
+                    id: id_node67
+                    objectName: "node67"
+                    Transform {
+                        id: id_node67_transform
+                        translation: Qt.vector3d(5,1,1)
+                    }
+                    components: [id_node67_transform, id_mesh1, id_material1]
+                }
+                Entity {
+                    id: id_node68
+                    objectName: "node68"
+                    components: [id_mesh2, id_material2]
+                }
+                Entity {
+                    id: id_node69
+                    objectName: "node69"
+                    Transform {
+                        id: id_node69_transform
+                        translation: Qt.vector3d(7,2,0)
+                    }
+                    components: [id_node69_transform, id_mesh0, id_material0]
+                }
+            }
+            Entity {
+                id: id_node70
+                objectName: "node70"
+                components: [id_mesh1, id_material1]
+                Entity {
+                    id: id_node71
+                    objectName: "node71"
+                    Transform {
+                        id: id_node71_transform
+                        translation: Qt.vector3d(2,0.5,2)
+                    }
+                    components: [id_node71_transform, id_mesh2, id_material2]
+                }
+                Entity {
+                    id: id_node72
+                    objectName: "node72"
+                    components: [id_mesh0, id_material0]
+                }
+                Entity {
+                    id: id_node73
+                    objectName: "node73"
+                    Transform {
+                        id: id_node73_transform
+                        translation: Qt.vector3d(4,1.5,1)
+                    }
+                    components: [id_node73_transform, id_mesh1, id_material1]
+                }
+                Entity {
+                    id: id_node74
+                    objectName: "node74"
+                    components: [id_mesh2, id_material2]
+                }
+            }
+            Entity {
+                id: id_node75
+                objectName: "node75"
+                Transform {
+                    id: id_node75_transform
+                    translation: Qt.vector3d(6,0,0)
+                }
+                components: [id_node75_transform, id_mesh0, id_material0]
+                Entity {
+                    id: id_node76
+                    objectName: "node76"
+                    components: [id_mesh1, id_material1]
+                }
+                Entity {
+                    id: id_node77
+                    objectName: "node77"
+                    Transform {
+                        id: id_node77_transform
+                        translation: Qt.vector3d(1,1,2)
+                    }
+                    components: [id_node77_transform, id_mesh2, id_material2]
+                }
+                Entity {
+                    id: id_node78
+                    objectName: "node78"
+                    components: [id_mesh0, id_material0]
+                }
+                Entity {
+                    id: id_node79
+                    objectName: "node79"
+                    Transform {
+                        id: id_node79_transform
+                        translation: Qt.vector3d(3,2,1)
+                    }
+                    components: [id_node79_transform, id_mesh1, id_material1]
+                }
+            }
+            Entity {
+                id: id_node80
+                objectName: "node80"
+                components: [id_mesh2, id_material2]
+                Entity {
+                    id: id_node81
+                    objectName: "node81"
+                    Transform {
+                        id: id_node81_transform
+                        translation: Qt.vector3d(5,0.5,0)
+                    }
+                    components: [id_node81_transform, id_mesh0, id_material0]
+                }
+                Entity {
+                    id: id_node82
+                    objectName: "node82"
+                    components: [id_mesh1, id_material1]
+                }
+                Entity {
+                    id: id_node83
+                    objectName: "node83"
+                    Transform {
+                        id: id_node83_transform
+                        translation: Qt.vector3d(7,1.5,2)
+                    }
+                    components: [id_node83_transform, id_mesh2, id_material2]
+                }
+                Entity {
+                    id: id_node84
+                    objectName: "node84"
+                    components: [id_mesh0, id_material0]
+                }
+            }
+        }
+    }
+}
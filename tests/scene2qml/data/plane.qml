@@ -0,0 +1,29 @@
+// Generated by scene2qml v1.0
+// Source file: plane.obj
+
+import QtQuick 2.0
+import Qt3D.Core 2.0
+import Qt3D.Raytrace 1.0
+
+Entity {
+    id: root
+    Entity {
+        id: id_planeObj
+        objectName: "plane.obj"
+        Entity {
+            id: id_defaultobject
+            objectName: "defaultobject"
+            Mesh {
+                id: id_defaultobject_mesh
+                objectName: "defaultobject"
+                source: "file:meshes/defaultobject.obj"
+            }
+            Material {
+                id: id_defaultobject_material
+                objectName: "DefaultMaterial"
+                albedo: Qt3DRaytrace.lrgba(0.6,0.6,0.6)
+            }
+            components: [id_defaultobject_mesh, id_defaultobject_material]
+        }
+    }
+}
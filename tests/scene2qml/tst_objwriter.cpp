@@ -0,0 +1,264 @@
+/*
+ * Copyright (C) 2018-2019 Michał Siejak
+ * This file is part of Quartz - a raytracing aspect for Qt3D.
+ * See LICENSE file for licensing information.
+ */
+
+#include <objwriter.h>
+
+#include <QtTest>
+#include <QBuffer>
+
+#include <algorithm>
+#include <array>
+#include <cfloat>
+#include <clocale>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <memory>
+
+#include <assimp/Importer.hpp>
+#include <assimp/scene.h>
+
+namespace {
+
+namespace Config {
+static constexpr quint32 RandomSeed = 0x9e3779b9u;
+static constexpr int GridSize = 32;
+// Assimp's OBJ parser is fast but not correctly rounded.
+static constexpr float AssimpTolerance = 4.0f * FLT_EPSILON;
+} // Config
+
+quint32 randomBits(quint32 &state)
+{
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+}
+
+// Random sign & mantissa with magnitudes between 2^-20 and 2^20, so that both fixed and scientific notation get written.
+float randomFloat(quint32 &state)
+{
+    const quint32 exponent = 127u - 20u + randomBits(state) % 41u;
+    const quint32 bits = (randomBits(state) & 0x807fffffu) | (exponent << 23);
+    float value;
+    std::memcpy(&value, &bits, sizeof(float));
+    return value;
+}
+
+bool isBitIdentical(float a, float b)
+{
+    return std::memcmp(&a, &b, sizeof(float)) == 0;
+}
+
+bool isApproximatelyEqual(float a, float b)
+{
+    return std::abs(a - b) <= Config::AssimpTolerance * qMax(std::abs(a), std::abs(b));
+}
+
+// Triangulated grid with random attribute values.
+std::unique_ptr<aiMesh> createMesh(bool hasNormals, bool hasUVs)
+{
+    const unsigned int numVertsPerSide = Config::GridSize + 1;
+
+    std::unique_ptr<aiMesh> mesh(new aiMesh);
+    mesh->mPrimitiveTypes = aiPrimitiveType_TRIANGLE;
+    mesh->mNumVertices = numVertsPerSide * numVertsPerSide;
+    mesh->mVertices = new aiVector3D[mesh->mNumVertices];
+    if(hasNormals) {
+        mesh->mNormals = new aiVector3D[mesh->mNumVertices];
+    }
+    if(hasUVs) {
+        mesh->mTextureCoords[0] = new aiVector3D[mesh->mNumVertices];
+        mesh->mNumUVComponents[0] = 2;
+    }
+
+    quint32 state = Config::RandomSeed;
+    for(unsigned int i=0; i<mesh->mNumVertices; ++i) {
+        mesh->mVertices[i] = aiVector3D(randomFloat(state), randomFloat(state), randomFloat(state));
+        if(hasNormals) {
+            mesh->mNormals[i] = aiVector3D(randomFloat(state), randomFloat(state), randomFloat(state));
+        }
+        if(hasUVs) {
+            mesh->mTextureCoords[0][i] = aiVector3D(randomFloat(state), randomFloat(state), 0.0f);
+        }
+    }
+
+    mesh->mNumFaces = 2 * Config::GridSize * Config::GridSize;
+    mesh->mFaces = new aiFace[mesh->mNumFaces];
+    for(unsigned int y=0, faceIndex=0; y<unsigned(Config::GridSize); ++y) {
+        for(unsigned int x=0; x<unsigned(Config::GridSize); ++x) {
+            const unsigned int i0 = y * numVertsPerSide + x;
+            const unsigned int i1 = i0 + 1;
+            const unsigned int i2 = i0 + numVertsPerSide;
+            const unsigned int i3 = i2 + 1;
+            for(const auto &triangle : { std::array<unsigned int, 3>{i0, i2, i1}, std::array<unsigned int, 3>{i1, i2, i3} }) {
+                aiFace &face = mesh->mFaces[faceIndex++];
+                face.mNumIndices = 3;
+                face.mIndices = new unsigned int[3];
+                std::copy(triangle.begin(), triangle.end(), face.mIndices);
+            }
+        }
+    }
+    return mesh;
+}
+
+QByteArray writeObj(const aiMesh *mesh)
+{
+    QByteArray data;
+    QBuffer buffer(&data);
+    buffer.open(QIODevice::WriteOnly);
+    ObjWriter writer(&buffer);
+    return writer.writeMesh(mesh) ? data : QByteArray();
+}
+
+} // anonymous
+
+class TestObjWriter : public QObject
+{
+    Q_OBJECT
+private slots:
+    void initTestCase();
+    void assimpRoundTrip_data();
+    void assimpRoundTrip();
+    void bitExactValues();
+};
+
+void TestObjWriter::initTestCase()
+{
+    // QCoreApplication adopts the system locale, which std::strtof honors.
+    std::setlocale(LC_NUMERIC, "C");
+}
+
+void TestObjWriter::assimpRoundTrip_data()
+{
+    QTest::addColumn<bool>("hasNormals");
+    QTest::addColumn<bool>("hasUVs");
+
+    QTest::newRow("positions") << false << false;
+    QTest::newRow("positions+normals") << true << false;
+    QTest::newRow("positions+uvs") << false << true;
+    QTest::newRow("positions+normals+uvs") << true << true;
+}
+
+void TestObjWriter::assimpRoundTrip()
+{
+    QFETCH(bool, hasNormals);
+    QFETCH(bool, hasUVs);
+
+    const std::unique_ptr<aiMesh> source = createMesh(hasNormals, hasUVs);
+    const QByteArray data = writeObj(source.get());
+    QVERIFY(!data.isEmpty());
+
+    Assimp::Importer importer;
+    const aiScene *scene = importer.ReadFileFromMemory(data.constData(), size_t(data.size()), 0, "obj");
+    QVERIFY2(scene, importer.GetErrorString());
+    QCOMPARE(scene->mNumMeshes, 1u);
+
+    // Assimp may duplicate or reorder vertices, hence attributes are compared through face indices.
+    const aiMesh *imported = scene->mMeshes[0];
+    QCOMPARE(imported->mNumFaces, source->mNumFaces);
+    QCOMPARE(imported->HasNormals(), hasNormals);
+    QCOMPARE(imported->HasTextureCoords(0), hasUVs);
+
+    for(unsigned int i=0; i<source->mNumFaces; ++i) {
+        const aiFace &sourceFace = source->mFaces[i];
+        const aiFace &importedFace = imported->mFaces[i];
+        QCOMPARE(importedFace.mNumIndices, sourceFace.mNumIndices);
+
+        for(unsigned int j=0; j<sourceFace.mNumIndices; ++j) {
+            const unsigned int sourceIndex = sourceFace.mIndices[j];
+            const unsigned int importedIndex = importedFace.mIndices[j];
+            QVERIFY(importedIndex < imported->mNumVertices);
+
+            for(int c=0; c<3; ++c) {
+                QVERIFY(isApproximatelyEqual(imported->mVertices[importedIndex][c], source->mVertices[sourceIndex][c]));
+                if(hasNormals) {
+                    QVERIFY(isApproximatelyEqual(imported->mNormals[importedIndex][c], source->mNormals[sourceIndex][c]));
+                }
+            }
+            for(int c=0; hasUVs && c<2; ++c) {
+                QVERIFY(isApproximatelyEqual(imported->mTextureCoords[0][importedIndex][c], source->mTextureCoords[0][sourceIndex][c]));
+            }
+        }
+    }
+}
+
+void TestObjWriter::bitExactValues()
+{
+    // Random values plus ones most likely to trip up float formatting.
+    std::unique_ptr<aiMesh> mesh = createMesh(true, true);
+    const float specialValues[] = {
+        0.0f, -0.0f, 0.1f, 1.0f / 3.0f, 16777216.0f, 16777218.0f,
+        FLT_MIN, -FLT_MIN, FLT_MAX, -FLT_MAX, FLT_EPSILON,
+        std::numeric_limits<float>::denorm_min(), -std::numeric_limits<float>::denorm_min(),
+    };
+    const unsigned int numSpecialValues = sizeof(specialValues) / sizeof(float);
+    for(unsigned int i=0; i<numSpecialValues; ++i) {
+        mesh->mVertices[i] = aiVector3D(specialValues[i]);
+        mesh->mNormals[i] = aiVector3D(specialValues[i]);
+        mesh->mTextureCoords[0][i] = aiVector3D(specialValues[i], specialValues[i], 0.0f);
+    }
+
+    const QByteArray data = writeObj(mesh.get());
+    QVERIFY(!data.isEmpty());
+
+    unsigned int numPositions = 0;
+    unsigned int numNormals = 0;
+    unsigned int numUVs = 0;
+    unsigned int numFaces = 0;
+    for(const QByteArray &line : data.split('\n')) {
+        const QList<QByteArray> tokens = line.split(' ');
+        const QByteArray &tag = tokens.first();
+        if(tag == "f") {
+            QVERIFY(numFaces < mesh->mNumFaces);
+            QCOMPARE(unsigned(tokens.size() - 1), mesh->mFaces[numFaces].mNumIndices);
+            for(unsigned int j=0; j<mesh->mFaces[numFaces].mNumIndices; ++j) {
+                const QByteArray index = QByteArray::number(mesh->mFaces[numFaces].mIndices[j] + 1);
+                QCOMPARE(tokens[int(j) + 1], index + '/' + index + '/' + index);
+            }
+            ++numFaces;
+            continue;
+        }
+
+        const aiVector3D *vectors = nullptr;
+        unsigned int vectorIndex = 0;
+        int numComponents = 3;
+        if(tag == "v") {
+            vectors = mesh->mVertices;
+            vectorIndex = numPositions++;
+        }
+        else if(tag == "vn") {
+            vectors = mesh->mNormals;
+            vectorIndex = numNormals++;
+        }
+        else if(tag == "vt") {
+            vectors = mesh->mTextureCoords[0];
+            vectorIndex = numUVs++;
+            numComponents = 2;
+        }
+        else {
+            QVERIFY(line.isEmpty());
+            continue;
+        }
+
+        QCOMPARE(tokens.size(), numComponents + 1);
+        QVERIFY(vectorIndex < mesh->mNumVertices);
+        for(int c=0; c<numComponents; ++c) {
+            const float value = std::strtof(tokens[c + 1].constData(), nullptr);
+            QVERIFY2(isBitIdentical(value, vectors[vectorIndex][c]), tokens[c + 1].constData());
+        }
+    }
+
+    QCOMPARE(numPositions, mesh->mNumVertices);
+    QCOMPARE(numNormals, mesh->mNumVertices);
+    QCOMPARE(numUVs, mesh->mNumVertices);
+    QCOMPARE(numFaces, mesh->mNumFaces);
+}
+
+QTEST_GUILESS_MAIN(TestObjWriter)
+
+#include "tst_objwriter.moc"
@@ -0,0 +1,181 @@
+/*
+ * Copyright (C) 2018-2019 Michał Siejak
+ * This file is part of Quartz - a raytracing aspect for Qt3D.
+ * See LICENSE file for licensing information.
+ */
+
+#include <importer.h>
+#include <exporter.h>
+
+#include <QtTest>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTemporaryDir>
+
+namespace {
+
+namespace Config {
+// Generated scene: a tree of entities sharing a handful of meshes & materials; must match data/hierarchy.qml.
+static constexpr int HierarchyDepth = 3;
+static constexpr int HierarchyFanout = 4;
+static constexpr int NumMeshes = 3;
+} // Config
+
+int appendNode(QJsonArray &nodes, int depth, int &counter)
+{
+    const int index = nodes.size();
+    const int id = counter++;
+
+    QJsonObject node;
+    node["name"] = QString("node%1").arg(id);
+    node["mesh"] = id % Config::NumMeshes;
+    // Every other entity has no transform.
+    if(id % 2 == 1) {
+        node["translation"] = QJsonArray{ double(1 + id % 7), double(id % 5) * 0.5, double(id % 3) };
+    }
+    nodes.append(node);
+
+    if(depth < Config::HierarchyDepth) {
+        QJsonArray children;
+        for(int i=0; i<Config::HierarchyFanout; ++i) {
+            children.append(appendNode(nodes, depth+1, counter));
+        }
+        QJsonObject updatedNode = nodes[index].toObject();
+        updatedNode["children"] = children;
+        nodes[index] = updatedNode;
+    }
+    return index;
+}
+
+// glTF scene with a single triangle buffer, so that it can be written without any external tools.
+bool writeHierarchyScene(const QString &path)
+{
+    const float positions[] = { 0.0f, 0.0f, 0.0f,  1.0f, 0.0f, 0.0f,  0.0f, 1.0f, 0.0f };
+    const quint16 indices[] = { 0, 1, 2 };
+    QByteArray buffer;
+    buffer.append(reinterpret_cast<const char*>(positions), sizeof(positions));
+    buffer.append(reinterpret_cast<const char*>(indices), sizeof(indices));
+
+    QJsonArray meshes;
+    QJsonArray materials;
+    for(int i=0; i<Config::NumMeshes; ++i) {
+        const QJsonObject primitive{ {"attributes", QJsonObject{ {"POSITION", 0} }}, {"indices", 1}, {"material", i} };
+        meshes.append(QJsonObject{ {"name", QString("mesh%1").arg(i)}, {"primitives", QJsonArray{ primitive }} });
+        const QJsonObject pbr{ {"baseColorFactor", QJsonArray{ 1.0, double(i) / Config::NumMeshes, 0.0, 1.0 }} };
+        materials.append(QJsonObject{ {"name", QString("material%1").arg(i)}, {"pbrMetallicRoughness", pbr} });
+    }
+
+    QJsonArray nodes;
+    int counter = 0;
+    appendNode(nodes, 0, counter);
+
+    QJsonObject gltf;
+    gltf["asset"] = QJsonObject{ {"version", "2.0"} };
+    gltf["scene"] = 0;
+    gltf["scenes"] = QJsonArray{ QJsonObject{ {"nodes", QJsonArray{ 0 }} } };
+    gltf["nodes"] = nodes;
+    gltf["meshes"] = meshes;
+    gltf["materials"] = materials;
+    gltf["buffers"] = QJsonArray{ QJsonObject{
+        {"byteLength", buffer.size()},
+        {"uri", QString("data:application/octet-stream;base64,%1").arg(QString::fromLatin1(buffer.toBase64()))},
+    } };
+    gltf["bufferViews"] = QJsonArray{
+        QJsonObject{ {"buffer", 0}, {"byteOffset", 0}, {"byteLength", int(sizeof(positions))} },
+        QJsonObject{ {"buffer", 0}, {"byteOffset", int(sizeof(positions))}, {"byteLength", int(sizeof(indices))} },
+    };
+    gltf["accessors"] = QJsonArray{
+        QJsonObject{ {"bufferView", 0}, {"componentType", 5126}, {"count", 3}, {"type", "VEC3"},
+                     {"min", QJsonArray{ 0.0, 0.0, 0.0 }}, {"max", QJsonArray{ 1.0, 1.0, 0.0 }} },
+        QJsonObject{ {"bufferView", 1}, {"componentType", 5123}, {"count", 3}, {"type", "SCALAR"} },
+    };
+
+    QFile file(path);
+    return file.open(QFile::WriteOnly | QFile::Truncate) && file.write(QJsonDocument(gltf).toJson()) > 0;
+}
+
+QByteArray exportQml(const Scene &scene, const QString &sceneName, const QString &path, int maxEntitiesPerTask)
+{
+    // Ids are assigned during export, so each export needs a fresh exporter.
+    Exporter exporter(scene);
+    exporter.setMeshDirectory("meshes");
+    exporter.setTexturesDirectory("textures");
+    exporter.setQmlTaskSize(maxEntitiesPerTask);
+    if(!exporter.exportQml(path, sceneName)) {
+        return QByteArray();
+    }
+
+    QFile file(path);
+    return file.open(QFile::ReadOnly) ? file.readAll() : QByteArray();
+}
+
+} // anonymous
+
+class TestQmlExport : public QObject
+{
+    Q_OBJECT
+private slots:
+    void initTestCase();
+    void matchesReference_data();
+    void matchesReference();
+
+private:
+    QTemporaryDir m_tempDir;
+};
+
+void TestQmlExport::initTestCase()
+{
+    // Written to the header of generated QML.
+    QCoreApplication::setApplicationName("scene2qml");
+    QCoreApplication::setApplicationVersion("1.0");
+
+    QVERIFY(m_tempDir.isValid());
+    QVERIFY(writeHierarchyScene(m_tempDir.filePath("hierarchy.gltf")));
+}
+
+void TestQmlExport::matchesReference_data()
+{
+    QTest::addColumn<QString>("scenePath");
+    QTest::addColumn<int>("maxEntitiesPerTask");
+
+    const QDir assetsDir(QStringLiteral(QUARTZ_EXAMPLE_ASSETS_DIR));
+    const QString scenePaths[] = {
+        assetsDir.filePath("monkey.obj"),
+        assetsDir.filePath("plane.obj"),
+        m_tempDir.filePath("hierarchy.gltf"),
+    };
+    // One entity per task splits every subtree; 0 is what scene2qml uses.
+    for(const QString &scenePath : scenePaths) {
+        for(int maxEntitiesPerTask : { 0, 1, 7, 64 }) {
+            const QString name = QString("%1/%2").arg(QFileInfo(scenePath).fileName()).arg(maxEntitiesPerTask);
+            QTest::newRow(qPrintable(name)) << scenePath << maxEntitiesPerTask;
+        }
+    }
+}
+
+// Reference files were written by the serial exporter that preceded parallel QML generation.
+void TestQmlExport::matchesReference()
+{
+    QFETCH(QString, scenePath);
+    QFETCH(int, maxEntitiesPerTask);
+
+    Importer importer;
+    QVERIFY(importer.importScene(scenePath));
+
+    const QString sceneName = QFileInfo(scenePath).fileName();
+    const QString baseName = QFileInfo(scenePath).completeBaseName();
+    QFile referenceFile(QDir(QStringLiteral(QUARTZ_TEST_DATA_DIR)).filePath(baseName + ".qml"));
+    QVERIFY(referenceFile.open(QFile::ReadOnly));
+    const QByteArray reference = referenceFile.readAll();
+
+    const QByteArray output = exportQml(importer.scene(), sceneName, m_tempDir.filePath(baseName + ".qml"), maxEntitiesPerTask);
+    QCOMPARE(output, reference);
+}
+
+QTEST_GUILESS_MAIN(TestQmlExport)
+
+#include "tst_qmlexport.moc"